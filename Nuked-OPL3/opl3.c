@@ -545,12 +545,61 @@ static void OPL3_EnvelopeKeyOff(opl3_slot *slot, uint8_t type)
     Phase Generator
 */
 
+static uint16_t OPL3_PhaseRhythm(opl3_chip *chip, uint8_t slot_num, uint16_t phase, uint32_t noise)
+{
+    uint16_t phase_out = phase;
+    uint8_t rm_xor;
+
+    if (slot_num == 13) /* hh */
+    {
+        chip->rm_hh_bit2 = (phase >> 2) & 1;
+        chip->rm_hh_bit3 = (phase >> 3) & 1;
+        chip->rm_hh_bit7 = (phase >> 7) & 1;
+        chip->rm_hh_bit8 = (phase >> 8) & 1;
+    }
+    if (slot_num == 17 && (chip->rhy & 0x20)) /* tc */
+    {
+        chip->rm_tc_bit3 = (phase >> 3) & 1;
+        chip->rm_tc_bit5 = (phase >> 5) & 1;
+    }
+    if (chip->rhy & 0x20)
+    {
+        rm_xor = (chip->rm_hh_bit2 ^ chip->rm_hh_bit7)
+               | (chip->rm_hh_bit3 ^ chip->rm_tc_bit5)
+               | (chip->rm_tc_bit3 ^ chip->rm_tc_bit5);
+        switch (slot_num)
+        {
+        case 13: /* hh */
+            phase_out = rm_xor << 9;
+            if (rm_xor ^ (noise & 1))
+            {
+                phase_out |= 0xd0;
+            }
+            else
+            {
+                phase_out |= 0x34;
+            }
+            break;
+        case 16: /* sd */
+            phase_out = (chip->rm_hh_bit8 << 9)
+                      | ((chip->rm_hh_bit8 ^ (noise & 1)) << 8);
+            break;
+        case 17: /* tc */
+            phase_out = (rm_xor << 9) | 0x80;
+            break;
+        default:
+            break;
+        }
+    }
+    return phase_out;
+}
+
 static void OPL3_PhaseGenerate(opl3_slot *slot)
 {
     opl3_chip *chip;
     uint16_t f_num;
     uint32_t basefreq;
-    uint8_t rm_xor, n_bit;
+    uint8_t n_bit;
     uint32_t noise;
     uint16_t phase;
 
@@ -589,48 +638,7 @@ static void OPL3_PhaseGenerate(opl3_slot *slot)
     slot->pg_phase += (basefreq * mt[slot->reg_mult]) >> 1;
     /* Rhythm mode */
     noise = chip->noise;
-    slot->pg_phase_out = phase;
-    if (slot->slot_num == 13) /* hh */
-    {
-        chip->rm_hh_bit2 = (phase >> 2) & 1;
-        chip->rm_hh_bit3 = (phase >> 3) & 1;
-        chip->rm_hh_bit7 = (phase >> 7) & 1;
-        chip->rm_hh_bit8 = (phase >> 8) & 1;
-    }
-    if (slot->slot_num == 17 && (chip->rhy & 0x20)) /* tc */
-    {
-        chip->rm_tc_bit3 = (phase >> 3) & 1;
-        chip->rm_tc_bit5 = (phase >> 5) & 1;
-    }
-    if (chip->rhy & 0x20)
-    {
-        rm_xor = (chip->rm_hh_bit2 ^ chip->rm_hh_bit7)
-               | (chip->rm_hh_bit3 ^ chip->rm_tc_bit5)
-               | (chip->rm_tc_bit3 ^ chip->rm_tc_bit5);
-        switch (slot->slot_num)
-        {
-        case 13: /* hh */
-            slot->pg_phase_out = rm_xor << 9;
-            if (rm_xor ^ (noise & 1))
-            {
-                slot->pg_phase_out |= 0xd0;
-            }
-            else
-            {
-                slot->pg_phase_out |= 0x34;
-            }
-            break;
-        case 16: /* sd */
-            slot->pg_phase_out = (chip->rm_hh_bit8 << 9)
-                               | ((chip->rm_hh_bit8 ^ (noise & 1)) << 8);
-            break;
-        case 17: /* tc */
-            slot->pg_phase_out = (rm_xor << 9) | 0x80;
-            break;
-        default:
-            break;
-        }
-    }
+    slot->pg_phase_out = OPL3_PhaseRhythm(chip, slot->slot_num, phase, noise);
     n_bit = ((noise >> 14) ^ noise) & 0x01;
     chip->noise = (noise >> 1) | (n_bit << 22);
 }
@@ -1108,15 +1116,87 @@ static void OPL3_ProcessSlot(opl3_slot *slot)
     OPL3_SlotGenerate(slot);
 }
 
+static void OPL3_UpdateTimers(opl3_chip *chip)
+{
+    uint8_t shift = 0;
+
+    if ((chip->timer & 0x3f) == 0x3f)
+    {
+        chip->tremolopos = (chip->tremolopos + 1) % 210;
+    }
+    if (chip->tremolopos < 105)
+    {
+        chip->tremolo = chip->tremolopos >> chip->tremoloshift;
+    }
+    else
+    {
+        chip->tremolo = (210 - chip->tremolopos) >> chip->tremoloshift;
+    }
+
+    if ((chip->timer & 0x3ff) == 0x3ff)
+    {
+        chip->vibpos = (chip->vibpos + 1) & 7;
+    }
+
+    chip->timer++;
+
+    if (chip->eg_state)
+    {
+        while (shift < 13 && ((chip->eg_timer >> shift) & 1) == 0)
+        {
+            shift++;
+        }
+        if (shift > 12)
+        {
+            chip->eg_add = 0;
+        }
+        else
+        {
+            chip->eg_add = shift + 1;
+        }
+        chip->eg_timer_lo = (uint8_t)(chip->eg_timer & 0x3u);
+    }
+
+    if (chip->eg_timerrem || chip->eg_state)
+    {
+        if (chip->eg_timer == UINT64_C(0xfffffffff))
+        {
+            chip->eg_timer = 0;
+            chip->eg_timerrem = 1;
+        }
+        else
+        {
+            chip->eg_timer++;
+            chip->eg_timerrem = 0;
+        }
+    }
+
+    chip->eg_state ^= 1;
+}
+
+static void OPL3_ProcessWriteBuf(opl3_chip *chip)
+{
+    opl3_writebuf *writebuf;
+
+    while ((writebuf = &chip->writebuf[chip->writebuf_cur]), writebuf->time <= chip->writebuf_samplecnt)
+    {
+        if (!(writebuf->reg & 0x200))
+        {
+            break;
+        }
+        writebuf->reg &= 0x1ff;
+        OPL3_WriteReg(chip, writebuf->reg, writebuf->data);
+        chip->writebuf_cur = (chip->writebuf_cur + 1) % OPL_WRITEBUF_SIZE;
+    }
+}
+
 inline void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
 {
     opl3_channel *channel;
-    opl3_writebuf *writebuf;
     int16_t **out;
     int32_t mix[2];
     uint8_t ii;
     int16_t accm;
-    uint8_t shift = 0;
 
     buf4[1] = OPL3_ClipSample(chip->mixbuff[1]);
     buf4[3] = OPL3_ClipSample(chip->mixbuff[3]);
@@ -1186,108 +1266,541 @@ inline void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
     }
 #endif
 
-    if ((chip->timer & 0x3f) == 0x3f)
+    OPL3_UpdateTimers(chip);
+    OPL3_ProcessWriteBuf(chip);
+    chip->writebuf_samplecnt++;
+}
+
+void OPL3_Generate(opl3_chip *chip, int16_t *buf)
+{
+    int16_t samples[4];
+    OPL3_Generate4Ch(chip, samples);
+    buf[0] = samples[0];
+    buf[1] = samples[1];
+}
+
+void OPL3_Generate4ChResampled(opl3_chip *chip, int16_t *buf4)
+{
+    while (chip->samplecnt >= chip->rateratio)
     {
-        chip->tremolopos = (chip->tremolopos + 1) % 210;
+        chip->oldsamples[0] = chip->samples[0];
+        chip->oldsamples[1] = chip->samples[1];
+        chip->oldsamples[2] = chip->samples[2];
+        chip->oldsamples[3] = chip->samples[3];
+        OPL3_Generate4Ch(chip, chip->samples);
+        chip->samplecnt -= chip->rateratio;
     }
-    if (chip->tremolopos < 105)
+    buf4[0] = (int16_t)((chip->oldsamples[0] * (chip->rateratio - chip->samplecnt)
+                        + chip->samples[0] * chip->samplecnt) / chip->rateratio);
+    buf4[1] = (int16_t)((chip->oldsamples[1] * (chip->rateratio - chip->samplecnt)
+                        + chip->samples[1] * chip->samplecnt) / chip->rateratio);
+    buf4[2] = (int16_t)((chip->oldsamples[2] * (chip->rateratio - chip->samplecnt)
+                        + chip->samples[2] * chip->samplecnt) / chip->rateratio);
+    buf4[3] = (int16_t)((chip->oldsamples[3] * (chip->rateratio - chip->samplecnt)
+                        + chip->samples[3] * chip->samplecnt) / chip->rateratio);
+    chip->samplecnt += 1 << RSM_FRAC;
+}
+
+void OPL3_GenerateResampled(opl3_chip *chip, int16_t *buf)
+{
+    int16_t samples[4];
+    OPL3_Generate4ChResampled(chip, samples);
+    buf[0] = samples[0];
+    buf[1] = samples[1];
+}
+
+/*
+    Block rendering
+
+    OPL3_GenerateBlock advances the chip slot-major: each slot runs over a
+    whole block of samples before the next slot is touched, with the
+    chip-wide clocks (tremolo, vibrato, envelope timer) precomputed for the
+    block and the per-slot register decoding hoisted out of the sample loop.
+    Slot outputs are kept per sample, so modulation and the two channel mixes
+    read exactly the values the per-sample path would see, including the
+    OPL_QUIRK_CHANNELSAMPLEDELAY ordering. Slots 13-17 share the rhythm
+    phase bits and the noise generator, so they are run sample-major as a
+    group.
+*/
+
+#define OPL_BLOCK_MOD_ZERO  -2
+#define OPL_BLOCK_MOD_FB    -1
+
+typedef struct {
+    uint8_t tremolo;
+    uint8_t vibpos;
+    uint8_t eg_state;
+    uint8_t eg_add;
+    uint8_t eg_timer_lo;
+} opl3_blockclk;
+
+typedef struct {
+    opl3_slot *slot;
+    envelope_sinfunc wf;
+    uint32_t pg_inc[8];
+    uint8_t rate_hi[4];
+    uint8_t rate_lo[4];
+    uint8_t rate_nz[4];
+    uint16_t eg_base;
+    uint8_t am;
+    uint8_t vib;
+    uint8_t fb;
+    uint8_t key;
+    uint8_t reg_sl;
+    int8_t mod;
+    /* running state */
+    uint16_t eg_rout;
+    uint16_t eg_out;
+    uint8_t eg_gen;
+    uint8_t pg_reset;
+    uint32_t pg_phase;
+    uint16_t pg_phase_out;
+    int16_t out;
+    int16_t prout;
+    int16_t fbmod;
+} opl3_blockslot;
+
+static int8_t OPL3_BlockSlotIndex(opl3_chip *chip, const int16_t *ptr)
+{
+    if (ptr == &chip->zeromod)
     {
-        chip->tremolo = chip->tremolopos >> chip->tremoloshift;
+        return OPL_BLOCK_MOD_ZERO;
+    }
+    return (int8_t)(((const char *)ptr - (const char *)chip->slot) / sizeof(opl3_slot));
+}
+
+static void OPL3_BlockSlotSetup(opl3_blockslot *bs, opl3_slot *slot)
+{
+    opl3_chip *chip = slot->chip;
+    opl3_channel *channel = slot->channel;
+    uint8_t reg_rate[4];
+    uint8_t ks, rate, i;
+    uint16_t f_num;
+    int8_t range;
+
+    bs->slot = slot;
+    bs->wf = envelope_sin[slot->reg_wf];
+    bs->eg_base = (slot->reg_tl << 2) + (slot->eg_ksl >> kslshift[slot->reg_ksl]);
+    bs->am = (slot->trem == &chip->tremolo);
+    bs->vib = slot->reg_vib;
+    bs->fb = channel->fb;
+    bs->key = slot->key;
+    bs->reg_sl = slot->reg_sl;
+    if (slot->mod == &slot->fbmod)
+    {
+        bs->mod = OPL_BLOCK_MOD_FB;
     }
     else
     {
-        chip->tremolo = (210 - chip->tremolopos) >> chip->tremoloshift;
+        bs->mod = OPL3_BlockSlotIndex(chip, slot->mod);
     }
 
-    if ((chip->timer & 0x3ff) == 0x3ff)
+    /* Rate selected by eg_gen; key and the rate registers cannot change within a block */
+    reg_rate[envelope_gen_num_attack] = slot->reg_ar;
+    reg_rate[envelope_gen_num_decay] = slot->reg_dr;
+    reg_rate[envelope_gen_num_sustain] = slot->reg_type ? 0 : slot->reg_rr;
+    reg_rate[envelope_gen_num_release] = slot->key ? slot->reg_ar : slot->reg_rr;
+    ks = channel->ksv >> ((slot->reg_ksr ^ 1) << 1);
+    for (i = 0; i < 4; i++)
     {
-        chip->vibpos = (chip->vibpos + 1) & 7;
+        rate = ks + (reg_rate[i] << 2);
+        bs->rate_nz[i] = (reg_rate[i] != 0);
+        bs->rate_hi[i] = rate >> 2;
+        bs->rate_lo[i] = rate & 0x03;
+        if (bs->rate_hi[i] & 0x10)
+        {
+            bs->rate_hi[i] = 0x0f;
+        }
     }
 
-    chip->timer++;
-
-    if (chip->eg_state)
+    /* Phase increment for each vibrato position */
+    for (i = 0; i < 8; i++)
     {
-        while (shift < 13 && ((chip->eg_timer >> shift) & 1) == 0)
+        f_num = channel->f_num;
+        if (slot->reg_vib)
         {
-            shift++;
+            range = (f_num >> 7) & 7;
+            if (!(i & 3))
+            {
+                range = 0;
+            }
+            else if (i & 1)
+            {
+                range >>= 1;
+            }
+            range >>= chip->vibshift;
+            if (i & 4)
+            {
+                range = -range;
+            }
+            f_num += range;
         }
-        if (shift > 12)
+        bs->pg_inc[i] = ((((uint32_t)f_num << channel->block) >> 1) * mt[slot->reg_mult]) >> 1;
+    }
+
+    bs->eg_rout = slot->eg_rout;
+    bs->eg_out = slot->eg_out;
+    bs->eg_gen = slot->eg_gen;
+    bs->pg_reset = (uint8_t)slot->pg_reset;
+    bs->pg_phase = slot->pg_phase;
+    bs->pg_phase_out = slot->pg_phase_out;
+    bs->out = slot->out;
+    bs->prout = slot->prout;
+    bs->fbmod = slot->fbmod;
+}
+
+static void OPL3_BlockSlotStore(const opl3_blockslot *bs)
+{
+    opl3_slot *slot = bs->slot;
+
+    slot->eg_rout = bs->eg_rout;
+    slot->eg_out = bs->eg_out;
+    slot->eg_gen = bs->eg_gen;
+    slot->pg_reset = bs->pg_reset;
+    slot->pg_phase = bs->pg_phase;
+    slot->pg_phase_out = bs->pg_phase_out;
+    slot->out = bs->out;
+    slot->prout = bs->prout;
+    slot->fbmod = bs->fbmod;
+}
+
+/* Feedback, envelope and phase for one sample; mirrors OPL3_SlotCalcFB/EnvelopeCalc/PhaseGenerate */
+static inline void OPL3_BlockSlotClock(opl3_blockslot *bs, const opl3_blockclk *clk)
+{
+    uint8_t gen = bs->eg_gen;
+    uint8_t rate_hi = bs->rate_hi[gen];
+    uint8_t rate_lo = bs->rate_lo[gen];
+    uint8_t eg_shift, shift;
+    uint16_t eg_rout;
+    int16_t eg_inc;
+    uint8_t eg_off;
+    uint8_t reset;
+
+    if (bs->fb != 0x00)
+    {
+        bs->fbmod = (bs->prout + bs->out) >> (0x09 - bs->fb);
+    }
+    else
+    {
+        bs->fbmod = 0;
+    }
+    bs->prout = bs->out;
+
+    bs->eg_out = bs->eg_rout + bs->eg_base + (bs->am ? clk->tremolo : 0);
+    reset = (bs->key && gen == envelope_gen_num_release);
+    bs->pg_reset = reset;
+    eg_shift = rate_hi + clk->eg_add;
+    shift = 0;
+    if (bs->rate_nz[gen])
+    {
+        if (rate_hi < 12)
         {
-            chip->eg_add = 0;
+            if (clk->eg_state)
+            {
+                switch (eg_shift)
+                {
+                case 12:
+                    shift = 1;
+                    break;
+                case 13:
+                    shift = (rate_lo >> 1) & 0x01;
+                    break;
+                case 14:
+                    shift = rate_lo & 0x01;
+                    break;
+                default:
+                    break;
+                }
+            }
         }
         else
         {
-            chip->eg_add = shift + 1;
+            shift = (rate_hi & 0x03) + eg_incstep[rate_lo][clk->eg_timer_lo];
+            if (shift & 0x04)
+            {
+                shift = 0x03;
+            }
+            if (!shift)
+            {
+                shift = clk->eg_state;
+            }
         }
-        chip->eg_timer_lo = (uint8_t)(chip->eg_timer & 0x3u);
     }
-
-    if (chip->eg_timerrem || chip->eg_state)
+    eg_rout = bs->eg_rout;
+    eg_inc = 0;
+    eg_off = 0;
+    if (reset && rate_hi == 0x0f)
     {
-        if (chip->eg_timer == UINT64_C(0xfffffffff))
+        eg_rout = 0x00;
+    }
+    if ((bs->eg_rout & 0x1f8) == 0x1f8)
+    {
+        eg_off = 1;
+    }
+    if (gen != envelope_gen_num_attack && !reset && eg_off)
+    {
+        eg_rout = 0x1ff;
+    }
+    switch (gen)
+    {
+    case envelope_gen_num_attack:
+        if (!bs->eg_rout)
         {
-            chip->eg_timer = 0;
-            chip->eg_timerrem = 1;
+            gen = envelope_gen_num_decay;
         }
-        else
+        else if (bs->key && shift > 0 && rate_hi != 0x0f)
         {
-            chip->eg_timer++;
-            chip->eg_timerrem = 0;
+            eg_inc = ~bs->eg_rout >> (4 - shift);
+        }
+        break;
+    case envelope_gen_num_decay:
+        if ((bs->eg_rout >> 4) == bs->reg_sl)
+        {
+            gen = envelope_gen_num_sustain;
         }
+        else if (!eg_off && !reset && shift > 0)
+        {
+            eg_inc = 1 << (shift - 1);
+        }
+        break;
+    case envelope_gen_num_sustain:
+    case envelope_gen_num_release:
+        if (!eg_off && !reset && shift > 0)
+        {
+            eg_inc = 1 << (shift - 1);
+        }
+        break;
     }
+    bs->eg_rout = (eg_rout + eg_inc) & 0x1ff;
+    if (reset)
+    {
+        gen = envelope_gen_num_attack;
+    }
+    if (!bs->key)
+    {
+        gen = envelope_gen_num_release;
+    }
+    bs->eg_gen = gen;
 
-    chip->eg_state ^= 1;
-
-    while ((writebuf = &chip->writebuf[chip->writebuf_cur]), writebuf->time <= chip->writebuf_samplecnt)
+    bs->pg_phase_out = (uint16_t)(bs->pg_phase >> 9);
+    if (reset)
     {
-        if (!(writebuf->reg & 0x200))
-        {
-            break;
-        }
-        writebuf->reg &= 0x1ff;
-        OPL3_WriteReg(chip, writebuf->reg, writebuf->data);
-        chip->writebuf_cur = (chip->writebuf_cur + 1) % OPL_WRITEBUF_SIZE;
+        bs->pg_phase = 0;
     }
-    chip->writebuf_samplecnt++;
+    bs->pg_phase += bs->pg_inc[bs->vib ? clk->vibpos : 0];
 }
 
-void OPL3_Generate(opl3_chip *chip, int16_t *buf)
+static void OPL3_BlockSlotRun(opl3_blockslot *bsp, const opl3_blockclk *clk, uint32_t count,
+                              const int16_t *mod, int16_t *out)
 {
-    int16_t samples[4];
-    OPL3_Generate4Ch(chip, samples);
-    buf[0] = samples[0];
-    buf[1] = samples[1];
+    opl3_blockslot bs = *bsp;
+    uint32_t t;
+
+#define OPL_BLOCK_RUN(sinfunc) \
+    for (t = 0; t < count; t++) \
+    { \
+        OPL3_BlockSlotClock(&bs, &clk[t]); \
+        bs.out = sinfunc(bs.pg_phase_out + (mod ? mod[t] : bs.fbmod), bs.eg_out); \
+        out[t] = bs.out; \
+    } \
+    break
+
+    /* Waveform is fixed for the block, so dispatch once rather than per sample */
+    switch (bs.slot->reg_wf)
+    {
+    case 0: OPL_BLOCK_RUN(OPL3_EnvelopeCalcSin0);
+    case 1: OPL_BLOCK_RUN(OPL3_EnvelopeCalcSin1);
+    case 2: OPL_BLOCK_RUN(OPL3_EnvelopeCalcSin2);
+    case 3: OPL_BLOCK_RUN(OPL3_EnvelopeCalcSin3);
+    case 4: OPL_BLOCK_RUN(OPL3_EnvelopeCalcSin4);
+    case 5: OPL_BLOCK_RUN(OPL3_EnvelopeCalcSin5);
+    case 6: OPL_BLOCK_RUN(OPL3_EnvelopeCalcSin6);
+    default: OPL_BLOCK_RUN(OPL3_EnvelopeCalcSin7);
+    }
+#undef OPL_BLOCK_RUN
+    *bsp = bs;
 }
 
-void OPL3_Generate4ChResampled(opl3_chip *chip, int16_t *buf4)
+static inline uint32_t OPL3_BlockNoise(uint32_t noise, uint8_t steps)
 {
-    while (chip->samplecnt >= chip->rateratio)
+    uint32_t n_bit;
+    uint8_t run;
+
+    /* Up to 8 steps only consume bits that are still from the input state */
+    while (steps)
     {
-        chip->oldsamples[0] = chip->samples[0];
-        chip->oldsamples[1] = chip->samples[1];
-        chip->oldsamples[2] = chip->samples[2];
-        chip->oldsamples[3] = chip->samples[3];
-        OPL3_Generate4Ch(chip, chip->samples);
-        chip->samplecnt -= chip->rateratio;
+        run = steps > 8 ? 8 : steps;
+        n_bit = ((noise >> 14) ^ noise) & ((1u << run) - 1u);
+        noise = (noise >> run) | (n_bit << (23 - run));
+        steps -= run;
     }
-    buf4[0] = (int16_t)((chip->oldsamples[0] * (chip->rateratio - chip->samplecnt)
-                        + chip->samples[0] * chip->samplecnt) / chip->rateratio);
-    buf4[1] = (int16_t)((chip->oldsamples[1] * (chip->rateratio - chip->samplecnt)
-                        + chip->samples[1] * chip->samplecnt) / chip->rateratio);
-    buf4[2] = (int16_t)((chip->oldsamples[2] * (chip->rateratio - chip->samplecnt)
-                        + chip->samples[2] * chip->samplecnt) / chip->rateratio);
-    buf4[3] = (int16_t)((chip->oldsamples[3] * (chip->rateratio - chip->samplecnt)
-                        + chip->samples[3] * chip->samplecnt) / chip->rateratio);
-    chip->samplecnt += 1 << RSM_FRAC;
+    return noise;
 }
 
-void OPL3_GenerateResampled(opl3_chip *chip, int16_t *buf)
+static const int16_t opl3_blockzeros[OPL_BLOCK_SIZE + 1];
+
+static void OPL3_BlockRender(opl3_chip *chip, int16_t *buf, uint32_t count)
 {
-    int16_t samples[4];
-    OPL3_Generate4ChResampled(chip, samples);
-    buf[0] = samples[0];
-    buf[1] = samples[1];
+    const int16_t *zeros = opl3_blockzeros;
+    int16_t outbuf[36][OPL_BLOCK_SIZE + 1];
+    opl3_blockclk clk[OPL_BLOCK_SIZE];
+    opl3_blockslot bs[5];
+    opl3_blockslot *cur;
+    const int16_t *src[2][18][4];
+    opl3_channel *channel;
+    uint32_t t;
+    uint32_t noise;
+    uint8_t ii, jj, kk;
+    int8_t idx;
+    int16_t accm, modval;
+    int32_t mix[2] = { 0, 0 };
+    int32_t prevright;
+
+    /* Chip-wide clocks as seen by the slots of each sample */
+    for (t = 0; t < count; t++)
+    {
+        clk[t].tremolo = chip->tremolo;
+        clk[t].vibpos = chip->vibpos;
+        clk[t].eg_state = chip->eg_state;
+        clk[t].eg_add = chip->eg_add;
+        clk[t].eg_timer_lo = chip->eg_timer_lo;
+        OPL3_UpdateTimers(chip);
+    }
+
+    for (ii = 0; ii < 36; ii++)
+    {
+        if (ii == 13)
+        {
+            /* Rhythm slots: sample-major, with the shared noise generator */
+            for (jj = 0; jj < 5; jj++)
+            {
+                OPL3_BlockSlotSetup(&bs[jj], &chip->slot[13 + jj]);
+                outbuf[13 + jj][0] = bs[jj].out;
+            }
+            noise = chip->noise;
+            for (t = 0; t < count; t++)
+            {
+                noise = OPL3_BlockNoise(noise, 13);
+                for (jj = 0; jj < 5; jj++)
+                {
+                    cur = &bs[jj];
+                    OPL3_BlockSlotClock(cur, &clk[t]);
+                    cur->pg_phase_out = OPL3_PhaseRhythm(chip, 13 + jj, cur->pg_phase_out, noise);
+                    noise = OPL3_BlockNoise(noise, 1);
+                    idx = cur->mod;
+                    modval = idx >= 0 ? outbuf[idx][t + 1] : (idx == OPL_BLOCK_MOD_FB ? cur->fbmod : 0);
+                    cur->out = cur->wf(cur->pg_phase_out + modval, cur->eg_out);
+                    outbuf[13 + jj][t + 1] = cur->out;
+                }
+                noise = OPL3_BlockNoise(noise, 18);
+            }
+            chip->noise = noise;
+            for (jj = 0; jj < 5; jj++)
+            {
+                OPL3_BlockSlotStore(&bs[jj]);
+            }
+            ii = 17;
+            continue;
+        }
+        OPL3_BlockSlotSetup(&bs[0], &chip->slot[ii]);
+        outbuf[ii][0] = bs[0].out;
+        idx = bs[0].mod;
+        OPL3_BlockSlotRun(&bs[0], clk, count,
+                          idx >= 0 ? &outbuf[idx][1] : (idx == OPL_BLOCK_MOD_FB ? NULL : zeros),
+                          &outbuf[ii][1]);
+        OPL3_BlockSlotStore(&bs[0]);
+    }
+
+    /* Mix sources; with the quirk, late slots contribute their previous sample */
+    for (ii = 0; ii < 18; ii++)
+    {
+        for (kk = 0; kk < 4; kk++)
+        {
+            idx = OPL3_BlockSlotIndex(chip, chip->channel[ii].out[kk]);
+            if (idx < 0)
+            {
+                src[0][ii][kk] = src[1][ii][kk] = zeros;
+                continue;
+            }
+#if OPL_QUIRK_CHANNELSAMPLEDELAY
+            src[0][ii][kk] = &outbuf[idx][idx < 15 ? 1 : 0];
+            src[1][ii][kk] = &outbuf[idx][idx < 33 ? 1 : 0];
+#else
+            src[0][ii][kk] = src[1][ii][kk] = &outbuf[idx][1];
+#endif
+        }
+    }
+
+    prevright = chip->mixbuff[1];
+    for (t = 0; t < count; t++)
+    {
+        mix[0] = mix[1] = 0;
+        for (ii = 0; ii < 18; ii++)
+        {
+            channel = &chip->channel[ii];
+            accm = src[0][ii][0][t] + src[0][ii][1][t] + src[0][ii][2][t] + src[0][ii][3][t];
+#if OPL_ENABLE_STEREOEXT
+            mix[0] += (int16_t)((accm * channel->leftpan) >> 16);
+#else
+            mix[0] += (int16_t)(accm & channel->cha);
+#endif
+            accm = src[1][ii][0][t] + src[1][ii][1][t] + src[1][ii][2][t] + src[1][ii][3][t];
+#if OPL_ENABLE_STEREOEXT
+            mix[1] += (int16_t)((accm * channel->rightpan) >> 16);
+#else
+            mix[1] += (int16_t)(accm & channel->chb);
+#endif
+        }
+        buf[0] = OPL3_ClipSample(mix[0]);
+        buf[1] = OPL3_ClipSample(prevright);
+        prevright = mix[1];
+        buf += 2;
+    }
+    chip->mixbuff[0] = mix[0];
+    chip->mixbuff[1] = mix[1];
+
+    /* The second DAC pair is only observable through the last sample's mixbuff */
+    t = count - 1;
+    mix[0] = mix[1] = 0;
+    for (ii = 0; ii < 18; ii++)
+    {
+        channel = &chip->channel[ii];
+        accm = src[0][ii][0][t] + src[0][ii][1][t] + src[0][ii][2][t] + src[0][ii][3][t];
+        mix[0] += (int16_t)(accm & channel->chc);
+        accm = src[1][ii][0][t] + src[1][ii][1][t] + src[1][ii][2][t] + src[1][ii][3][t];
+        mix[1] += (int16_t)(accm & channel->chd);
+    }
+    chip->mixbuff[2] = mix[0];
+    chip->mixbuff[3] = mix[1];
+}
+
+void OPL3_GenerateBlock(opl3_chip *chip, int16_t *buf, uint32_t numsamples)
+{
+    opl3_writebuf *writebuf;
+    uint32_t count;
+    uint64_t due;
+
+    while (numsamples)
+    {
+        count = numsamples < OPL_BLOCK_SIZE ? numsamples : OPL_BLOCK_SIZE;
+        /* Split at the next buffered write so it lands on its own sample */
+        writebuf = &chip->writebuf[chip->writebuf_cur];
+        if (writebuf->reg & 0x200)
+        {
+            due = writebuf->time <= chip->writebuf_samplecnt
+                ? 1 : writebuf->time - chip->writebuf_samplecnt + 1;
+            if (due < count)
+            {
+                count = (uint32_t)due;
+            }
+        }
+        OPL3_BlockRender(chip, buf, count);
+        chip->writebuf_samplecnt += count - 1;
+        OPL3_ProcessWriteBuf(chip);
+        chip->writebuf_samplecnt++;
+        buf += count * 2;
+        numsamples -= count;
+    }
 }
 
 void OPL3_Reset(opl3_chip *chip, uint32_t samplerate)
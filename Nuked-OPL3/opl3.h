@@ -46,6 +46,11 @@ extern "C" {
 #define OPL_WRITEBUF_SIZE   1024
 #define OPL_WRITEBUF_DELAY  2
 
+/* Samples rendered per slot-major pass in OPL3_GenerateBlock */
+#ifndef OPL_BLOCK_SIZE
+#define OPL_BLOCK_SIZE      64
+#endif
+
 typedef struct _opl3_slot opl3_slot;
 typedef struct _opl3_channel opl3_channel;
 typedef struct _opl3_chip opl3_chip;
@@ -166,6 +171,8 @@ void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4);
 void OPL3_Generate4ChResampled(opl3_chip *chip, int16_t *buf4);
 void OPL3_Generate4ChStream(opl3_chip *chip, int16_t *sndptr1, int16_t *sndptr2, uint32_t numsamples);
 
+void OPL3_GenerateBlock(opl3_chip *chip, int16_t *buf, uint32_t numsamples);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,47 @@
+#!/bin/sh
+#
+# T-state数のCSVを基準値と比べる
+#
+# 使い方: bench/compare.sh <baseline.csv> <current.csv> <tolerance>
+#   例: bench/compare.sh bench/baseline/ticks-perf.csv build/ticks-perf.csv 2
+#
+# 1列目を名前、最後の列を1サンプル(1回)あたりのT-state数として行ごとに
+# 比べ、"name,baseline,current,change_pct" 形式のCSVで出力します。
+# tolerance(%)を超えて増えた行、基準値にない行、なくなった行があれば
+# 終了コード1を返します。基準値のファイルがなければ何も比べずに1です。
+
+BASELINE=$1
+CURRENT=$2
+TOLERANCE=$3
+
+if [ ! -f "$BASELINE" ]; then
+    echo "$BASELINE: 基準値がありません (make ticks-baselineで作ります)" >&2
+    exit 1
+fi
+
+echo "name,baseline,current,change_pct"
+awk -F, -v tol="$TOLERANCE" '
+FNR == 1 { file++; next }
+file == 1 { ref[$1] = $NF; order[++n] = $1; next }
+{
+    seen[$1] = 1;
+    if (!($1 in ref)) {
+        printf "%s,,%s,new\n", $1, $NF;
+        bad = 1;
+        next;
+    }
+    change = ref[$1] > 0 ? ($NF - ref[$1]) * 100 / ref[$1] : 0;
+    printf "%s,%s,%s,%+.1f\n", $1, ref[$1], $NF, change;
+    if (change > tol) {
+        bad = 1;
+    }
+}
+END {
+    for (i = 1; i <= n; i++) {
+        if (!(order[i] in seen)) {
+            printf "%s,%s,,missing\n", order[i], ref[order[i]];
+            bad = 1;
+        }
+    }
+    exit bad;
+}' "$BASELINE" "$CURRENT"
@@ -0,0 +1,32 @@
+#!/bin/sh
+#
+# eg_add計算のT-state測定(z88dk-ticks)
+#
+# 使い方: bench/egadd.sh <build_dir> <calls> <zcc command...>
+#
+# bench/opl3_egadd.c を方式ごとにビルドして実行し、空ループとの差分を
+# "method,calls,tstates_per_call,tstates_per_sample" 形式のCSVで出力します。
+
+set -e
+
+BUILD_DIR=$1
+CALLS=$2
+shift 2
+TICKS=${TICKS:-z88dk-ticks}
+SRC=$(dirname "$0")/opl3_egadd.c
+
+run_method() {
+    "$@" -DOPL3_EGADD_METHOD=$METHOD -DOPL3_EGADD_CALLS=$CALLS \
+        -o "$BUILD_DIR/egadd_$METHOD.bin" "$SRC" >/dev/null
+    $TICKS "$BUILD_DIR/egadd_$METHOD.bin" | grep -o '[0-9][0-9]*' | tail -1
+}
+
+for METHOD in 0 1 2; do
+    eval "T$METHOD=\$(run_method \"\$@\")"
+done
+
+echo "method,calls,tstates_per_call,tstates_per_sample"
+awk -v n="$CALLS" -v t0="$T0" -v t1="$T1" -v t2="$T2" 'BEGIN {
+    printf "loop,%d,%.1f,%.1f\n", n, (t1 - t0) / n, (t1 - t0) / n / 2;
+    printf "table,%d,%.1f,%.1f\n", n, (t2 - t0) / n, (t2 - t0) / n / 2;
+}'
@@ -0,0 +1,82 @@
+#!/bin/sh
+#
+# バンク切り替えビルド(OPL_BANKED)のメモリマップ検査
+#
+# 使い方: bench/memmap.sh <mapファイル> <バンクのセクション> <窓の先頭> <窓の末尾+1>
+#   例: bench/memmap.sh build/opl3_spectrum128_banked.map BANK_06 0xc000 0x10000
+#
+# zccの-mで出力したマップから、セクションごとの先頭とサイズを表示し、
+# 次を確かめます。どれかに反すると0以外で終わります。
+#   - 切り替える側の関数と表がバンクのセクションにあり、窓の中に置かれている
+#   - それ以外(常駐側、ライブラリ、変数)はすべて窓の外に置かれている
+# マップの行は "名前 = $番地 ; 種類, 公開, , モジュール, セクション, ..." です。
+
+set -e
+
+MAP=$1
+BANK=$2
+LO=$(($3))
+HI=$(($4))
+
+# 切り替える側にあるはずのシンボル
+PAGED="_OPL3_WriteRegPaged _OPL3_ResetPaged _ad_slot _ch_slot _kslrom"
+
+if [ ! -f "$MAP" ]; then
+    echo "memmap: $MAP がありません" >&2
+    exit 1
+fi
+
+echo "section,head,size"
+sed -n 's/^__\([A-Za-z0-9_]*\)_head *= *\$\([0-9A-Fa-f]*\).*/\1 \2/p' "$MAP" |
+while read -r sec head; do
+    size=$(sed -n "s/^__${sec}_size *= *\\\$\\([0-9A-Fa-f]*\\).*/\\1/p" "$MAP")
+    if [ -n "$size" ] && [ $((0x$size)) -ne 0 ]; then
+        echo "$sec,0x$head,$((0x$size))"
+    fi
+done
+
+fail=0
+for sym in $PAGED; do
+    line=$(grep "^$sym *=" "$MAP" || true)
+    if [ -z "$line" ]; then
+        echo "memmap: $sym がマップにありません" >&2
+        fail=1
+        continue
+    fi
+    case "$line" in
+    *", $BANK,"*) ;;
+    *)
+        echo "memmap: $sym が $BANK にありません" >&2
+        fail=1
+        ;;
+    esac
+done
+
+# 番地を持つシンボルを窓の内外で検査する(セクションの境界を示す__*は除く)
+bad=$(awk -v bank="$BANK" -v lo="$LO" -v hi="$HI" '
+    $2 == "=" && $3 ~ /^\$/ && $1 !~ /^__/ && $5 == "addr," {
+        addr = 0
+        hex = toupper(substr($3, 2))
+        for (i = 1; i <= length(hex); i++)
+        {
+            addr = addr * 16 + index("0123456789ABCDEF", substr(hex, i, 1)) - 1
+        }
+        split($0, f, ",")
+        sec = f[5]
+        gsub(/ /, "", sec)
+        inwin = (addr >= lo && addr < hi)
+        if ((sec == bank) != inwin)
+        {
+            printf "%s,%s,%s\n", $1, $3, sec
+        }
+    }' "$MAP")
+if [ -n "$bad" ]; then
+    echo "memmap: 窓の内外が合わないシンボル(名前,番地,セクション):" >&2
+    echo "$bad" >&2
+    fail=1
+fi
+
+if [ $fail -ne 0 ]; then
+    exit 1
+fi
+echo "memmap: $BANK OK"
@@ -0,0 +1,122 @@
+/*
+ * Cross-chip SIMD bundle benchmark (host)
+ *
+ * 全18チャンネルを発音させたOPL_BUNDLE_LANES個のチップを、
+ * opl3_chipごとのOPL3_Generate4Chとバンドルでそれぞれ生成し、
+ * 1チップ1サンプルあたりの時間を比較します。
+ * 出力は "engine,lanes,samples,ns_per_chip_sample,speedup" 形式のCSVです。
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "opl3_bundle.h"
+
+#ifndef OPL3_BUNDLE_SAMPLES
+#define OPL3_BUNDLE_SAMPLES 400000UL
+#endif
+#define OPL3_BUNDLE_RUNS    10
+
+static volatile int32_t sink;
+
+/* test/pool.cと同じ音色(レーンごとに波形とFナンバーを変える) */
+static void bundle_setup(opl3_chip *chip, opl3_bundle *bundle, uint8_t lane)
+{
+    static const uint8_t regs[8] = { 0x20, 0x23, 0x60, 0x63, 0xe0, 0xc0, 0xa0, 0xb0 };
+    uint8_t data[8];
+    uint16_t high, ch, op, reg;
+    uint8_t i;
+
+    OPL3_WriteReg(chip, 0x105, 0x01);
+    OPL3_BundleWriteReg(bundle, lane, 0x105, 0x01);
+    for (ch = 0; ch < 18; ch++)
+    {
+        high = ch >= 9 ? 0x100 : 0x000;
+        op = (ch % 9 % 3) + (ch % 9 / 3) * 8;
+        data[0] = 0xe1;
+        data[1] = 0x21;
+        data[2] = 0xf2 + (lane & 0x0f);
+        data[3] = 0xe4;
+        data[4] = (uint8_t)(lane + ch) & 0x07;
+        data[5] = 0x30 | ((lane + ch) & 0x0e);
+        data[6] = (uint8_t)(0x40 + lane + ch);
+        data[7] = 0x31;
+        for (i = 0; i < 8; i++)
+        {
+            reg = high | (regs[i] + (i < 5 ? op : ch % 9));
+            OPL3_WriteReg(chip, reg, data[i]);
+            OPL3_BundleWriteReg(bundle, lane, reg, data[i]);
+        }
+    }
+}
+
+int main(void)
+{
+    static opl3_chip chips[OPL_BUNDLE_LANES];
+    const unsigned long count = OPL3_BUNDLE_SAMPLES / OPL3_BUNDLE_RUNS;
+    int16_t buf4[OPL_BUNDLE_LANES][4];
+    double ns, best[2] = { 0.0, 0.0 };
+    opl3_bundle *bundle;
+    clock_t start;
+    unsigned long n;
+    int32_t acc = 0;
+    uint8_t lane;
+    int run;
+
+    bundle = OPL3_BundleCreate();
+    if (!bundle)
+    {
+        fprintf(stderr, "bundle: out of memory\n");
+        return 1;
+    }
+    for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+    {
+        OPL3_Reset(&chips[lane], 49716);
+        bundle_setup(&chips[lane], bundle, lane);
+    }
+
+    /* 交互に測って最小値を取る(周波数変動の影響を揃える) */
+    for (run = 0; run < OPL3_BUNDLE_RUNS; run++)
+    {
+        start = clock();
+        for (n = 0; n < count; n++)
+        {
+            for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+            {
+                OPL3_Generate4Ch(&chips[lane], buf4[lane]);
+                acc += buf4[lane][0];
+            }
+        }
+        ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count / OPL_BUNDLE_LANES;
+        if (run == 0 || ns < best[0])
+        {
+            best[0] = ns;
+        }
+
+        start = clock();
+        for (n = 0; n < count; n++)
+        {
+            OPL3_BundleGenerate4Ch(bundle, buf4);
+            for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+            {
+                acc += buf4[lane][0];
+            }
+        }
+        ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count / OPL_BUNDLE_LANES;
+        if (run == 0 || ns < best[1])
+        {
+            best[1] = ns;
+        }
+    }
+    sink = acc;
+
+    printf("engine,lanes,samples,ns_per_chip_sample,speedup\n");
+    printf("chip,%d,%lu,%.2f,1.00\n", OPL_BUNDLE_LANES, count, best[0]);
+    printf("bundle,%d,%lu,%.2f,%.2f\n", OPL_BUNDLE_LANES, count, best[1],
+           best[0] / best[1]);
+    for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+    {
+        OPL3_Release(&chips[lane]);
+    }
+    OPL3_BundleDestroy(bundle);
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * eg_add microbenchmark for Nuked-OPL3 on z88dk
+ *
+ * OPL3_UpdateTimersのeg_add計算(eg_timerの最下位ビット探索)を、
+ * 以前のwhileループと表引き(OPL3_EnvelopeAdd)で比較します。
+ * eg_addは2サンプルに1回計算するので、1サンプルあたりの差は半分です。
+ *
+ * ホスト: 16bitの全値で両者が一致することを確認してから時間を測り、
+ *         "method,calls,ns_per_call,ns_per_sample" 形式のCSVを出力します。
+ * z88dk:  OPL3_EGADD_METHOD(0: 空ループ, 1: whileループ, 2: 表引き)ごとに
+ *         ビルドし、z88dk-ticksの差分を bench/egadd.sh が集計します。
+ */
+
+/* staticな内部関数を直接呼ぶため、実装をそのまま取り込む */
+#include "../src/opl3.c"
+
+#ifndef OPL3_EGADD_CALLS
+#ifdef __Z88DK__
+#define OPL3_EGADD_CALLS 1024
+#else
+#define OPL3_EGADD_CALLS 100000000UL
+#endif
+#endif
+
+static volatile uint8_t sink;
+
+/* 以前の実装(下位13bitを1bitずつ走査) */
+static uint8_t egadd_loop(uint16_t eg_timer)
+{
+    uint8_t shift = 0;
+
+    while (shift < 13 && ((eg_timer >> shift) & 1) == 0)
+    {
+        shift++;
+    }
+    return shift > 12 ? 0 : shift + 1;
+}
+
+#ifdef __Z88DK__
+
+int main(void)
+{
+    uint16_t n;
+    uint8_t acc = 0;
+
+    for (n = 0; n < OPL3_EGADD_CALLS; n++)
+    {
+#if OPL3_EGADD_METHOD == 1
+        acc += egadd_loop(n);
+#elif OPL3_EGADD_METHOD == 2
+        acc += OPL3_EnvelopeAdd(n);
+#else
+        acc += (uint8_t)n;
+#endif
+    }
+    sink = acc;
+    return 0;
+}
+
+#else
+
+#include <stdio.h>
+#include <time.h>
+
+static double egadd_time(uint8_t (*fn)(uint16_t), unsigned long calls)
+{
+    clock_t start;
+    unsigned long n;
+    uint8_t acc = 0;
+
+    start = clock();
+    for (n = 0; n < calls; n++)
+    {
+        acc += fn((uint16_t)n);
+    }
+    sink = acc;
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / calls;
+}
+
+static uint8_t egadd_none(uint16_t eg_timer)
+{
+    return (uint8_t)eg_timer;
+}
+
+int main(void)
+{
+    static const char *names[3] = { "none", "loop", "table" };
+    uint8_t (*fns[3])(uint16_t) = { egadd_none, egadd_loop, OPL3_EnvelopeAdd };
+    double ns[3];
+    uint32_t v;
+    int i;
+
+    for (v = 0; v < 0x10000; v++)
+    {
+        if (egadd_loop((uint16_t)v) != OPL3_EnvelopeAdd((uint16_t)v))
+        {
+            fprintf(stderr, "egadd: mismatch at %04lx\n", (unsigned long)v);
+            return 1;
+        }
+    }
+    for (i = 0; i < 3; i++)
+    {
+        ns[i] = egadd_time(fns[i], OPL3_EGADD_CALLS);
+    }
+    printf("method,calls,ns_per_call,ns_per_sample\n");
+    for (i = 1; i < 3; i++)
+    {
+        printf("%s,%lu,%.3f,%.3f\n", names[i], (unsigned long)OPL3_EGADD_CALLS,
+               ns[i] - ns[0], (ns[i] - ns[0]) / 2);
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ * Channel mixer benchmark for Nuked-OPL3 (host, x86)
+ *
+ * OPL3_Generate4Chのチャンネルミックス(1サンプルに2パス)を、スカラー版と
+ * SSE2/AVX2版のカーネルで比較します。最初にsig[]の全範囲(16bitの
+ * 折り返しが起きる値を含む)、出力先インデックス、cha-chdをランダムに
+ * 変えて全カーネルの結果がスカラー版と一致することを確認し、その後で
+ * 時間を測って "kernel,samples,ns_per_sample,speedup" 形式のCSVを出力します。
+ * CPUが対応しないカーネルは飛ばします。
+ */
+
+/* staticな内部関数を直接呼ぶため、実装をそのまま取り込む */
+#include "../src/opl3.c"
+
+#include <stdio.h>
+#include <time.h>
+
+#if !OPL_MIX_SIMD
+int main(void)
+{
+    printf("mix: OPL_MIX_SIMD is disabled in this build\n");
+    return 0;
+}
+#else
+
+#ifndef OPL3_MIX_SAMPLES
+#define OPL3_MIX_SAMPLES 20000000UL
+#endif
+#define OPL3_MIX_RUNS   20
+#define OPL3_MIX_CHECKS 100000UL
+
+typedef struct {
+    const char *name;
+    const char *feature;
+    opl3_mixfunc func;
+} mix_kernel;
+
+static const mix_kernel kernels[3] = {
+    { "scalar", NULL, OPL3_MixScalar },
+    { "sse2", "sse2", OPL3_MixSSE2 },
+    { "avx2", "avx2", OPL3_MixAVX2 }
+};
+
+static volatile int32_t sink;
+
+static uint32_t mix_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static int mix_supported(const mix_kernel *k)
+{
+    if (!k->feature)
+    {
+        return 1;
+    }
+    if (k->feature[0] == 'a')
+    {
+        return __builtin_cpu_supports("avx2");
+    }
+    return __builtin_cpu_supports("sse2");
+}
+
+/* ランダムな信号とルーティングを与えて、全カーネルの一致を確認する */
+static int mix_check(opl3_chip *chip)
+{
+    uint32_t state = 1;
+    unsigned long n;
+    int32_t ref[2], got[2];
+    uint8_t ch, k, pass, i;
+
+    for (n = 0; n < OPL3_MIX_CHECKS; n++)
+    {
+        for (i = 0; i < OPL_SIG_ZERO; i++)
+        {
+            /* 4分の1は最大振幅付近にして折り返しを起こす */
+            chip->sig[i] = (mix_rand(&state) & 3)
+                         ? (int16_t)mix_rand(&state)
+                         : (int16_t)((mix_rand(&state) & 1) ? 0x7fff : -0x8000);
+        }
+        for (ch = 0; ch < 18; ch++)
+        {
+            for (i = 0; i < 4; i++)
+            {
+                chip->channel[ch].out[i] = (uint8_t)(mix_rand(&state) % OPL_SIG_NUM);
+            }
+            OPL3_ChannelWriteC0(chip, &chip->channel[ch], (uint8_t)mix_rand(&state));
+        }
+        for (pass = 0; pass < 2; pass++)
+        {
+            OPL3_MixScalar(chip, pass, ref);
+            for (k = 1; k < 3; k++)
+            {
+                if (!mix_supported(&kernels[k]))
+                {
+                    continue;
+                }
+                kernels[k].func(chip, pass, got);
+                if (got[0] != ref[0] || got[1] != ref[1])
+                {
+                    fprintf(stderr, "mix: %s differs at check %lu pass %u:"
+                            " %ld,%ld != %ld,%ld\n", kernels[k].name, n, pass,
+                            (long)got[0], (long)got[1], (long)ref[0], (long)ref[1]);
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+/* 1回分(OPL3_MIX_SAMPLES / OPL3_MIX_RUNSサンプル)の1サンプルあたりns */
+static double mix_time(const opl3_chip *chip, opl3_mixfunc func)
+{
+    const unsigned long count = OPL3_MIX_SAMPLES / OPL3_MIX_RUNS;
+    clock_t start;
+    unsigned long n;
+    int32_t mix[2], acc = 0;
+
+    start = clock();
+    for (n = 0; n < count; n++)
+    {
+        func(chip, 0, mix);
+        acc += mix[0] + mix[1];
+        func(chip, 1, mix);
+        acc += mix[0] + mix[1];
+    }
+    sink = acc;
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count;
+}
+
+int main(void)
+{
+    static opl3_chip chip;
+    double ns, best[3];
+    uint8_t k;
+    int run;
+
+    OPL3_Reset(&chip, 49716);
+    OPL3_WriteReg(&chip, 0x105, 0x01);
+    if (!mix_check(&chip))
+    {
+        return 1;
+    }
+
+    /* 周波数の変動をならすため、カーネルを交互に測って最も速い回を使う */
+    for (run = 0; run < OPL3_MIX_RUNS; run++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            if (mix_supported(&kernels[k]))
+            {
+                ns = mix_time(&chip, kernels[k].func);
+                if (run == 0 || ns < best[k])
+                {
+                    best[k] = ns;
+                }
+            }
+        }
+    }
+
+    printf("kernel,samples,ns_per_sample,speedup\n");
+    for (k = 0; k < 3; k++)
+    {
+        if (mix_supported(&kernels[k]))
+        {
+            printf("%s,%lu,%.3f,%.2f\n", kernels[k].name,
+                   (unsigned long)OPL3_MIX_SAMPLES, best[k], best[0] / best[k]);
+        }
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ * Sample generation benchmark with fixed workloads (host)
+ *
+ * bench/opl3_workload.hの各負荷について、移植版(src/opl3.c)と
+ * 元の実装(Nuked-OPL3/opl3.c)をOPL3_GenerateStreamで49716Hz
+ * (リサンプルなし)で生成し、1秒あたりのサンプル数と1サンプルあたりの
+ * 時間を測ります。2つのエンジンは交互に測って最小値を取ります。
+ * 出力は "engine,workload,samples,samples_per_sec,ns_per_sample,vs_ref"
+ * 形式のCSVです(vs_refは元の実装の時間との比、大きいほど速い)。
+ *
+ * ステレオ拡張の負荷は OPL_ENABLE_STEREOEXT=1 のビルドだけで測り、
+ * それ以外の負荷はそのビルドでは測りません(make bench-perfが両方を
+ * ビルドし、-nで2つ目のヘッダーを省いて1つのCSVにします)。
+ *
+ * OPL3_PROFILE=1でビルドすると(make bench-profile)、時間の代わりに
+ * 移植版のステージ別の積算値を
+ * "workload,stage,calls_per_sample,ticks_per_sample,share" 形式で出力します
+ * (ticksの単位はrdtscのサイクルかナノ秒、shareは全体に対する割合)。
+ *
+ * 使い方:
+ *   perf [-s samples] [-r runs] [-n]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "opl3.h"
+#include "../test/golden.h"
+#include "opl3_workload.h"
+
+#define PERF_SAMPLES    200000UL
+#define PERF_RUNS       5
+#define PERF_WARMUP     2048
+#define PERF_CHUNK      512
+
+static const char *const perf_names[PERF_WORKLOADS] = {
+    "silence", "2op18", "4op6+2op6", "rhythm", "stereoext", "traffic"
+};
+
+#if OPL3_PROFILE
+static const char *const perf_stages[OPL_PROF_STAGES] = {
+    "envelope", "phase", "slot", "mix", "timers", "writebuf", "total"
+};
+
+/* 移植版(engines[1])のステージ別の値をsamples分で割って出す */
+static void perf_profile(const opl3_chip *chip, uint8_t workload, double samples)
+{
+    opl3_profile stats;
+    uint8_t i;
+
+    OPL3_GetProfile(chip, &stats);
+    for (i = 0; i < OPL_PROF_STAGES; i++)
+    {
+        printf("%s,%s,%.2f,%.1f,%.3f\n", perf_names[workload], perf_stages[i],
+               (double)stats.calls[i] / samples, (double)stats.ticks[i] / samples,
+               (double)stats.ticks[i] / (double)stats.ticks[OPL_PROF_TOTAL]);
+    }
+}
+#endif
+
+static int16_t perf_buf[PERF_CHUNK * 2];
+static volatile int16_t sink;
+
+/* count分を生成する。trafficは間隔ごとに書き込みを挟む */
+static double perf_run(const golden_engine *engine, void *chip, uint8_t workload,
+                       unsigned long count, uint16_t *step)
+{
+    clock_t start = clock();
+    unsigned long n;
+    uint32_t chunk;
+
+    for (n = 0; n < count; n += chunk)
+    {
+        chunk = count - n < PERF_CHUNK ? (uint32_t)(count - n) : PERF_CHUNK;
+        if (workload == PERF_TRAFFIC)
+        {
+            if (chunk > PERF_TRAFFIC_STEP)
+            {
+                chunk = PERF_TRAFFIC_STEP;
+            }
+            perf_traffic(engine->write, chip, (*step)++);
+        }
+        engine->stream(chip, perf_buf, chunk);
+    }
+    sink = perf_buf[0];
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count;
+}
+
+int main(int argc, char **argv)
+{
+    static const golden_engine *const engines[2] = { &golden_ref, &golden_port };
+    unsigned long samples = PERF_SAMPLES;
+    void *chips[2];
+    double ns, best[2];
+    uint16_t steps[2];
+    uint8_t workload, e;
+    int runs = PERF_RUNS, header = 1, arg, run;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        if (argv[arg][0] == '-' && argv[arg][1] == 'n')
+        {
+            header = 0;
+        }
+        else if (arg + 1 < argc && argv[arg][0] == '-' && argv[arg][1] == 's')
+        {
+            samples = strtoul(argv[++arg], NULL, 0);
+        }
+        else if (arg + 1 < argc && argv[arg][0] == '-' && argv[arg][1] == 'r')
+        {
+            runs = atoi(argv[++arg]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: perf [-s samples] [-r runs] [-n]\n");
+            return 2;
+        }
+    }
+    if (samples == 0 || runs < 1)
+    {
+        fprintf(stderr, "perf: samples and runs must be positive\n");
+        return 2;
+    }
+
+    if (header)
+    {
+#if OPL3_PROFILE
+        printf("workload,stage,calls_per_sample,ticks_per_sample,share\n");
+#else
+        printf("engine,workload,samples,samples_per_sec,ns_per_sample,vs_ref\n");
+#endif
+    }
+    for (workload = 0; workload < PERF_WORKLOADS; workload++)
+    {
+        if ((workload == PERF_STEREOEXT) != (OPL_ENABLE_STEREOEXT != 0))
+        {
+            continue;
+        }
+        for (e = 0; e < 2; e++)
+        {
+            chips[e] = engines[e]->create(49716);
+            if (!chips[e])
+            {
+                fprintf(stderr, "perf: out of memory\n");
+                return 1;
+            }
+            perf_setup(engines[e]->write, chips[e], workload);
+            steps[e] = 0;
+            perf_run(engines[e], chips[e], workload, PERF_WARMUP, &steps[e]);
+        }
+#if OPL3_PROFILE
+        OPL3_ClearProfile((opl3_chip *)chips[1]);
+#endif
+        /* 交互に測って最小値を取る(周波数変動の影響を揃える) */
+        for (run = 0; run < runs; run++)
+        {
+            for (e = 0; e < 2; e++)
+            {
+                ns = perf_run(engines[e], chips[e], workload, samples, &steps[e]);
+                if (run == 0 || ns < best[e])
+                {
+                    best[e] = ns;
+                }
+            }
+        }
+#if OPL3_PROFILE
+        perf_profile((const opl3_chip *)chips[1], workload, (double)samples * runs);
+#endif
+        for (e = 0; e < 2; e++)
+        {
+#if !OPL3_PROFILE
+            printf("%s,%s,%lu,%.0f,%.2f,%.2f\n", engines[e]->name, perf_names[workload],
+                   samples, 1e9 / best[e], best[e], best[0] / best[e]);
+#endif
+            engines[e]->destroy(chips[e]);
+        }
+    }
+    return 0;
+}
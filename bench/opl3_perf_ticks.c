@@ -0,0 +1,57 @@
+/*
+ * Per-workload T-state measurement for Nuked-OPL3 on z88dk
+ *
+ * bench/opl3_workload.hの負荷をOPL3_PERF_WORKLOADで選んでビルドし、
+ * z88dk-ticksで実行します。OPL3_PERF_SAMPLES=0のビルド(リセット、
+ * 音色設定、ウォームアップだけ)との差分を、生成したサンプル数で割った
+ * ものが1サンプルあたりのT-state数です。生成はホストと同じく
+ * OPL3_GenerateStreamで49716Hz(リサンプルなし)、trafficでは
+ * PERF_TRAFFIC_STEPサンプルごとに書き込みを挟みます。
+ * 集計は bench/perf.sh (make ticks-perf) が行います。
+ */
+
+#include "opl3.h"
+#include "opl3_workload.h"
+
+#ifndef OPL3_PERF_WORKLOAD
+#define OPL3_PERF_WORKLOAD PERF_2OP18
+#endif
+
+#ifndef OPL3_PERF_SAMPLES
+#define OPL3_PERF_SAMPLES 32
+#endif
+
+#define OPL3_PERF_WARMUP 64
+
+static opl3_chip chip;
+static int16_t buf[PERF_TRAFFIC_STEP * 2];
+static volatile int16_t sink;
+
+static void perf_write(void *c, uint16_t reg, uint8_t v)
+{
+    OPL3_WriteReg((opl3_chip *)c, reg, v);
+}
+
+int main(void)
+{
+    uint16_t n, step = 0;
+
+    OPL3_Reset(&chip, 49716);
+    perf_setup(perf_write, &chip, OPL3_PERF_WORKLOAD);
+    for (n = 0; n < OPL3_PERF_WARMUP; n += PERF_TRAFFIC_STEP)
+    {
+        OPL3_GenerateStream(&chip, buf, PERF_TRAFFIC_STEP);
+    }
+
+    for (n = 0; n < OPL3_PERF_SAMPLES; n += PERF_TRAFFIC_STEP)
+    {
+        /* 定数の比較なので、traffic以外では消える */
+        if (OPL3_PERF_WORKLOAD == PERF_TRAFFIC)
+        {
+            perf_traffic(perf_write, &chip, step++);
+        }
+        OPL3_GenerateStream(&chip, buf, PERF_TRAFFIC_STEP);
+    }
+    sink = buf[0];
+    return 0;
+}
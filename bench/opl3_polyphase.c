@@ -0,0 +1,216 @@
+/*
+ * Block polyphase resampler benchmark (host)
+ *
+ * 全18チャンネルを発音させたチップを44100Hzと48000Hzで
+ * OPL3_GenerateStreamにより生成し、各プリセット・各FIRカーネルの
+ * 出力1サンプルあたりの時間を線形補間(OPL_RESAMPLE_LINEAR)と比較します。
+ * 線形補間のチップとは交互に測って最小値を取ります。
+ * fir_nsはチップの生成を除いたFIRだけの時間です。
+ * 出力は "rate,quality,taps,kernel,fir_ns,stream_ns,linear_ns,stream_ratio"
+ * 形式のCSVです。CPUが対応しないカーネルは飛ばします。
+ */
+
+/* staticな内部関数を直接呼ぶため、実装をそのまま取り込む */
+#include "../src/opl3_resample.c"
+
+#include <stdio.h>
+#include <time.h>
+
+#ifndef OPL3_POLYPHASE_SAMPLES
+#define OPL3_POLYPHASE_SAMPLES 200000UL
+#endif
+#define OPL3_POLYPHASE_RUNS 10
+#define OPL3_POLYPHASE_CHUNK 512
+
+typedef struct {
+    const char *name;
+    const char *feature;
+    opl3_firfunc func;
+} polyphase_kernel;
+
+static const polyphase_kernel kernels[] = {
+    { "scalar", NULL, OPL3_FirScalar },
+#if OPL_RESAMPLE_SIMD
+    { "sse2", "sse2", OPL3_FirSSE2 },
+    { "avx2", "avx2", OPL3_FirAVX2 },
+#endif
+};
+
+static volatile int32_t sink;
+
+/* bench/opl3_bundle.cと同じ音色 */
+static void polyphase_setup(opl3_chip *chip)
+{
+    static const uint8_t regs[8] = { 0x20, 0x23, 0x60, 0x63, 0xe0, 0xc0, 0xa0, 0xb0 };
+    uint8_t data[8];
+    uint16_t high, ch, op;
+    uint8_t i;
+
+    OPL3_WriteReg(chip, 0x105, 0x01);
+    for (ch = 0; ch < 18; ch++)
+    {
+        high = ch >= 9 ? 0x100 : 0x000;
+        op = (ch % 9 % 3) + (ch % 9 / 3) * 8;
+        data[0] = 0xe1;
+        data[1] = 0x21;
+        data[2] = 0xf2;
+        data[3] = 0xe4;
+        data[4] = (uint8_t)ch & 0x07;
+        data[5] = 0x30 | (ch & 0x0e);
+        data[6] = (uint8_t)(0x40 + ch);
+        data[7] = 0x31;
+        for (i = 0; i < 8; i++)
+        {
+            OPL3_WriteReg(chip, high | (regs[i] + (i < 5 ? op : ch % 9)), data[i]);
+        }
+    }
+}
+
+static int polyphase_supported(const polyphase_kernel *kernel)
+{
+    if (!kernel->feature)
+    {
+        return 1;
+    }
+#if OPL_RESAMPLE_SIMD
+    __builtin_cpu_init();
+    if (kernel->func == OPL3_FirAVX2)
+    {
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    }
+    return __builtin_cpu_supports("sse2");
+#else
+    return 0;
+#endif
+}
+
+static double polyphase_time(opl3_chip *chip, int16_t *buf, unsigned long count, int32_t *acc)
+{
+    clock_t start = clock();
+    unsigned long n;
+
+    for (n = 0; n < count; n += OPL3_POLYPHASE_CHUNK)
+    {
+        OPL3_GenerateStream(chip, buf, OPL3_POLYPHASE_CHUNK);
+        *acc += buf[0];
+    }
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / n;
+}
+
+/*
+ * OPL3_GenerateStreamの1サンプルあたりの時間(最小値)
+ * 線形補間のチップと交互に測り、その最小値をlinearに返す。
+ */
+static double polyphase_stream(uint32_t rate, uint8_t quality, opl3_firfunc func,
+                               double *linear)
+{
+    static opl3_chip chips[2];
+    static int16_t buf[OPL3_POLYPHASE_CHUNK * 2];
+    const unsigned long count = OPL3_POLYPHASE_SAMPLES / OPL3_POLYPHASE_RUNS;
+    double ns, best[2] = { 0.0, 0.0 };
+    int32_t acc = 0;
+    int run, i;
+
+    for (i = 0; i < 2; i++)
+    {
+        OPL3_Reset(&chips[i], rate);
+        polyphase_setup(&chips[i]);
+    }
+    OPL3_SetResampler(&chips[1], rate, quality);
+    if (chips[1].streamhook)
+    {
+        ((opl3_resampler *)chips[1].streamhook)->fir = func;
+    }
+    for (run = 0; run < OPL3_POLYPHASE_RUNS; run++)
+    {
+        for (i = 0; i < 2; i++)
+        {
+            ns = polyphase_time(&chips[i], buf, count, &acc);
+            if (run == 0 || ns < best[i])
+            {
+                best[i] = ns;
+            }
+        }
+    }
+    sink = acc;
+    OPL3_Release(&chips[0]);
+    OPL3_Release(&chips[1]);
+    *linear = best[0];
+    return best[1];
+}
+
+/* FIRだけの1サンプルあたりの時間(in[]は乱数で埋めたまま使い回す) */
+static double polyphase_fir(uint32_t rate, uint8_t quality, opl3_firfunc func)
+{
+    static int16_t buf[OPL_RESAMPLE_BLOCK * 2];
+    const unsigned long count = OPL3_POLYPHASE_SAMPLES * 4 / OPL3_POLYPHASE_RUNS;
+    opl3_resampler *rs = OPL3_ResampleCreate(rate, quality);
+    double ns, best = 0.0;
+    clock_t start;
+    unsigned long n;
+    uint32_t i, state = 1;
+    int32_t acc = 0;
+    int run;
+
+    if (!rs)
+    {
+        return 0.0;
+    }
+    rs->fir = func;
+    for (i = 0; i < rs->cap * 4; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        rs->in[0][i] = (float)(int16_t)state;
+    }
+    rs->avail = rs->cap;
+    for (run = 0; run < OPL3_POLYPHASE_RUNS; run++)
+    {
+        start = clock();
+        for (n = 0; n < count; n += OPL_RESAMPLE_BLOCK)
+        {
+            rs->pos = rs->half - 1;
+            OPL3_ResampleRun(rs, buf, 0, OPL_RESAMPLE_BLOCK);
+            acc += buf[0];
+        }
+        ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / n;
+        if (run == 0 || ns < best)
+        {
+            best = ns;
+        }
+    }
+    sink = acc;
+    OPL3_ResampleDestroy(rs);
+    return best;
+}
+
+int main(void)
+{
+    static const uint32_t rates[2] = { 44100, 48000 };
+    double linear, fir, stream;
+    uint32_t r;
+    uint8_t q;
+    size_t k;
+
+    printf("rate,quality,taps,kernel,fir_ns,stream_ns,linear_ns,stream_ratio\n");
+    for (r = 0; r < 2; r++)
+    {
+        for (q = OPL_RESAMPLE_LOW; q <= OPL_RESAMPLE_HIGH; q++)
+        {
+            for (k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+            {
+                if (!polyphase_supported(&kernels[k]))
+                {
+                    continue;
+                }
+                fir = polyphase_fir(rates[r], q, kernels[k].func);
+                stream = polyphase_stream(rates[r], q, kernels[k].func, &linear);
+                printf("%lu,%u,%u,%s,%.2f,%.2f,%.2f,%.2f\n", (unsigned long)rates[r], q,
+                       OPL3_ResampleTaps(rates[r], q), kernels[k].name,
+                       fir, stream, linear, stream / linear);
+            }
+        }
+    }
+    return 0;
+}
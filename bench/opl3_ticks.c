@@ -0,0 +1,111 @@
+/*
+ * Per-stage T-state measurement for Nuked-OPL3 on z88dk
+ *
+ * z88dk-ticksで各ステージのT-state数を測定するためのプログラムです。
+ * OPL3_TICKS_STAGEごとに別バイナリとしてビルドし、全バイナリで共通の
+ * 初期化(固定レジスタスクリプト+ウォームアップ)を行った後、
+ * 選択したステージだけをOPL3_TICKS_SAMPLESサンプル分実行します。
+ * ステージ0(空ループ)との差分が、そのステージのコストになります。
+ *
+ *   0: 基準(空ループ)
+ *   1: エンベロープ (OPL3_EnvelopeCalc x36 + OPL3_UpdateTimers)
+ *   2: 位相 (OPL3_PhaseGenerate x36)
+ *   3: スロット (OPL3_SlotCalcFB + OPL3_SlotGenerate x36)
+ *   4: 全体 (OPL3_Generate4Ch)
+ *   5: タイマー (OPL3_UpdateTimers、エンベロープの内数)
+ *
+ * ミックス(+クリップ、書き込みバッファ処理)は 4 - (1 + 2 + 3) で求めます。
+ * OPL3_PROFILE_OPL2のビルドではx36はx18(下位バンク)になります。
+ * 集計は bench/ticks.sh (make ticks) が行います。
+ */
+
+/* staticな内部関数を直接呼ぶため、実装をそのまま取り込む */
+#include "../src/opl3.c"
+
+#ifndef OPL3_TICKS_STAGE
+#define OPL3_TICKS_STAGE 4
+#endif
+
+#ifndef OPL3_TICKS_SAMPLES
+#define OPL3_TICKS_SAMPLES 32
+#endif
+
+#define OPL3_TICKS_WARMUP 64
+
+static opl3_chip chip;
+static int16_t buf4[4];
+static volatile int16_t sink;
+
+/* 固定レジスタスクリプト: OPL3モード、18チャンネルすべて2op発音 */
+static void ticks_setup(void)
+{
+    uint8_t ch, off, high, i;
+    uint16_t base;
+
+    OPL3_Reset(&chip, 49716);
+    OPL3_WriteReg(&chip, 0x105, 0x01);
+    OPL3_WriteReg(&chip, 0x104, 0x00);
+    OPL3_WriteReg(&chip, 0xbd, 0xc0);   /* AM/VIB深め */
+    for (ch = 0; ch < 18; ch++)
+    {
+        high = ch / 9;
+        i = ch % 9;
+        base = high ? 0x100 : 0x000;
+        off = (i / 3) * 8 + (i % 3);
+        OPL3_WriteReg(&chip, base + 0x20 + off, 0xe1);      /* AM, VIB, EGT, MULT=1 */
+        OPL3_WriteReg(&chip, base + 0x23 + off, 0x21);
+        OPL3_WriteReg(&chip, base + 0x40 + off, 0x10);
+        OPL3_WriteReg(&chip, base + 0x43 + off, 0x00);
+        OPL3_WriteReg(&chip, base + 0x60 + off, 0xf4);
+        OPL3_WriteReg(&chip, base + 0x63 + off, 0xf2);
+        OPL3_WriteReg(&chip, base + 0x80 + off, 0x55);
+        OPL3_WriteReg(&chip, base + 0x83 + off, 0x53);
+        OPL3_WriteReg(&chip, base + 0xe0 + off, ch & 0x03);
+        OPL3_WriteReg(&chip, base + 0xe3 + off, 0x00);
+        OPL3_WriteReg(&chip, base + 0xc0 + i, 0x3e);        /* FB=7, FM, L+R */
+        OPL3_WriteReg(&chip, base + 0xa0 + i, 0x98 + ch);
+        OPL3_WriteReg(&chip, base + 0xb0 + i, 0x31);        /* Key ON */
+    }
+}
+
+int main(void)
+{
+    uint16_t n;
+#if OPL3_TICKS_STAGE >= 1 && OPL3_TICKS_STAGE <= 3
+    uint8_t ii;
+#endif
+
+    ticks_setup();
+    for (n = 0; n < OPL3_TICKS_WARMUP; n++)
+    {
+        OPL3_Generate4Ch(&chip, buf4);
+    }
+
+    for (n = 0; n < OPL3_TICKS_SAMPLES; n++)
+    {
+#if OPL3_TICKS_STAGE == 1
+        for (ii = 0; ii < OPL_NUM_SLOTS; ii++)
+        {
+            OPL3_EnvelopeCalc(&chip, &chip.slot[ii]);
+        }
+        OPL3_UpdateTimers(&chip);
+#elif OPL3_TICKS_STAGE == 2
+        for (ii = 0; ii < OPL_NUM_SLOTS; ii++)
+        {
+            OPL3_PhaseGenerate(&chip, &chip.slot[ii]);
+        }
+#elif OPL3_TICKS_STAGE == 3
+        for (ii = 0; ii < OPL_NUM_SLOTS; ii++)
+        {
+            OPL3_SlotCalcFB(&chip, &chip.slot[ii]);
+            OPL3_SlotGenerate(&chip, &chip.slot[ii]);
+        }
+#elif OPL3_TICKS_STAGE == 4
+        OPL3_Generate4Ch(&chip, buf4);
+#elif OPL3_TICKS_STAGE == 5
+        OPL3_UpdateTimers(&chip);
+#endif
+    }
+    sink = buf4[0];
+    return 0;
+}
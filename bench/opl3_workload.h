@@ -0,0 +1,147 @@
+/*
+ * Benchmark workloads shared by the host and Z80 benchmarks
+ *
+ * bench/opl3_perf.c(ホスト)とbench/opl3_perf_ticks.c(z88dk-ticks)が
+ * 同じレジスタスクリプトで測るための負荷の定義です。書き込みは
+ * 呼び出し側の関数(移植版、元の実装、OPL3_WriteRegのどれでも)で行います。
+ *
+ *   0: silence    OPL3モードにしただけで発音なし
+ *   1: 2op18      18チャンネルすべて2op発音(AM/VIB有効)
+ *   2: 4op6+2op6  4op 6チャンネル + 2op 6チャンネル
+ *   3: rhythm     リズムモードで5音 + 2op 15チャンネル
+ *   4: stereoext  2op18にステレオ拡張のパンを付けたもの
+ *                 (OPL_ENABLE_STEREOEXT=1のビルドだけ)
+ *   5: traffic    2op18でPERF_TRAFFIC_STEPサンプルごとに4レジスタを書く
+ */
+
+#ifndef OPL3_WORKLOAD_H
+#define OPL3_WORKLOAD_H
+
+#include <stdint.h>
+
+#define PERF_SILENCE    0
+#define PERF_2OP18      1
+#define PERF_4OP        2
+#define PERF_RHYTHM     3
+#define PERF_STEREOEXT  4
+#define PERF_TRAFFIC    5
+#define PERF_WORKLOADS  6
+
+/* traffic: この間隔(サンプル)ごとにperf_trafficを呼ぶ */
+#define PERF_TRAFFIC_STEP 8
+
+typedef void (*perf_writefunc)(void *chip, uint16_t reg, uint8_t v);
+
+/* チャンネルchの2op音色(bench/opl3_ticks.cと同じ) */
+static void perf_voice(perf_writefunc write, void *chip, uint8_t ch)
+{
+    uint16_t base = ch >= 9 ? 0x100 : 0x000;
+    uint8_t i = ch % 9;
+    uint8_t off = (i / 3) * 8 + (i % 3);
+
+    write(chip, base + 0x20 + off, 0xe1);       /* AM, VIB, EGT, MULT=1 */
+    write(chip, base + 0x23 + off, 0x21);
+    write(chip, base + 0x40 + off, 0x10);
+    write(chip, base + 0x43 + off, 0x00);
+    write(chip, base + 0x60 + off, 0xf4);
+    write(chip, base + 0x63 + off, 0xf2);
+    write(chip, base + 0x80 + off, 0x55);
+    write(chip, base + 0x83 + off, 0x53);
+    write(chip, base + 0xe0 + off, ch & 0x03);
+    write(chip, base + 0xe3 + off, 0x00);
+    write(chip, base + 0xc0 + i, 0x3e);         /* FB=7, FM, L+R */
+    write(chip, base + 0xa0 + i, 0x98 + ch);
+}
+
+static void perf_keyon(perf_writefunc write, void *chip, uint8_t ch)
+{
+    write(chip, (ch >= 9 ? 0x100 : 0x000) + 0xb0 + ch % 9, 0x31);
+}
+
+/* リセット直後のチップにworkloadの音を鳴らす */
+static void perf_setup(perf_writefunc write, void *chip, uint8_t workload)
+{
+    uint8_t ch;
+
+    write(chip, 0x105, 0x01);
+    write(chip, 0x104, 0x00);
+    if (workload == PERF_SILENCE)
+    {
+        return;
+    }
+    write(chip, 0xbd, 0xc0);                    /* AM/VIB深め */
+    for (ch = 0; ch < 18; ch++)
+    {
+        perf_voice(write, chip, ch);
+    }
+    switch (workload)
+    {
+    case PERF_4OP:
+        /* 0-2と9-11が4op(後半の3-5と12-14のC0で接続を変える) */
+        write(chip, 0x104, 0x3f);
+        for (ch = 0; ch < 3; ch++)
+        {
+            write(chip, 0x0c3 + ch, 0x30 | ch);
+            write(chip, 0x1c3 + ch, 0x31 - ch % 2);
+        }
+        for (ch = 0; ch < 18; ch++)
+        {
+            if (ch % 9 < 3 || ch % 9 >= 6)
+            {
+                perf_keyon(write, chip, ch);
+            }
+        }
+        break;
+    case PERF_RHYTHM:
+        /* 6-8はリズム(キーオンはBDで行う) */
+        write(chip, 0xa6, 0x57);
+        write(chip, 0xb6, 0x09);
+        write(chip, 0xa7, 0x03);
+        write(chip, 0xb7, 0x0a);
+        write(chip, 0xa8, 0xc0);
+        write(chip, 0xb8, 0x05);
+        write(chip, 0xbd, 0xff);
+        for (ch = 0; ch < 18; ch++)
+        {
+            if (ch < 6 || ch >= 9)
+            {
+                perf_keyon(write, chip, ch);
+            }
+        }
+        break;
+    case PERF_STEREOEXT:
+        /* ステレオ拡張(0x105のビット1)と、チャンネルごとに違うパン */
+        write(chip, 0x105, 0x03);
+        for (ch = 0; ch < 18; ch++)
+        {
+            write(chip, (ch >= 9 ? 0x100 : 0x000) + 0xd0 + ch % 9, (uint8_t)(ch * 14));
+            perf_keyon(write, chip, ch);
+        }
+        break;
+    default:
+        for (ch = 0; ch < 18; ch++)
+        {
+            perf_keyon(write, chip, ch);
+        }
+        break;
+    }
+}
+
+/*
+ * traffic: step番目の書き込み。チャンネルを順に回して周波数、
+ * キーオン/オフ、キャリアの音量、フィードバックを書き換える。
+ */
+static void perf_traffic(perf_writefunc write, void *chip, uint16_t step)
+{
+    uint8_t ch = step % 18;
+    uint16_t base = ch >= 9 ? 0x100 : 0x000;
+    uint8_t i = ch % 9;
+    uint8_t off = (i / 3) * 8 + (i % 3);
+
+    write(chip, base + 0xa0 + i, (uint8_t)(step * 7));
+    write(chip, base + 0xb0 + i, (step / 18) & 1 ? 0x11 : 0x31);
+    write(chip, base + 0x43 + off, (uint8_t)(step & 0x1f));
+    write(chip, base + 0xc0 + i, 0x31 | ((step >> 3) & 0x0e));
+}
+
+#endif /* OPL3_WORKLOAD_H */
@@ -0,0 +1,55 @@
+#!/bin/sh
+#
+# z88dk-ticksによる負荷別のT-state測定
+#
+# 使い方: bench/perf.sh <build_dir> <samples> <zcc command...>
+#   例: bench/perf.sh build 32 zcc +test -compiler=sdcc -SO3 -Iinclude
+#
+# bench/opl3_perf_ticks.c を負荷ごとに、サンプル数0と<samples>
+# (PERF_TRAFFIC_STEP=8の倍数)でビルドして実行し、差分を
+# "workload,samples,total,tstates_per_sample" 形式のCSVで出力します。
+# stereoextはOPL_ENABLE_STEREOEXT=1でビルドします(OPL2専用では測りません)。
+
+set -e
+
+BUILD_DIR=$1
+SAMPLES=$2
+shift 2
+TICKS=${TICKS:-z88dk-ticks}
+DIR=$(dirname "$0")
+SRC="$DIR/opl3_perf_ticks.c $DIR/../src/opl3.c"
+# OPL2専用(-DOPL3_PROFILE_OPL2=1)のビルドではステレオ拡張の負荷を飛ばす
+OPL2=
+case " $* " in
+*" -DOPL3_PROFILE_OPL2=1 "*) OPL2=1 ;;
+esac
+
+run_workload() {
+    "$@" -I"$DIR" -DOPL3_PERF_WORKLOAD=$WORKLOAD -DOPL3_PERF_SAMPLES=$N $EXTRA \
+        -o "$BUILD_DIR/perf_${WORKLOAD}_$N.bin" $SRC $LIBS >/dev/null
+    # z88dk-ticksの出力の最後の数値が総T-state数
+    $TICKS "$BUILD_DIR/perf_${WORKLOAD}_$N.bin" | grep -o '[0-9][0-9]*' | tail -1
+}
+
+echo "workload,samples,total,tstates_per_sample"
+WORKLOAD=0
+for NAME in silence 2op18 4op6+2op6 rhythm stereoext traffic; do
+    EXTRA=
+    LIBS=
+    if [ "$NAME" = stereoext ]; then
+        if [ -n "$OPL2" ]; then
+            WORKLOAD=$((WORKLOAD + 1))
+            continue
+        fi
+        EXTRA=-DOPL_ENABLE_STEREOEXT=1
+        LIBS=-lm
+    fi
+    N=0
+    BASE=$(run_workload "$@")
+    N=$SAMPLES
+    TOTAL=$(run_workload "$@")
+    awk -v name="$NAME" -v n="$SAMPLES" -v t0="$BASE" -v t1="$TOTAL" 'BEGIN {
+        printf "%s,%d,%d,%.0f\n", name, n, t1 - t0, (t1 - t0) / n;
+    }'
+    WORKLOAD=$((WORKLOAD + 1))
+done
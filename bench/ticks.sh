@@ -0,0 +1,40 @@
+#!/bin/sh
+#
+# z88dk-ticksによるステージ別T-state測定
+#
+# 使い方: bench/ticks.sh <build_dir> <samples> <zcc command...>
+#   例: bench/ticks.sh build 32 zcc +test -compiler=sdcc -SO3 -Iinclude
+#
+# 各ステージのバイナリをビルドして実行し、1サンプルあたりの
+# T-state数を "stage,total,per_sample" 形式のCSVで出力します。
+
+set -e
+
+BUILD_DIR=$1
+SAMPLES=$2
+shift 2
+TICKS=${TICKS:-z88dk-ticks}
+SRC=$(dirname "$0")/opl3_ticks.c
+
+run_stage() {
+    "$@" -DOPL3_TICKS_STAGE=$STAGE -DOPL3_TICKS_SAMPLES=$SAMPLES \
+        -o "$BUILD_DIR/ticks_$STAGE.bin" "$SRC" >/dev/null
+    # z88dk-ticksの出力の最後の数値が総T-state数
+    $TICKS "$BUILD_DIR/ticks_$STAGE.bin" | grep -o '[0-9][0-9]*' | tail -1
+}
+
+for STAGE in 0 1 2 3 4 5; do
+    eval "T$STAGE=\$(run_stage \"\$@\")"
+done
+
+echo "stage,total,per_sample"
+awk -v n="$SAMPLES" -v t0="$T0" -v t1="$T1" -v t2="$T2" -v t3="$T3" -v t4="$T4" \
+    -v t5="$T5" 'BEGIN {
+    e = (t1 - t0) / n; p = (t2 - t0) / n; s = (t3 - t0) / n; f = (t4 - t0) / n;
+    printf "envelope,%d,%.0f\n", t1 - t0, e;
+    printf "phase,%d,%.0f\n", t2 - t0, p;
+    printf "slot,%d,%.0f\n", t3 - t0, s;
+    printf "mix,%d,%.0f\n", (t4 - t0) - (t1 - t0) - (t2 - t0) - (t3 - t0), f - e - p - s;
+    printf "total,%d,%.0f\n", t4 - t0, f;
+    printf "timers,%d,%.0f\n", t5 - t0, (t5 - t0) / n;
+}'
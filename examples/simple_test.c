@@ -59,6 +59,13 @@ int main(void) {
     
     /* チップを初期化 */
     printf("Initializing OPL3 chip...\n");
+#if OPL_BANKED == 2
+    /* 切り替える側をマッパーのセグメントへ読み込む(make msx-banked) */
+    if (!OPL3_BankLoad("OPL3BANK.BIN")) {
+        printf("OPL3BANK.BIN not found.\n");
+        return 1;
+    }
+#endif
     OPL3_Reset(&chip, 49716);  /* サンプリングレート 49716 Hz */
     printf("Chip initialized.\n\n");
     
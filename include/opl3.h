@@ -56,26 +56,232 @@ typedef struct {
 #include <stdint.h>
 #endif
 
+#ifndef OPL_ENABLE_STEREOEXT
+#define OPL_ENABLE_STEREOEXT 0
+#endif
+
+/*
+ * OPL2(YM3812)専用のビルドプロファイル
+ * 1: 下位バンクの9チャンネル、18スロットだけを持つ。上位バンク(0x100-0x1FF)
+ *    への書き込みは無視し、newm、4op(OPL3_ChannelSet4Op)、波形4-7、
+ *    chc/chdの出力(4チャンネル出力の後ろ2つは常に0)を含めない。
+ *    下位バンクだけの書き込み列では完全版とビット単位で同じ出力になる
+ * 0: OPL3の完全版(既定)
+ */
+#ifndef OPL3_PROFILE_OPL2
+#define OPL3_PROFILE_OPL2   0
+#endif
+#if OPL3_PROFILE_OPL2
+#if OPL_ENABLE_STEREOEXT
+#error "OPL3_PROFILE_OPL2 cannot be combined with OPL_ENABLE_STEREOEXT"
+#endif
+#define OPL_NUM_CHANNELS    9
+#define OPL_NUM_SLOTS       18
+#define OPL_NUM_WAVEFORMS   4
+#else
+#define OPL_NUM_CHANNELS    18
+#define OPL_NUM_SLOTS       36
+#define OPL_NUM_WAVEFORMS   8
+#endif
+
+/*
+ * バッファリング書き込みのキュー
+ * OPL_WRITEBUF_GROW == 0: チップ内の固定長配列(OPL_WRITEBUF_SIZEエントリ)
+ * OPL_WRITEBUF_GROW == 1: ヒープ上にOPL_WRITEBUF_SIZEから倍々で
+ *                         OPL_WRITEBUF_MAXまで伸ばす(OPL3_Release、
+ *                         またはOPL3_Resetのやり直しで解放)
+ */
+#ifndef OPL_WRITEBUF_GROW
+#ifdef __Z88DK__
+#define OPL_WRITEBUF_GROW   0
+#else
+#define OPL_WRITEBUF_GROW   1
+#endif
+#endif
+#ifndef OPL_WRITEBUF_SIZE
+#if OPL_WRITEBUF_GROW
+#define OPL_WRITEBUF_SIZE   64
+#else
+#define OPL_WRITEBUF_SIZE   16
+#endif
+#endif
+#ifndef OPL_WRITEBUF_MAX
+#define OPL_WRITEBUF_MAX    32768
+#endif
+#define OPL_WRITEBUF_DELAY  2
+
+/* OPL3_WriteRegBufferedの戻り値 */
+#define OPL_WRITEBUF_OK     0
+#define OPL_WRITEBUF_FULL   1   /* キューが一杯で書き込みは捨てられた */
+
+/*
+ * 波形テーブルのレイアウト
+ * 0: 64バイトの象限記述子(ROM向け), 1: 8x1024の展開済みテーブル(16KB)
+ */
+#ifndef OPL_WAVETAB_LARGE
+#ifdef __Z88DK__
+#define OPL_WAVETAB_LARGE   0
+#else
+#define OPL_WAVETAB_LARGE   1
+#endif
+#endif
+
+/*
+ * チャンネルミックスのSIMDカーネル(x86ホストのみ)
+ * 1: SSE2/AVX2とスカラーを実行時にCPUで選ぶ, 0: スカラーのみ(既定)
+ * make bench-mixでのスカラー版との差は数%から1割程度で、CPUによっては
+ * 遅くなるため既定では使わない。
+ * x86のGCC/Clang以外とステレオ拡張(パン係数の乗算)では指定しても0
+ */
+#ifndef OPL_MIX_SIMD
+#define OPL_MIX_SIMD        0
+#endif
+#if OPL_MIX_SIMD && (defined(__Z88DK__) || !defined(__GNUC__) || OPL_ENABLE_STEREOEXT \
+    || !(defined(__x86_64__) || defined(__i386__)))
+#undef OPL_MIX_SIMD
+#define OPL_MIX_SIMD        0
+#endif
+
+/*
+ * リサンプラーの補間
+ * 0: 元の実装と同じ除算つきの線形補間(ビット単位で一致)
+ * 1: 除算なしの固定小数点補間。重みはOPL3_Resetで求めた刻み幅から
+ *    加算だけで更新し、16x16bitの乗算2回とシフトで補間する。
+ *    元の補間との差は最大2LSB(PORTING.md参照)
+ */
+#ifndef OPL_RESAMPLE_FAST
+#ifdef __Z88DK__
+#define OPL_RESAMPLE_FAST   1
+#else
+#define OPL_RESAMPLE_FAST   0
+#endif
+#endif
+
+/*
+ * ストリーム生成の差し替え(ホスト)
+ * 1: chip->streamhookがあればOPL3_GenerateStream/OPL3_Generate4ChStreamを
+ *    それに任せる(src/opl3_resample.cのポリフェーズリサンプラーが使う)
+ * 0: 常に1サンプルずつの線形補間
+ */
+#ifndef OPL_STREAM_HOOK
+#ifdef __Z88DK__
+#define OPL_STREAM_HOOK     0
+#else
+#define OPL_STREAM_HOOK     1
+#endif
+#endif
+
+/*
+ * チップの状態の保存と復元(OPL3_SaveState/OPL3_LoadState)
+ * 1: 有効, 0: 含めない(z88dkではコードサイズを優先して既定で0)
+ */
+#ifndef OPL_SAVESTATE
+#ifdef __Z88DK__
+#define OPL_SAVESTATE       0
+#else
+#define OPL_SAVESTATE       1
+#endif
+#endif
+
+/*
+ * バンク切り替えメモリへの配置(z88dk、src/opl3_bank.h)
+ * 0: なし(既定)
+ * 1: ZX Spectrum 128K。切り替える側をRAMバンク(OPL_BANK_NUM、既定6)に置き、
+ *    ポート0x7FFDで0xC000-0xFFFFに出す
+ * 2: MSXのメモリマッパー。切り替える側をセグメント(OPL_BANK_NUM、既定は
+ *    OPL3_BankLoadが確保)に置き、ポート0xFEでページ2(0x8000-0xBFFF)に出す
+ * サンプル生成と毎サンプル引く表は常駐側、レジスタのデコードとリセット、
+ * 書き込み時だけ引く表は切り替える側に置きます。src/opl3.cを
+ * OPL_BANK_PART=1(常駐)と2(切り替える側)で2回コンパイルしてリンクします。
+ * 切り替えはOPL3_Resetと、ストリーム生成のブロックの出入り口だけです。
+ * OPL3_WriteRegはチップにOPL_BANK_PENDING個までためておき、次の生成の
+ * 先頭(ストリーム生成ならブロックの入り口の中)でまとめてデコードします。
+ * 一杯になった時だけその場で切り替えてデコードします。
+ */
+#ifndef OPL_BANKED
+#define OPL_BANKED          0
+#endif
+#ifndef OPL_BANK_PENDING
+#define OPL_BANK_PENDING    16
+#endif
+
+/*
+ * ステージ別のプロファイル(OPL3_GetProfile)
+ * 1: エンベロープ、位相、スロット、ミックス、タイマー、書き込みキューの
+ *    各ステージの時間と呼び出し回数をチップごとに積算する
+ * 0: 含めない(既定。構造体にもコードにも何も足さない)
+ *
+ * 時間の単位は時計によります。x86のGCC/clangはrdtsc(TSCのサイクル)、
+ * その他のホストはclock_gettime(CLOCK_MONOTONIC)のナノ秒、z88dkでは
+ * アプリケーションが用意するOPL3_ProfileClock()(フレームカウンタや
+ * CTCなど)の値です。OPL_PROFILE_CLOCKに関数名を定義すると差し替えられます。
+ */
+#ifndef OPL3_PROFILE
+#define OPL3_PROFILE        0
+#endif
+#if OPL3_PROFILE
+#ifndef OPL_PROFILE_TSC
+#if !defined(__Z88DK__) && defined(__GNUC__) && !defined(OPL_PROFILE_CLOCK) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define OPL_PROFILE_TSC     1
+#else
+#define OPL_PROFILE_TSC     0
+#endif
+#endif
+
+/* ステージ(opl3_profileの添字) */
+#define OPL_PROF_ENVELOPE   0   /* OPL3_EnvelopeCalc(休止スロットは数えない) */
+#define OPL_PROF_PHASE      1   /* OPL3_PhaseGenerate(休止スロットの符号出力を含む) */
+#define OPL_PROF_SLOT       2   /* OPL3_SlotCalcFB + OPL3_SlotGenerate */
+#define OPL_PROF_MIX        3   /* チャンネルミックス(1サンプルに2回) */
+#define OPL_PROF_TIMERS     4   /* OPL3_UpdateTimers */
+#define OPL_PROF_WRITEBUF   5   /* 書き込みキューの処理(時刻が来た時だけ) */
+#define OPL_PROF_TOTAL      6   /* OPL3_Generate4Ch全体(計測の手間を含む) */
+#define OPL_PROF_STAGES     7
+
+#ifdef __Z88DK__
+typedef uint32_t opl3_proftime;
+#ifndef OPL_PROFILE_CLOCK
+#define OPL_PROFILE_CLOCK   OPL3_ProfileClock
+uint32_t OPL3_ProfileClock(void);
+#endif
+#else
+typedef uint64_t opl3_proftime;
+#endif
+
+typedef struct _opl3_profile {
+    opl3_proftime ticks[OPL_PROF_STAGES];
+    opl3_proftime calls[OPL_PROF_STAGES];
+} opl3_profile;
+#endif
+
 /* OPL3チップの状態を保持する構造体 */
 typedef struct _opl3_slot opl3_slot;
 typedef struct _opl3_channel opl3_channel;
 typedef struct _opl3_chip opl3_chip;
 
+/*
+ * 信号配列 chip->sig のインデックス
+ * スロットの変調入力とチャンネルの出力は、ポインタではなく
+ * このインデックスで接続します。
+ */
+#define OPL_SIG_OUT     0                       /* +スロット番号: スロット出力 */
+#define OPL_SIG_FBMOD   OPL_NUM_SLOTS           /* +スロット番号: フィードバック入力 */
+#define OPL_SIG_ZERO    (2 * OPL_NUM_SLOTS)     /* 常に0 */
+#define OPL_SIG_NUM     (2 * OPL_NUM_SLOTS + 1)
+
 /* スロット(オペレータ)の状態 */
 struct _opl3_slot {
-    opl3_channel *channel;
-    opl3_chip *chip;
-    int16_t out;
-    int16_t fbmod;
-    int16_t *mod;
-    int16_t prout;
+    uint32_t pg_phase;
+    uint16_t pg_phase_out;
     uint16_t eg_rout;
     uint16_t eg_out;
-    uint8_t eg_inc;
+    int16_t prout;
+    uint8_t mod;        /* 変調入力(chip->sigのインデックス) */
     uint8_t eg_gen;
-    uint8_t eg_rate;
+    uint8_t eg_idle;    /* 休止中(キーオフかつ完全減衰)ならeg_outは未更新 */
     uint8_t eg_ksl;
-    uint8_t *trem;
+    uint8_t reg_am;     /* トレモロ有効なら0xff(chip->tremoloとのAND) */
     uint8_t reg_vib;
     uint8_t reg_type;
     uint8_t reg_ksr;
@@ -88,40 +294,81 @@ struct _opl3_slot {
     uint8_t reg_rr;
     uint8_t reg_wf;
     uint8_t key;
-    uint32_t pg_reset;
-    uint32_t pg_phase;
-    uint16_t pg_phase_out;
+    uint8_t pg_reset;
     uint8_t slot_num;
+    uint8_t ch_num;     /* 所属チャンネル */
 };
 
-/* チャンネルの状態 */
+/* チャンネルの状態(スロットとペアは番号から求める) */
 struct _opl3_channel {
-    opl3_slot *slots[2];
-    opl3_channel *pair;
-    opl3_chip *chip;
-    int16_t *out[4];
-    uint8_t chtype;
+#if OPL_ENABLE_STEREOEXT
+    int32_t leftpan;
+    int32_t rightpan;
+#endif
     uint16_t f_num;
+    uint16_t cha, chb;
+#if !OPL3_PROFILE_OPL2
+    uint16_t chc, chd;
+#endif
+    uint8_t out[4];     /* 出力(chip->sigのインデックス) */
+    uint8_t chtype;
     uint8_t block;
     uint8_t fb;
     uint8_t con;
     uint8_t alg;
     uint8_t ksv;
-    uint16_t cha, chb;
     uint8_t ch_num;
 };
 
-/* OPL3チップ全体の状態 */
+/*
+ * バッファリング書き込み
+ * 時刻は32bitのサンプル数(49716Hzで約24時間で一周)。
+ * 追加時の時刻は単調増加なので、キューは常に時刻順に並ぶ。
+ */
+typedef struct _opl3_writebuf {
+    uint32_t time;
+    uint16_t reg;
+    uint8_t data;
+} opl3_writebuf;
+
+#if OPL_STREAM_HOOK
+/*
+ * ストリーム生成のフック
+ * streamはnumsamples分の出力をsndptr1(と4チャンネル時のsndptr2)に書く。
+ * ステレオ生成ではsndptr2がNULL。OPL3_Releaseはreleaseを呼んでから
+ * chip->streamhookを外す。実装側はこの構造体を先頭に埋め込んで使う。
+ */
+typedef struct _opl3_streamhook opl3_streamhook;
+struct _opl3_streamhook {
+    void (*stream)(opl3_streamhook *hook, opl3_chip *chip,
+                   int16_t *sndptr1, int16_t *sndptr2, uint32_t numsamples);
+    void (*release)(opl3_streamhook *hook);
+};
+#endif
+
+/*
+ * OPL3チップ全体の状態
+ * 書き込みバッファを除いた大きさ(offsetof(opl3_chip, writebuf))は
+ * OPL_STATE_SIZE_MAX以下に収めます(src/opl3.cでコンパイル時に検査)。
+ */
+#define OPL_STATE_SIZE_MAX  2048
 struct _opl3_chip {
-    opl3_channel channel[18];
-    opl3_slot slot[36];
+    opl3_channel channel[OPL_NUM_CHANNELS];
+    opl3_slot slot[OPL_NUM_SLOTS];
     uint16_t timer;
-    uint64_t eg_timer;
+    /*
+     * エンベロープ用の36bitカウンタ(元の実装のuint64_t eg_timer)
+     * 下位16bitと上位20bitに分け、普段は16bitの加算だけで済ませる
+     */
+    uint16_t eg_timer;
+    uint32_t eg_timerhi;
     uint8_t eg_timerrem;
     uint8_t eg_state;
     uint8_t eg_add;
     uint8_t eg_timer_lo;
+#if !OPL3_PROFILE_OPL2
     uint8_t newm;
+#endif
     uint8_t nts;
     uint8_t rhy;
     uint8_t vibpos;
@@ -130,29 +377,76 @@ struct _opl3_chip {
     uint8_t tremolopos;
     uint8_t tremoloshift;
     uint32_t noise;
-    int16_t zeromod;
+    int16_t sig[OPL_SIG_NUM];
     int32_t mixbuff[4];
+#if OPL_MIX_SIMD
+    uint32_t mixmask[4];    /* cha/chb/chc/chdが有効なチャンネルのビット */
+#endif
     uint8_t rm_hh_bit2;
     uint8_t rm_hh_bit3;
     uint8_t rm_hh_bit7;
     uint8_t rm_hh_bit8;
     uint8_t rm_tc_bit3;
     uint8_t rm_tc_bit5;
+#if OPL_ENABLE_STEREOEXT
+    uint8_t stereoext;
+#endif
+    /* リズムモードの有無で選んだ生成カーネル(src/opl3_kernel.h) */
+    void (*generate)(opl3_chip *chip, int16_t *buf4);
     /* OPL3L */
     int32_t rateratio;
     int32_t samplecnt;
-    int16_t oldsamples[2];
-    int16_t samples[2];
+#if OPL_RESAMPLE_FAST
+    uint32_t rsm_w;             /* round(samplecnt * 2^15 / rateratio) */
+    uint32_t rsm_step;          /* 1出力サンプルあたりの重みの増分(整数部) */
+    uint16_t rsm_wrem;          /* 重みの端数(rateratio分の1単位) */
+    uint16_t rsm_steprem;       /* 増分の端数 */
+#endif
+    int16_t oldsamples[4];
+    int16_t samples[4];
+#if OPL_STREAM_HOOK
+    opl3_streamhook *streamhook;
+#endif
+
+    uint32_t writebuf_samplecnt;
+    uint32_t writebuf_lasttime;
+    uint32_t writebuf_next;     /* 先頭エントリの時刻(空なら0xffffffff) */
+    uint16_t writebuf_head;     /* 未処理エントリは[head, tail) */
+    uint16_t writebuf_tail;
+    uint16_t writebuf_overflow; /* OPL_WRITEBUF_FULLを返した回数 */
+#if OPL_WRITEBUF_GROW
+    uint16_t writebuf_size;
+    opl3_writebuf *writebuf;
+#else
+    opl3_writebuf writebuf[OPL_WRITEBUF_SIZE];
+#endif
+#if OPL_BANKED
+    uint8_t bank_pending;       /* ためているOPL3_WriteRegの数 */
+    uint8_t bank_data[OPL_BANK_PENDING];
+    uint16_t bank_reg[OPL_BANK_PENDING];
+#endif
+#if OPL3_PROFILE
+    opl3_profile profile;       /* OPL3_Resetで0になる */
+#endif
 };
 
 /* 関数プロトタイプ */
 
-/* チップの初期化とリセット */
+/*
+ * チップの初期化とリセット
+ * OPL3_Initは中身が不定のメモリ(スタック上やmallocしたもの)のチップに
+ * 最初に1回呼びます。OPL3_Resetはそれ以降(またはstaticやcallocで0の
+ * チップ)に何度でも呼べ、前のリセットから持っているヒープ(キューと
+ * ストリームフック)を解放してから初期化します。
+ */
+void OPL3_Init(opl3_chip *chip, uint32_t samplerate);
 void OPL3_Reset(opl3_chip *chip, uint32_t samplerate);
+/* 書き込みキューを空にしてヒープ(キューとストリームフック)を解放(破棄の前に呼ぶ) */
+void OPL3_Release(opl3_chip *chip);
 
 /* レジスタへの書き込み */
 void OPL3_WriteReg(opl3_chip *chip, uint16_t reg, uint8_t v);
-void OPL3_WriteRegBuffered(opl3_chip *chip, uint16_t reg, uint8_t v);
+uint8_t OPL3_WriteRegBuffered(opl3_chip *chip, uint16_t reg, uint8_t v);
 
 /* サンプル生成(複数フォーマット対応) */
 void OPL3_Generate(opl3_chip *chip, int16_t *buf);
@@ -161,6 +455,76 @@ void OPL3_GenerateResampled(opl3_chip *chip, int16_t *buf);
 /* ステレオストリーム生成 */
 void OPL3_GenerateStream(opl3_chip *chip, int16_t *sndptr, uint32_t numsamples);
 
+/* 4チャンネル出力(OPL3のDAC2系統を含む) */
+void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4);
+void OPL3_Generate4ChResampled(opl3_chip *chip, int16_t *buf4);
+void OPL3_Generate4ChStream(opl3_chip *chip, int16_t *sndptr1, int16_t *sndptr2, uint32_t numsamples);
+
+#if OPL_SAVESTATE
+/*
+ * 状態の保存と復元
+ * 書式はリトルエンディアンのバイト列で、構造体のレイアウトやポインタ幅に
+ * 依存しません。先頭に署名"OPL3"、版、構成(ステレオ拡張とOPL2専用の有無)、
+ * 書き込みキューの長さを持ち、チャンネルの接続(chip->sigのインデックス)も
+ * 値として含みます。ストリームフックは含まれません。
+ */
+#define OPL_STATE_VERSION   1
+
+/* OPL3_LoadStateの戻り値 */
+#define OPL_STATE_OK        0
+#define OPL_STATE_SHORT     1   /* データが途中で切れている */
+#define OPL_STATE_BADFORMAT 2   /* 署名、版、構成が違うか、値が範囲外 */
+#define OPL_STATE_FULL      3   /* 書き込みキューに入りきらない */
+
+/* 現在の状態の保存に必要なバイト数(書き込みキューの長さで変わる) */
+uint32_t OPL3_StateSize(const opl3_chip *chip);
+/*
+ * bufに保存して書いたバイト数を返す。sizeが足りなければ0。
+ * バンク版(OPL_BANKED)ではためているOPL3_WriteRegを先にデコードする
+ */
+uint32_t OPL3_SaveState(const opl3_chip *chip, uint8_t *buf, uint32_t size);
+/*
+ * OPL3_Resetしたチップに状態を復元します(サンプルレートも保存時のものに
+ * なります)。失敗した場合チップは変更されません。
+ */
+uint8_t OPL3_LoadState(opl3_chip *chip, const uint8_t *buf, uint32_t size);
+/*
+ * OPL3_LoadStateと同じ検査をし、書き込みキューの領域だけを確保します。
+ * OPL_STATE_OKなら、続くOPL3_LoadStateは同じbufで失敗しません。
+ * 複数のチップをまとめて復元する前に全部を確かめるのに使います。
+ */
+uint8_t OPL3_CheckState(opl3_chip *chip, const uint8_t *buf, uint32_t size);
+#endif
+
+#if OPL_BANKED == 2
+/*
+ * MSX: 切り替える側のセグメントを用意し、その内容(z88dkが出力する
+ * BANK_02の.bin)をpathから読み込みます。OPL3_Resetより前に1回呼びます。
+ * セグメントはMSX-DOS2ならマッパーサポートルーチンで確保し、なければ
+ * セグメント4(OPL_BANK_NUMを定義した場合はその番号)を使います。
+ * セグメントが確保できない、マッパーが小さくてTPAに折り返す、ファイルが
+ * 読めないか窓より大きい場合は0を返します
+ */
+uint8_t OPL3_BankLoad(const char *path);
+#endif
+
+#if OPL_BANKED
+/*
+ * 1サンプル単位の生成(OPL3_Generateなど)を続けて呼ぶ間、切り替える側を
+ * 出したままにします。間に挟んだ生成とデコードは切り替えません。
+ * 入れ子にでき、OPL3_BankEndで戻します。出している間は窓
+ * (Spectrum 128Kは0xC000-0xFFFF、MSXは0x8000-0xBFFF)の元の内容は見えません。
+ */
+void OPL3_BankBegin(void);
+void OPL3_BankEnd(void);
+#endif
+
+#if OPL3_PROFILE
+/* これまでの積算値をstatsに写す / 0に戻す */
+void OPL3_GetProfile(const opl3_chip *chip, opl3_profile *stats);
+void OPL3_ClearProfile(opl3_chip *chip);
+#endif
+
 /* z88dk最適化用のマクロ */
 #ifdef __Z88DK__
 /* インライン展開を積極的に行う(小さい関数のみ) */
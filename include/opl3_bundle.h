@@ -0,0 +1,50 @@
+/*
+ * Nuked OPL3 - cross-chip SIMD bundle (host only)
+ *
+ * OPL_BUNDLE_LANES個の独立したチップを、レーンごとに並べた配列
+ * (スロット x レーン)で持ち、1サンプルずつ全レーンをまとめて生成します。
+ * 分岐はレーンごとの選択に置き換えてあるので、コンパイラがAVX2/AVX-512の
+ * 1つのカーネルにベクトル化できます。z88dkビルドでは使用しません。
+ *
+ * 各レーンの出力は、同じ書き込みを与えたopl3_chipのOPL3_Generate4Chと
+ * ビット単位で一致します。生成はネイティブレート(49716Hz)だけです。
+ */
+
+#ifndef OPL3_BUNDLE_H
+#define OPL3_BUNDLE_H
+
+#include "opl3.h"
+
+/* レーン数(8: AVX2の32bit x 8, 16: AVX-512の32bit x 16) */
+#ifndef OPL_BUNDLE_LANES
+#define OPL_BUNDLE_LANES    8
+#endif
+
+/* カーネルの選択(-1: CPUに合わせて自動, 0: 汎用, 1: AVX2, 2: AVX-512) */
+#ifndef OPL_BUNDLE_ISA
+#define OPL_BUNDLE_ISA      -1
+#endif
+
+typedef struct _opl3_bundle opl3_bundle;
+
+/* 全レーンをリセットした状態で作成。失敗時はNULL */
+opl3_bundle *OPL3_BundleCreate(void);
+void OPL3_BundleDestroy(opl3_bundle *bundle);
+
+/* 1レーンだけをOPL3_Resetと同じ状態に戻す(他のレーンはそのまま) */
+void OPL3_BundleReset(opl3_bundle *bundle, uint8_t lane);
+
+/* レーンへのレジスタ書き込み(次に生成するサンプルから反映) */
+void OPL3_BundleWriteReg(opl3_bundle *bundle, uint8_t lane, uint16_t reg, uint8_t v);
+
+/* 全レーンを1サンプル進める。buf4[lane]はOPL3_Generate4Chと同じ4チャンネル */
+void OPL3_BundleGenerate4Ch(opl3_bundle *bundle, int16_t (*buf4)[4]);
+
+/*
+ * 全レーンをnumsamplesサンプル進め、sndptr[lane]にステレオで書き出す
+ * (OPL3_Generateをnumsamples回呼んだのと同じ)
+ */
+void OPL3_BundleGenerateStream(opl3_bundle *bundle, int16_t *const *sndptr,
+                               uint32_t numsamples);
+
+#endif /* OPL3_BUNDLE_H */
@@ -0,0 +1,87 @@
+/*
+ * Nuked OPL3 - checkpoint index for seeking (host only)
+ *
+ * レジスタログを一度最後まで生成しながら、一定のサンプル数ごとに
+ * チップの状態(OPL3_SaveState)と再生位置を記録し、サイドカーファイルに
+ * 書き出します。シークは目的の位置より前で最も近いチェックポイントを
+ * 復元し、残りだけを生成して捨てるので、かかる時間は曲の位置ではなく
+ * チェックポイントの間隔で決まります。z88dkビルドでは使用しません。
+ *
+ * VGMプレーヤー(opl3_vgm.h)とDRO/IMFのタイムライン(opl3_timeline.h)用の
+ * 作成とシークを用意しています。他の形式は再生位置をバイト列にして
+ * OPL3_IndexAdd/OPL3_IndexFindを直接使います。
+ *
+ * ストリームフックは先読みした履歴を持ち、状態に含まれないので、
+ * 付いたチップでは作成もシークもせずOPL_INDEX_HOOKEDを返します。
+ * OPL3_SetResamplerを使う場合は線形補間に戻してから使ってください。
+ */
+
+#ifndef OPL3_INDEX_H
+#define OPL3_INDEX_H
+
+#include <stddef.h>
+#include "opl3.h"
+#include "opl3_timeline.h"
+
+/* 戻り値 */
+#define OPL_INDEX_OK        0
+#define OPL_INDEX_NOMEM     1
+#define OPL_INDEX_IOERR     2   /* ファイルを読み書きできない */
+#define OPL_INDEX_BADFILE   3   /* 索引ファイルの形式が違うか壊れている */
+#define OPL_INDEX_STALE     4   /* 別のログ、レート、チップ数で作られた索引 */
+#define OPL_INDEX_NOTFOUND  5   /* 索引がないか、位置より前のチェックポイントがない */
+#define OPL_INDEX_HOOKED    6   /* ストリームフック(OPL3_SetResamplerなど)が付いている */
+
+#define OPL_INDEX_MAXCHIPS  4
+
+typedef struct _opl3_index opl3_index;
+
+/*
+ * ログの内容から索引の照合用のキーを作ります(FNV-1a)。ログが
+ * 書き換えられたら、古い索引はOPL3_IndexLoadでOPL_INDEX_STALEになります。
+ */
+uint32_t OPL3_IndexKey(const uint8_t *data, size_t size);
+
+/* 空の索引。intervalはチェックポイントの間隔(出力サンプル数、1以上) */
+opl3_index *OPL3_IndexCreate(uint8_t numchips, uint32_t samplerate, uint32_t interval,
+                             uint32_t key);
+void OPL3_IndexFree(opl3_index *index);
+
+/*
+ * 出力サンプル位置sampleのチェックポイントを追加します(sampleの昇順で)。
+ * posは呼び出し側の再生位置で、そのまま保存されます。
+ */
+uint8_t OPL3_IndexAdd(opl3_index *index, uint64_t sample, const uint8_t *pos,
+                      uint16_t poslen, opl3_chip *const *chips);
+
+uint8_t OPL3_IndexSave(const opl3_index *index, const char *path);
+
+/* numchips、samplerate、keyが作成時と違えばOPL_INDEX_STALE */
+uint8_t OPL3_IndexLoad(opl3_index **index, const char *path, uint8_t numchips,
+                       uint32_t samplerate, uint32_t key);
+
+/*
+ * sample以前で最も近いチェックポイントをchipsに復元し、その位置を
+ * *atに、再生位置を*posと*poslenに返します(posは索引の中を指します)。
+ * 全チップの状態を確かめてから復元するので、失敗したらどのチップも
+ * 変更されません。
+ */
+uint8_t OPL3_IndexFind(const opl3_index *index, uint64_t sample, opl3_chip *const *chips,
+                       uint64_t *at, const uint8_t **pos, uint16_t *poslen);
+
+uint32_t OPL3_IndexCount(const opl3_index *index);
+
+/*
+ * タイムラインを先頭から最後まで生成して索引を作り、pathに書き出します。
+ * chipはsamplerateでOPL3_Resetした直後のもので、終わると最後まで進んだ
+ * 状態になります。
+ */
+uint8_t OPL3_TimelineBuildIndex(const opl3_event *events, uint32_t numevents,
+                                opl3_chip *chip, uint32_t samplerate, uint32_t interval,
+                                uint32_t key, const char *path);
+
+/* tlとchipを、タイムラインの先頭からsampleサンプル進めた状態にします */
+uint8_t OPL3_TimelineSeek(opl3_timeline *tl, const opl3_event *events, uint32_t numevents,
+                          const opl3_index *index, opl3_chip *chip, uint64_t sample);
+
+#endif /* OPL3_INDEX_H */
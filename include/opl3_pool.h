@@ -0,0 +1,57 @@
+/*
+ * Nuked OPL3 - multi-chip render pool (host only)
+ *
+ * 多数の独立したopl3_chipを、固定数のワーカースレッドで1周期ずつ
+ * まとめて生成します。z88dkビルドでは使用しません。
+ *
+ * 各チップは配列上の位置で担当ワーカーが決まり、ワーカーは1つずつ
+ * CPUコアに固定されます。担当分を終えたワーカーは他のワーカーの担当分を
+ * 末尾から盗んで処理するので(ワークスティーリング)、負荷が偏った周期では
+ * 盗まれたチップだけ別のコアで処理されます。固定できたワーカーの数は
+ * OPL3_PoolPinnedで確かめられます。
+ */
+
+#ifndef OPL3_POOL_H
+#define OPL3_POOL_H
+
+#include "opl3.h"
+
+/* 周期内のレジスタ書き込み(timeは周期の先頭からのサンプル位置) */
+typedef struct {
+    uint32_t time;
+    uint16_t reg;
+    uint8_t data;
+} opl3_poolwrite;
+
+/*
+ * 1チップ分の仕事
+ * writesはtime順に並べておきます。time >= numsamples の書き込みは
+ * 周期の最後に適用されます。出力はステレオでnumsamples x 2個です。
+ */
+typedef struct {
+    opl3_chip *chip;
+    const opl3_poolwrite *writes;
+    uint32_t numwrites;
+    int16_t *sndptr;
+} opl3_pooljob;
+
+typedef struct _opl3_pool opl3_pool;
+
+/* numworkersが0ならオンラインのCPU数。失敗時はNULL */
+opl3_pool *OPL3_PoolCreate(uint32_t numworkers);
+void OPL3_PoolDestroy(opl3_pool *pool);
+
+/*
+ * CPUコアに固定できたワーカーの数。固定はLinuxだけで、失敗した
+ * ワーカー(cgroupで使えないCPUなど)は固定なしで動きます。
+ */
+uint32_t OPL3_PoolPinned(const opl3_pool *pool);
+
+/*
+ * すべてのjobsをOPL3_GenerateStreamでnumsamplesサンプル分生成し、
+ * 完了するまで待ちます。結果はチップごとに逐次生成した場合と同じです。
+ */
+void OPL3_PoolRender(opl3_pool *pool, opl3_pooljob *jobs, uint32_t numjobs,
+                     uint32_t numsamples);
+
+#endif /* OPL3_POOL_H */
@@ -0,0 +1,49 @@
+/*
+ * Nuked OPL3 - lock-free register write queue (host only)
+ *
+ * 制御スレッド(ゲームのメインループなど)が時刻付きのレジスタ書き込みを
+ * 積み、オーディオスレッドがOPL3_QueueRenderの中でその時刻のサンプルの
+ * 直前に適用します。書き込む側と生成する側がそれぞれ1スレッドの
+ * リングバッファ(SPSC)で、どちらの側もロックもシステムコールも使わず、
+ * 待つこともありません。z88dkビルドでは使用しません。
+ *
+ * 時刻はOPL3_Resetしたレートの出力サンプル数で、キューを作ってから
+ * 生成した通算の位置です。生成する側はOPL3_QueueNowで今の位置を公開
+ * するので、書き込む側は「今 + 遅延」を時刻にして積みます。
+ */
+
+#ifndef OPL3_QUEUE_H
+#define OPL3_QUEUE_H
+
+#include "opl3.h"
+
+typedef struct _opl3_queue opl3_queue;
+
+/*
+ * chipに書き込むキューを作ります。capacityは積んでおける書き込みの数で、
+ * 2のべき乗に切り上げます。chipはOPL3_Reset済みで、以後chipへの書き込みと
+ * 生成はこのキューを通して行います。失敗時はNULL
+ */
+opl3_queue *OPL3_QueueCreate(opl3_chip *chip, uint32_t capacity);
+void OPL3_QueueDestroy(opl3_queue *queue);
+
+/*
+ * 書き込む側: timeのサンプルの直前にregへdataを書き込む予約を積みます。
+ * キューが一杯なら何もせず0を返します。timeは積む順に減らないように
+ * してください(前の書き込みより早い時刻は、前の書き込みと同じ位置で
+ * 適用されます)。すでに生成した位置より前の時刻は、次の
+ * OPL3_QueueRenderの先頭で適用されます。
+ */
+uint8_t OPL3_QueuePush(opl3_queue *queue, uint64_t time, uint16_t reg, uint8_t data);
+
+/* 書き込む側: 生成する側が最後に公開した位置(次に生成するサンプルの時刻) */
+uint64_t OPL3_QueueNow(const opl3_queue *queue);
+
+/*
+ * 生成する側: numsamples分をステレオで生成します。呼び出した時点で
+ * 積まれている書き込みは、その時刻のサンプルの直前にOPL3_WriteRegで
+ * 適用します。numsamplesが0なら、今の位置までの書き込みだけを適用します。
+ */
+void OPL3_QueueRender(opl3_queue *queue, int16_t *sndptr, uint32_t numsamples);
+
+#endif /* OPL3_QUEUE_H */
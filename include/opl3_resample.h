@@ -0,0 +1,63 @@
+/*
+ * Nuked OPL3 - block polyphase resampler (host only)
+ *
+ * ネイティブレート(49716Hz)の出力をブロック単位で生成し、窓付きsincの
+ * ポリフェーズFIRで任意の出力レートに変換します。OPL3_GenerateStreamと
+ * OPL3_Generate4ChStreamの後ろに差し込まれるので、呼び出し側は
+ * OPL3_SetResampler以外を変える必要はありません。z88dkビルドでは
+ * 使用しません。
+ *
+ * FIRは位相を128分割した係数表を持ち、隣の位相との間を線形補間します。
+ * 積和はSSE2/AVX2+FMAのカーネルを実行時にCPUで選びます。
+ */
+
+#ifndef OPL3_RESAMPLE_H
+#define OPL3_RESAMPLE_H
+
+#include "opl3.h"
+
+/*
+ * 品質プリセット(タップ数、通過域の端、カイザー窓のβ)
+ * タップ数が多いほど遷移帯が狭く折り返しが減り、そのぶん遅くなる。
+ * タップ数は出力レート換算で、ダウンサンプル時はレートの比に応じて
+ * 増やす(44100Hzでは16/24/40、11025Hzでは40/80/152タップ)。
+ */
+#define OPL_RESAMPLE_LINEAR 0   /* 1サンプルずつの線形補間(元の実装と同じ) */
+#define OPL_RESAMPLE_LOW    1   /* 8タップ(通過域は出力ナイキストの0.80倍まで) */
+#define OPL_RESAMPLE_MEDIUM 2   /* 16タップ(0.88倍) */
+#define OPL_RESAMPLE_HIGH   3   /* 32タップ(0.93倍) */
+
+/* OPL3_SetResamplerの戻り値 */
+#define OPL_RESAMPLE_OK     0
+#define OPL_RESAMPLE_NOMEM  1   /* 確保に失敗し、線形補間のまま */
+#define OPL_RESAMPLE_BADARG 2   /* 不明なプリセットか出力レートが低すぎる */
+
+#define OPL_RESAMPLE_MINRATE 4000
+
+/* 出力ブロックの最大長(この単位でネイティブレートの生成とFIRを回す) */
+#ifndef OPL_RESAMPLE_BLOCK
+#define OPL_RESAMPLE_BLOCK  1024
+#endif
+
+/* FIRのSIMDカーネル(x86ホストのみ、0ならスカラーのみ) */
+#ifndef OPL_RESAMPLE_SIMD
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OPL_RESAMPLE_SIMD   1
+#else
+#define OPL_RESAMPLE_SIMD   0
+#endif
+#endif
+
+/*
+ * チップのストリーム生成をsamplerateへのポリフェーズ変換に切り替えます。
+ * OPL3_Resetの後で呼びます。qualityがOPL_RESAMPLE_LINEARなら元の
+ * 線形補間に戻します。切り替えるとフィルタの履歴は無音から始まり、
+ * 出力はネイティブレートで(タップ数/2)サンプル分遅れます。
+ *
+ * 1サンプル単位のOPL3_GenerateResampled/OPL3_Generate4ChResampledは
+ * 常に線形補間で、ストリーム生成と混ぜて使うことはできません。
+ * 確保したメモリはOPL3_Releaseで解放されます。
+ */
+uint8_t OPL3_SetResampler(opl3_chip *chip, uint32_t samplerate, uint8_t quality);
+
+#endif /* OPL3_RESAMPLE_H */
@@ -0,0 +1,102 @@
+/*
+ * Nuked OPL3 - precomputed event timeline (DRO v2 / IMF)
+ *
+ * DOSBoxのDRO v2とid SoftwareのIMFを一度だけデコードし、出力サンプル単位の
+ * 待ちとレジスタ書き込みを時刻順に並べた配列(タイムライン)にします。
+ * 再生はOPL3_TimelineRenderが待ちの長さ分をOPL3_GenerateStreamの1回の
+ * 呼び出しで生成し、次の書き込みをOPL3_WriteRegで与えるだけです。
+ *
+ * イベントは4バイト固定で、時刻は前のイベントからの差分(16bit)なので、
+ * 再生側には32bitの時刻比較も除算もありません。Z80でも同じ配列を
+ * そのまま再生できます(z88dkビルドにはデコーダは入りません)。
+ */
+
+#ifndef OPL3_TIMELINE_H
+#define OPL3_TIMELINE_H
+
+#include "opl3.h"
+
+/*
+ * デコーダを含める(ホストのみ)
+ * 0: OPL3_TimelineStart/OPL3_TimelineRenderだけ(mallocを使わない)
+ */
+#ifndef OPL_TIMELINE_DECODE
+#ifdef __Z88DK__
+#define OPL_TIMELINE_DECODE 0
+#else
+#define OPL_TIMELINE_DECODE 1
+#endif
+#endif
+
+/*
+ * 1イベント(リトルエンディアンで wait, reg, val の順の4バイト)
+ * waitの下位15bitは直前のイベントからのサンプル数、bit15はレジスタの
+ * bit8(0x1xx)。15bitを超える待ちは、間にレジスタ0x000(何もしない)への
+ * 書き込みを挟んで分割します。最後のイベントは曲の終わりの待ちを持つ
+ * 0x000への書き込みです。
+ */
+typedef struct {
+    uint16_t wait;
+    uint8_t reg;
+    uint8_t val;
+} opl3_event;
+
+#define OPL_EVENT_HIGH      0x8000
+#define OPL_EVENT_MAXWAIT   0x7fff
+
+/* 再生位置 */
+typedef struct {
+    const opl3_event *cur;      /* 次に書き込むイベント */
+    const opl3_event *end;
+    uint16_t remain;            /* curの前に残っている待ち */
+} opl3_timeline;
+
+void OPL3_TimelineStart(opl3_timeline *tl, const opl3_event *events, uint32_t numevents);
+
+/*
+ * numsamples分をOPL3_Resetしたレートのステレオで生成します。
+ * 戻り値は生成したサンプル数で、曲の終わりではnumsamplesより少なく、
+ * その後は0になります。
+ */
+uint32_t OPL3_TimelineRender(opl3_timeline *tl, opl3_chip *chip, int16_t *sndptr,
+                             uint32_t numsamples);
+
+#if OPL_TIMELINE_DECODE
+
+#include <stddef.h>
+
+/* デコーダの戻り値 */
+#define OPL_TIMELINE_OK     0
+#define OPL_TIMELINE_NOMEM  1
+#define OPL_TIMELINE_BADFILE 2  /* 形式が違うか壊れている */
+
+/* IMFの再生レート(Hz) */
+#define OPL_IMF_RATE_DUKE2  280
+#define OPL_IMF_RATE_KEEN   560
+#define OPL_IMF_RATE_WOLF   700
+
+/*
+ * DRO v2(DOSBoxの"DBRAWOPL" 2.0)をsamplerateのタイムラインにします。
+ * コードマップでレジスタ番号を戻し、短い/長い待ちのコード(ミリ秒)を
+ * 時刻に積み上げます。デュアルOPL2の2チップ目はOPL3の0x1xxに割り当てます。
+ * 成功すると*eventsにmallocした配列を返すので、OPL3_TimelineFreeで
+ * 解放します。
+ */
+uint8_t OPL3_TimelineFromDro(const uint8_t *data, size_t size, uint32_t samplerate,
+                             opl3_event **events, uint32_t *numevents);
+
+/*
+ * IMF(reg, val, 16bitの待ち の4バイト単位)をタイムラインにします。
+ * 先頭の16bitが0でなくデータ長として収まればタイプ1(長さ付き、後ろの
+ * タグは無視)、それ以外はファイル全体がデータのタイプ0とみなします。
+ * imfrateは待ちの単位(OPL_IMF_RATE_*)です。
+ */
+uint8_t OPL3_TimelineFromImf(const uint8_t *data, size_t size, uint32_t imfrate,
+                             uint32_t samplerate, opl3_event **events,
+                             uint32_t *numevents);
+
+void OPL3_TimelineFree(opl3_event *events);
+
+#endif
+
+#endif /* OPL3_TIMELINE_H */
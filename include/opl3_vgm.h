@@ -0,0 +1,74 @@
+/*
+ * Nuked OPL3 - memory-mapped VGM player (host only)
+ *
+ * VGMファイルをmmapし、コマンドをその場で読みながらopl3_chipに
+ * レジスタ書き込みを与えます。コマンドはコピーもデコードもしません。
+ * 待ち(0x61-0x63, 0x70-0x7F)から次の待ちまでの書き込みを適用した後、
+ * 待ちの長さ分をOPL3_GenerateStreamの1回の呼び出しで生成します
+ * (呼び出し側のバッファの切れ目では分割されます)。
+ *
+ * 対応するのはYMF262のコマンド(0x5E/0x5F、2チップ目は0xAE/0xAF)です。
+ * ヘッダのYMF262クロックのbit30が立っていれば2チップ構成で、それぞれを
+ * 別のopl3_chipに割り当てます。他のチップのコマンドとデータブロックは
+ * 読み飛ばします。gzip圧縮された.vgzは扱いません。z88dkビルドでは
+ * 使用しません。
+ */
+
+#ifndef OPL3_VGM_H
+#define OPL3_VGM_H
+
+#include "opl3.h"
+
+/* VGMの時刻の単位 */
+#define OPL_VGM_RATE        44100
+
+/* OPL3_VgmOpenのflags */
+#define OPL_VGM_BUFFERED    0x01    /* OPL3_WriteRegBufferedで書き込む */
+
+typedef struct {
+    uint32_t version;       /* BCD(0x00000151 = 1.51) */
+    uint32_t clock;         /* YMF262のクロック(Hz、bit30/31を除いた値) */
+    uint32_t total_samples; /* 全体の長さ(44100Hz単位、ループ1回分を含む) */
+    uint32_t loop_samples;  /* ループ部分の長さ(ループがなければ0) */
+    uint8_t numchips;       /* 1か2 */
+} opl3_vgminfo;
+
+typedef struct _opl3_vgm opl3_vgm;
+
+/*
+ * pathのVGMファイルを開きます。出力はsamplerate(チップをOPL3_Resetした
+ * レート)のステレオです。YMF262を含まないファイルや壊れたヘッダでは
+ * NULLを返します。
+ */
+opl3_vgm *OPL3_VgmOpen(const char *path, uint32_t samplerate, uint8_t flags);
+void OPL3_VgmClose(opl3_vgm *vgm);
+const opl3_vgminfo *OPL3_VgmInfo(const opl3_vgm *vgm);
+
+/* ループの回数(既定は0: 終端で止まる、0xffffなら無限) */
+void OPL3_VgmSetLoops(opl3_vgm *vgm, uint16_t loops);
+
+/*
+ * numsamples分を生成します。chipsとsndptrはnumchips個で、チップごとに
+ * 別のステレオバッファに書きます(混ぜるのは呼び出し側)。
+ * 戻り値は生成したサンプル数で、曲の終わりではnumsamplesより少なく、
+ * その後は0になります。
+ */
+uint32_t OPL3_VgmRender(opl3_vgm *vgm, opl3_chip *const *chips, int16_t *const *sndptr,
+                        uint32_t numsamples);
+
+/*
+ * シーク用の索引(opl3_index.h、戻り値はOPL_INDEX_*)
+ * OPL3_VgmBuildIndexは開いた直後のvgmとOPL3_Resetした直後のchipsで曲を
+ * 最後まで(OPL3_VgmSetLoopsのループ回数で)生成し、interval出力サンプル
+ * ごとのチェックポイントをpathに書き出します。終わると先頭に戻り、索引は
+ * そのままOPL3_VgmSeekで使えます。OPL3_VgmLoadIndexは同じファイル、
+ * レート、ループ回数で作った索引を読み込みます。
+ * OPL3_VgmSeekは先頭からsampleサンプルの位置に移り、チェックポイントから
+ * 最大interval分だけを生成します。
+ */
+uint8_t OPL3_VgmBuildIndex(opl3_vgm *vgm, opl3_chip *const *chips, uint32_t interval,
+                           const char *path);
+uint8_t OPL3_VgmLoadIndex(opl3_vgm *vgm, const char *path);
+uint8_t OPL3_VgmSeek(opl3_vgm *vgm, opl3_chip *const *chips, uint64_t sample);
+
+#endif /* OPL3_VGM_H */
@@ -5,14 +5,36 @@
  * オリジナル: https://github.com/nukeykt/Nuked-OPL3
  */
 
+/* OPL3_PROFILEの時計(clock_gettime)を-std=c99でも使う */
+#if defined(OPL3_PROFILE) && OPL3_PROFILE && !defined(__Z88DK__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "opl3.h"
-#include "opl3_int64.h"
+#include "opl3_bank.h"
 
 #ifdef __Z88DK__
 /* z88dk特有のインクルード */
 #include <string.h>
+#include <stddef.h>
 #else
 #include <string.h>
+#include <stddef.h>
+#endif
+#if OPL_WRITEBUF_GROW
+#include <stdlib.h>
+#endif
+#if OPL_BANKED == 2
+#include <stdio.h>
+#endif
+#if OPL_BANKED == 2 || (OPL_BANKED == 1 && !defined(OPL_BANK_MAP))
+#include <intrinsic.h>
+#endif
+#if OPL_MIX_SIMD
+#if OPL3_PROFILE_OPL2
+#error "OPL_MIX_SIMD requires the full OPL3 engine (OPL3_PROFILE_OPL2 == 0)"
+#endif
+#include <immintrin.h>
 #endif
 
 #if OPL_ENABLE_STEREOEXT && !defined OPL_SIN
@@ -29,7 +51,28 @@
 #define OPL_QUIRK_CHANNELSAMPLEDELAY (!OPL_ENABLE_STEREOEXT)
 #endif
 
+#if OPL3_PROFILE && !defined(OPL_PROFILE_CLOCK)
+#if OPL_PROFILE_TSC
+#include <x86intrin.h>
+#define OPL_PROFILE_CLOCK   __rdtsc
+#else
+#include <time.h>
+static opl3_proftime OPL3_ProfileNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (opl3_proftime)ts.tv_sec * 1000000000u + (opl3_proftime)ts.tv_nsec;
+}
+#define OPL_PROFILE_CLOCK   OPL3_ProfileNow
+#endif
+#endif
+
 #define RSM_FRAC    10
+#define RSM_WBITS   15      /* OPL_RESAMPLE_FAST: 補間の重みの小数部 */
+
+/* 書き込みバッファを除いた状態サイズの検査(超えると配列サイズが負になる) */
+typedef char opl3_state_size_check[(offsetof(opl3_chip, writebuf) <= OPL_STATE_SIZE_MAX) ? 1 : -1];
 
 
 /*
@@ -37,6 +80,7 @@
  * これらはROMに配置されるべき定数データです
  */
 
+#if OPL_PART_RESIDENT
 /* 対数サインテーブル(0-255の位相に対応) */
 OPL3_CONST uint16_t logsinrom[256] = {
     0x859, 0x6c3, 0x607, 0x58b, 0x52e, 0x4e4, 0x4a6, 0x471,
@@ -117,13 +161,17 @@ OPL3_CONST uint16_t exprom[256] = {
 OPL3_CONST uint8_t mt[16] = {
     1, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 20, 24, 24, 30, 30
 };
+#endif
 
 /*
     ksl table
 */
+#if OPL_PART_PAGED
 OPL3_CONST uint8_t kslrom[16] = {
     0, 32, 40, 45, 48, 51, 53, 55, 56, 58, 59, 60, 61, 62, 63, 64
 };
+#endif
+#if OPL_PART_RESIDENT
 OPL3_CONST uint8_t kslshift[4] = {
     8, 1, 2, 0
 };
@@ -136,17 +184,31 @@ OPL3_CONST uint8_t eg_incstep[4][4] = {
     { 1, 1, 1, 0 }
 };
 
-/* マルチプレクサテーブル */
-OPL3_CONST uint8_t mt[16] = {
-    1, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 20, 24, 24, 30, 30
-};
-
-/* KSLテーブル */
-OPL3_CONST uint8_t kslrom[16] = {
-    0, 32, 40, 45, 48, 51, 53, 55, 56, 58, 59, 60, 61, 62, 63, 64
+/*
+ * eg_addの下位ビット探索テーブル
+ * eg_addtab[i] = (iの最下位の1のビット位置) + 1、eg_addtab[0] = 0
+ */
+OPL3_CONST uint8_t eg_addtab[256] = {
+    0, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    5, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    6, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    5, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    7, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    5, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    6, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    5, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    8, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    5, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    6, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    5, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    7, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    5, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    6, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
+    5, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1
 };
+#endif
 
-#if OPL_ENABLE_STEREOEXT
+#if OPL_ENABLE_STEREOEXT && OPL_PART_PAGED
 /*
     stereo extension panning table
 */
@@ -158,6 +220,7 @@ static uint8_t panpot_lut_build = 0;
 /*
     address decoding
 */
+#if OPL_PART_PAGED
 OPL3_CONST int8_t ad_slot[0x20] = {
     0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9, 10, 11, -1, -1,
     12, 13, 14, 15, 16, 17, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
@@ -166,6 +229,7 @@ OPL3_CONST int8_t ad_slot[0x20] = {
 OPL3_CONST uint8_t ch_slot[18] = {
     0, 1, 2, 6, 7, 8, 12, 13, 14, 18, 19, 20, 24, 25, 26, 30, 31, 32
 };
+#endif
 
 
 /* 
@@ -176,7 +240,7 @@ OPL3_CONST uint8_t ch_slot[18] = {
     Envelope generator
 */
 
-typedef int16_t(*envelope_sinfunc)(uint16_t phase, uint16_t envelope);
+#if OPL_PART_RESIDENT
 typedef void(*envelope_genfunc)(opl3_slot *slott);
 
 static int16_t OPL3_EnvelopeCalcExp(uint32_t level)
@@ -188,153 +252,112 @@ static int16_t OPL3_EnvelopeCalcExp(uint32_t level)
     return (exprom[level & 0xffu] << 1) >> (level >> 8);
 }
 
-static int16_t OPL3_EnvelopeCalcSin0(uint16_t phase, uint16_t envelope)
-{
-    uint16_t out = 0;
-    uint16_t neg = 0;
-    phase &= 0x3ff;
-    if (phase & 0x200)
-    {
-        neg = 0xffff;
-    }
-    if (phase & 0x100)
-    {
-        out = logsinrom[(phase & 0xffu) ^ 0xffu];
-    }
-    else
-    {
-        out = logsinrom[phase & 0xffu];
-    }
-    return OPL3_EnvelopeCalcExp(out + (envelope << 3)) ^ neg;
-}
+/*
+ * 波形テーブル
+ *
+ * 8種類の波形の象限判定と符号をテーブルにまとめ、関数ポインタ経由の
+ * 呼び出しをなくしています。どちらのレイアウトでも、位相から
+ * logsinromの減衰量と符号を引き、OPL3_EnvelopeCalcExpに渡します。
+ *
+ * OPL_WAVETAB_LARGE == 0 (Z80):
+ *   波形ごとに位相の上位3bit(8分割)で引く64バイトの記述子
+ *   (OPL3_PROFILE_OPL2では波形0-3の32バイト)
+ *   bit0: 位相の下位8bitを反転, bit1: 1bit左シフト(波形4/5)
+ *   bit2-3: 0=logsinrom, 1=無音, 2=減衰0(波形6), 3=線形(波形7)
+ *   bit7: 符号反転
+ * OPL_WAVETAB_LARGE == 1 (ホスト):
+ *   8x1024エントリを展開した表(src/opl3_wavetab.h)
+ */
 
-static int16_t OPL3_EnvelopeCalcSin1(uint16_t phase, uint16_t envelope)
-{
-    uint16_t out = 0;
-    phase &= 0x3ff;
-    if (phase & 0x200)
-    {
-        out = 0x1000;
-    }
-    else if (phase & 0x100)
-    {
-        out = logsinrom[(phase & 0xffu) ^ 0xffu];
-    }
-    else
-    {
-        out = logsinrom[phase & 0xffu];
-    }
-    return OPL3_EnvelopeCalcExp(out + (envelope << 3));
-}
+#if OPL_WAVETAB_LARGE
 
-static int16_t OPL3_EnvelopeCalcSin2(uint16_t phase, uint16_t envelope)
-{
-    uint16_t out = 0;
-    phase &= 0x3ff;
-    if (phase & 0x100)
-    {
-        out = logsinrom[(phase & 0xffu) ^ 0xffu];
-    }
-    else
-    {
-        out = logsinrom[phase & 0xffu];
-    }
-    return OPL3_EnvelopeCalcExp(out + (envelope << 3));
-}
+#include "opl3_wavetab.h"
 
-static int16_t OPL3_EnvelopeCalcSin3(uint16_t phase, uint16_t envelope)
+static int16_t OPL3_WaveCalc(uint8_t wf, uint16_t phase, uint16_t envelope)
 {
-    uint16_t out = 0;
-    phase &= 0x3ff;
-    if (phase & 0x100)
-    {
-        out = 0x1000;
-    }
-    else
-    {
-        out = logsinrom[phase & 0xffu];
-    }
-    return OPL3_EnvelopeCalcExp(out + (envelope << 3));
+    uint16_t wave = opl3_wavetab[wf][phase & 0x3ff];
+    uint16_t neg = 0u - (wave >> 15);
+    return OPL3_EnvelopeCalcExp((wave & 0x1fff) + (envelope << 3)) ^ neg;
 }
 
-static int16_t OPL3_EnvelopeCalcSin4(uint16_t phase, uint16_t envelope)
+static int16_t OPL3_WaveSign(uint8_t wf, uint16_t phase)
 {
-    uint16_t out = 0;
-    uint16_t neg = 0;
-    phase &= 0x3ff;
-    if ((phase & 0x300) == 0x100)
-    {
-        neg = 0xffff;
-    }
-    if (phase & 0x200)
-    {
-        out = 0x1000;
-    }
-    else if (phase & 0x80)
-    {
-        out = logsinrom[((phase ^ 0xffu) << 1u) & 0xffu];
-    }
-    else
-    {
-        out = logsinrom[(phase << 1u) & 0xffu];
-    }
-    return OPL3_EnvelopeCalcExp(out + (envelope << 3)) ^ neg;
+    return (int16_t)(0u - (opl3_wavetab[wf][phase & 0x3ff] >> 15));
 }
 
-static int16_t OPL3_EnvelopeCalcSin5(uint16_t phase, uint16_t envelope)
-{
-    uint16_t out = 0;
-    phase &= 0x3ff;
-    if (phase & 0x200)
-    {
-        out = 0x1000;
-    }
-    else if (phase & 0x80)
-    {
-        out = logsinrom[((phase ^ 0xffu) << 1u) & 0xffu];
-    }
-    else
-    {
-        out = logsinrom[(phase << 1u) & 0xffu];
-    }
-    return OPL3_EnvelopeCalcExp(out + (envelope << 3));
-}
+#else
+
+#define OPL_WAVE_XOR        0x01
+#define OPL_WAVE_SHL        0x02
+#define OPL_WAVE_KIND       0x0c
+#define OPL_WAVE_LOGSIN     0x00
+#define OPL_WAVE_SILENT     0x04
+#define OPL_WAVE_ZERO       0x08
+#define OPL_WAVE_LINEAR     0x0c
+#define OPL_WAVE_NEG        0x80
+
+OPL3_CONST uint8_t opl3_wavedesc[OPL_NUM_WAVEFORMS * 8] = {
+    0x00, 0x00, 0x01, 0x01, 0x80, 0x80, 0x81, 0x81,
+    0x00, 0x00, 0x01, 0x01, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x04,
+#if !OPL3_PROFILE_OPL2
+    0x02, 0x03, 0x82, 0x83, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x03, 0x02, 0x03, 0x04, 0x04, 0x04, 0x04,
+    0x08, 0x08, 0x08, 0x08, 0x88, 0x88, 0x88, 0x88,
+    0x0c, 0x0c, 0x0c, 0x0c, 0x8d, 0x8d, 0x8d, 0x8d
+#endif
+};
 
-static int16_t OPL3_EnvelopeCalcSin6(uint16_t phase, uint16_t envelope)
+static int16_t OPL3_WaveCalc(uint8_t wf, uint16_t phase, uint16_t envelope)
 {
-    uint16_t neg = 0;
-    phase &= 0x3ff;
-    if (phase & 0x200)
+    uint8_t desc = opl3_wavedesc[(wf << 3) | ((phase >> 7) & 0x07)];
+    uint8_t index = (uint8_t)phase;
+    uint16_t out;
+    uint16_t neg = (desc & OPL_WAVE_NEG) ? 0xffff : 0;
+
+    switch (desc & OPL_WAVE_KIND)
     {
-        neg = 0xffff;
+    case OPL_WAVE_SILENT:
+        /* 減衰量0x1000以上は常に0になる */
+        return 0;
+    case OPL_WAVE_ZERO:
+        out = 0;
+        break;
+    case OPL_WAVE_LINEAR:
+        out = phase & 0x1ff;
+        if (desc & OPL_WAVE_XOR)
+        {
+            out ^= 0x1ff;
+        }
+        out <<= 3;
+        break;
+    default:
+        if (desc & OPL_WAVE_XOR)
+        {
+            index ^= 0xff;
+        }
+        if (desc & OPL_WAVE_SHL)
+        {
+            index <<= 1;
+        }
+        out = logsinrom[index];
+        break;
     }
-    return OPL3_EnvelopeCalcExp(envelope << 3) ^ neg;
+    return OPL3_EnvelopeCalcExp(out + (envelope << 3)) ^ neg;
 }
 
-static int16_t OPL3_EnvelopeCalcSin7(uint16_t phase, uint16_t envelope)
+static int16_t OPL3_WaveSign(uint8_t wf, uint16_t phase)
 {
-    uint16_t out = 0;
-    uint16_t neg = 0;
-    phase &= 0x3ff;
-    if (phase & 0x200)
+    if (opl3_wavedesc[(wf << 3) | ((phase >> 7) & 0x07)] & OPL_WAVE_NEG)
     {
-        neg = 0xffff;
-        phase = (phase & 0x1ff) ^ 0x1ff;
+        return -1;
     }
-    out = phase << 3;
-    return OPL3_EnvelopeCalcExp(out + (envelope << 3)) ^ neg;
+    return 0;
 }
 
-static const envelope_sinfunc envelope_sin[8] = {
-    OPL3_EnvelopeCalcSin0,
-    OPL3_EnvelopeCalcSin1,
-    OPL3_EnvelopeCalcSin2,
-    OPL3_EnvelopeCalcSin3,
-    OPL3_EnvelopeCalcSin4,
-    OPL3_EnvelopeCalcSin5,
-    OPL3_EnvelopeCalcSin6,
-    OPL3_EnvelopeCalcSin7
-};
+#endif
+#endif /* OPL_PART_RESIDENT */
 
 /* Channel types */
 
@@ -361,28 +384,20 @@ enum envelope_gen_num
 };
 
 /* エンベロープジェネレータの更新 */
-static void OPL3_EnvelopeUpdateKSL(opl3_slot *slot) {
-    int16_t ksl = (kslrom[slot->channel->f_num >> 6] << 2)
-                   - ((0x08 - slot->channel->block) << 5);
+#if OPL_PART_PAGED
+static void OPL3_EnvelopeUpdateKSL(opl3_chip *chip, opl3_slot *slot) {
+    opl3_channel *channel = &chip->channel[slot->ch_num];
+    int16_t ksl = (kslrom[channel->f_num >> 6] << 2)
+                   - ((0x08 - channel->block) << 5);
     if (ksl < 0) {
         ksl = 0;
     }
     slot->eg_ksl = (uint8_t)ksl;
 }
+#endif
 
-/* エンベロープジェネレータのレート計算 */
-static void OPL3_EnvelopeCalcRate(opl3_slot *slot, uint8_t reg_rate) {
-    uint8_t rate = 0;
-    if (reg_rate != 0x00) {
-        rate = (reg_rate << 2) + (slot->reg_ksr ? slot->channel->ksv : (slot->channel->ksv >> 2));
-        if (rate > 0x3c) {
-            rate = 0x3c;
-        }
-    }
-    slot->eg_rate = rate;
-}
-
-static void OPL3_EnvelopeCalc(opl3_slot *slot)
+#if OPL_PART_RESIDENT
+static void OPL3_EnvelopeCalc(opl3_chip *chip, opl3_slot *slot)
 {
     uint8_t nonzero;
     uint8_t rate;
@@ -396,7 +411,7 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
     uint8_t eg_off;
     uint8_t reset = 0;
     slot->eg_out = slot->eg_rout + (slot->reg_tl << 2)
-                 + (slot->eg_ksl >> kslshift[slot->reg_ksl]) + *slot->trem;
+                 + (slot->eg_ksl >> kslshift[slot->reg_ksl]) + (chip->tremolo & slot->reg_am);
     if (slot->key && slot->eg_gen == envelope_gen_num_release)
     {
         reset = 1;
@@ -424,7 +439,7 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
         }
     }
     slot->pg_reset = reset;
-    ks = slot->channel->ksv >> ((slot->reg_ksr ^ 1) << 1);
+    ks = chip->channel[slot->ch_num].ksv >> ((slot->reg_ksr ^ 1) << 1);
     nonzero = (reg_rate != 0);
     rate = ks + (reg_rate << 2);
     rate_hi = rate >> 2;
@@ -433,13 +448,13 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
     {
         rate_hi = 0x0f;
     }
-    eg_shift = rate_hi + slot->chip->eg_add;
+    eg_shift = rate_hi + chip->eg_add;
     shift = 0;
     if (nonzero)
     {
         if (rate_hi < 12)
         {
-            if (slot->chip->eg_state)
+            if (chip->eg_state)
             {
                 switch (eg_shift)
                 {
@@ -459,14 +474,14 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
         }
         else
         {
-            shift = (rate_hi & 0x03) + eg_incstep[rate_lo][slot->chip->eg_timer_lo];
+            shift = (rate_hi & 0x03) + eg_incstep[rate_lo][chip->eg_timer_lo];
             if (shift & 0x04)
             {
                 shift = 0x03;
             }
             if (!shift)
             {
-                shift = slot->chip->eg_state;
+                shift = chip->eg_state;
             }
         }
     }
@@ -527,197 +542,2204 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
     {
         slot->eg_gen = envelope_gen_num_release;
     }
+    /* リリースで減衰しきったら、次のキーオンまで休止スロットにする */
+    slot->eg_idle = !slot->key && slot->eg_gen == envelope_gen_num_release
+                 && slot->eg_rout == 0x1ff;
 }
+#endif
 
+#if OPL_PART_PAGED
 static void OPL3_EnvelopeKeyOn(opl3_slot *slot, uint8_t type)
 {
     slot->key |= type;
+    slot->eg_idle = 0;
 }
 
 static void OPL3_EnvelopeKeyOff(opl3_slot *slot, uint8_t type)
 {
     slot->key &= ~type;
 }
+#endif
+
 
+#if OPL_PART_RESIDENT
+/*
+ * 位相ジェネレータ
+ */
 
-/* 位相ジェネレータの計算 */
-static uint16_t OPL3_SlotCalcPhase(opl3_slot *slot) {
+/*
+ * 位相を進める。pg_phase_outには進める前の位相が入る
+ * (リズムモードの置き換えはOPL3_PhaseRhythm、ノイズはOPL3_NoiseStep)。
+ */
+static void OPL3_PhaseStep(opl3_chip *chip, opl3_slot *slot)
+{
+    opl3_channel *channel = &chip->channel[slot->ch_num];
+    uint16_t f_num;
+    uint32_t basefreq;
     uint16_t phase;
-    uint8_t quarter;
-    
-    if (slot->pg_reset) {
-        return 0;
+
+    f_num = channel->f_num;
+    if (slot->reg_vib)
+    {
+        int8_t range;
+        uint8_t vibpos;
+
+        range = (f_num >> 7) & 7;
+        vibpos = chip->vibpos;
+
+        if (!(vibpos & 3))
+        {
+            range = 0;
+        }
+        else if (vibpos & 1)
+        {
+            range >>= 1;
+        }
+        range >>= chip->vibshift;
+
+        if (vibpos & 4)
+        {
+            range = -range;
+        }
+        f_num += range;
     }
-    
+    basefreq = ((uint32_t)f_num << channel->block) >> 1;
     phase = (uint16_t)(slot->pg_phase >> 9);
-    
-    /* 波形選択に応じた処理(簡略化) */
-    switch (slot->reg_wf) {
-        case 0:  /* サイン波 */
-            quarter = (phase >> 8) & 0x03;
-            if (quarter == 1 || quarter == 2) {
-                phase = (0xff - (phase & 0xff)) | 0x100;
-            } else {
-                phase &= 0xff;
-            }
-            break;
-        /* 他の波形タイプは省略 */
-        default:
-            phase &= 0xff;
-            break;
+    if (slot->pg_reset)
+    {
+        slot->pg_phase = 0;
     }
-    
-    return phase;
+    slot->pg_phase += (basefreq * mt[slot->reg_mult]) >> 1;
+    slot->pg_phase_out = phase;
 }
 
-/* スロットの出力計算 */
-static int16_t OPL3_SlotCalcFB(opl3_slot *slot) {
-    int16_t feedback;
-    
-    if (slot->channel->fb != 0) {
-        feedback = (slot->prout + slot->out) >> (9 - slot->channel->fb);
-    } else {
-        feedback = 0;
-    }
-    slot->prout = slot->out;
-    
-    return feedback;
+/* ノイズLFSRを1つ進める(スロットごとに1回) */
+static void OPL3_NoiseStep(opl3_chip *chip)
+{
+    uint32_t noise = chip->noise;
+    uint8_t n_bit;
+
+    /* bit14とbit0はどちらも下位16bitにあるので16bit演算で足りる */
+    n_bit = (((uint16_t)noise >> 14) ^ (uint8_t)noise) & 0x01;
+    chip->noise = (noise >> 1) | ((uint32_t)n_bit << 22);
 }
 
 /*
- * 公開API関数
+ * hh(スロット13)の位相のビット。リズムモードでなくても記録する
+ * (セーブステートを元の実装と同じにするため)。
  */
+static void OPL3_PhaseHH(opl3_chip *chip, uint16_t phase)
+{
+    chip->rm_hh_bit2 = (phase >> 2) & 1;
+    chip->rm_hh_bit3 = (phase >> 3) & 1;
+    chip->rm_hh_bit7 = (phase >> 7) & 1;
+    chip->rm_hh_bit8 = (phase >> 8) & 1;
+}
 
-/* チップのリセットと初期化 */
-void OPL3_Reset(opl3_chip *chip, uint32_t samplerate) {
-    uint8_t slotnum, channum;
-    opl3_slot *slot;
-    opl3_channel *channel;
-    
-    /* すべてをゼロクリア */
-    memset(chip, 0, sizeof(opl3_chip));
-    
-    /* サンプリングレートの設定 */
-    chip->rateratio = (samplerate << 10) / 49716;
-    chip->tremoloshift = 4;
-    chip->vibshift = 1;
-    
-    /* スロットとチャンネルの初期化 */
-    for (slotnum = 0; slotnum < 36; slotnum++) {
-        slot = &chip->slot[slotnum];
-        slot->chip = chip;
-        slot->mod = &chip->zeromod;
-        slot->eg_rout = 0x1ff;
-        slot->eg_out = 0x1ff;
-        slot->eg_gen = envelope_gen_num_release;
-        slot->trem = (uint8_t*)&chip->zeromod;
-        slot->slot_num = slotnum;
-    }
-    
-    for (channum = 0; channum < 18; channum++) {
-        channel = &chip->channel[channum];
-        channel->chip = chip;
-        channel->out[0] = &chip->zeromod;
-        channel->out[1] = &chip->zeromod;
-        channel->out[2] = &chip->zeromod;
-        channel->out[3] = &chip->zeromod;
-        channel->ch_num = channum;
-        
-        /* スロットの割り当て */
-        channel->slots[0] = &chip->slot[ch_slot[channum]];
-        channel->slots[1] = &chip->slot[ch_slot[channum] + 3];
-        chip->slot[ch_slot[channum]].channel = channel;
-        chip->slot[ch_slot[channum] + 3].channel = channel;
-        if ((channum % 9) < 3)
-        {
-            channel->pair = &chip->channel[channum + 3u];
-        }
-        else if ((channum % 9) < 6)
-        {
-            channel->pair = &chip->channel[channum - 3u];
-        }
-        channel->chip = chip;
-        channel->out[0] = &chip->zeromod;
-        channel->out[1] = &chip->zeromod;
-        channel->out[2] = &chip->zeromod;
-        channel->out[3] = &chip->zeromod;
-        channel->chtype = ch_2op;
-        channel->cha = 0xffff;
-        channel->chb = 0xffff;
-#if OPL_ENABLE_STEREOEXT
-        channel->leftpan = 0x10000;
-        channel->rightpan = 0x10000;
-#endif
-        channel->ch_num = channum;
-        OPL3_ChannelSetupAlg(channel);
-    }
-    chip->noise = 1;
-    chip->rateratio = (samplerate << RSM_FRAC) / 49716;
-    chip->tremoloshift = 4;
-    chip->vibshift = 1;
+static uint8_t OPL3_RhythmXor(const opl3_chip *chip)
+{
+    return (chip->rm_hh_bit2 ^ chip->rm_hh_bit7)
+         | (chip->rm_hh_bit3 ^ chip->rm_tc_bit5)
+         | (chip->rm_tc_bit3 ^ chip->rm_tc_bit5);
+}
 
-#if OPL_ENABLE_STEREOEXT
-    if (!panpot_lut_build)
+/*
+ * リズムモードのhh(13)、sd(16)、tc(17)の位相の置き換え
+ * OPL3_PhaseStepの後、ノイズを進める前に呼ぶ
+ */
+static void OPL3_PhaseRhythm(opl3_chip *chip, opl3_slot *slot)
+{
+    uint16_t phase = slot->pg_phase_out;
+    uint8_t noise = (uint8_t)chip->noise & 0x01;
+    uint8_t rm_xor;
+
+    switch (slot->slot_num)
     {
-        int32_t i;
-        for (i = 0; i < 256; i++)
-        {
-            panpot_lut[i] = OPL_SIN(i);
-        }
-        panpot_lut_build = 1;
+    case 13: /* hh */
+        OPL3_PhaseHH(chip, phase);
+        rm_xor = OPL3_RhythmXor(chip);
+        slot->pg_phase_out = (rm_xor << 9) | ((rm_xor ^ noise) ? 0xd0 : 0x34);
+        break;
+    case 16: /* sd */
+        slot->pg_phase_out = (chip->rm_hh_bit8 << 9)
+                           | ((chip->rm_hh_bit8 ^ noise) << 8);
+        break;
+    default: /* 17: tc */
+        chip->rm_tc_bit3 = (phase >> 3) & 1;
+        chip->rm_tc_bit5 = (phase >> 5) & 1;
+        slot->pg_phase_out = (OPL3_RhythmXor(chip) << 9) | 0x80;
+        break;
     }
-#endif
 }
 
-/* レジスタ書き込み */
-void OPL3_WriteReg(opl3_chip *chip, uint16_t reg, uint8_t v) {
-    /* TODO: レジスタ書き込みの実装 */
-    /* これは元のopl3.cから移植する必要があります */
-    /* 
-     * レジスタマッピング:
-     * 0x01: TEST
-     * 0x02-0x05: Timer
-     * 0x08: CSW/NOTE-SEL
-     * 0x20-0x35: AM/VIB/EGT/KSR/MULT
-     * 0x40-0x55: KSL/TL
-     * ... 等々
-     */
+/* リズムモードでのhh、sd、tc以外のスロットと、リズムモードでない時 */
+static void OPL3_PhaseGenerate(opl3_chip *chip, opl3_slot *slot)
+{
+    OPL3_PhaseStep(chip, slot);
+    OPL3_NoiseStep(chip);
+}
+
+/* リズムモードのhh、sd、tc */
+static void OPL3_PhaseGenerateRhythm(opl3_chip *chip, opl3_slot *slot)
+{
+    OPL3_PhaseStep(chip, slot);
+    OPL3_PhaseRhythm(chip, slot);
+    OPL3_NoiseStep(chip);
 }
+#endif /* OPL_PART_RESIDENT */
 
-/* バッファリングされたレジスタ書き込み */
-void OPL3_WriteRegBuffered(opl3_chip *chip, uint16_t reg, uint8_t v) {
-    /* TODO: 実装 */
-    OPL3_WriteReg(chip, reg, v);
+/*
+ * スロット(オペレータ)
+ */
+
+#if OPL_PART_PAGED
+static void OPL3_SlotWrite20(opl3_slot *slot, uint8_t data)
+{
+    slot->reg_am = ((data >> 7) & 0x01) ? 0xff : 0x00;
+    slot->reg_vib = (data >> 6) & 0x01;
+    slot->reg_type = (data >> 5) & 0x01;
+    slot->reg_ksr = (data >> 4) & 0x01;
+    slot->reg_mult = data & 0x0f;
 }
 
-/* サンプル生成(1サンプル) */
-void OPL3_Generate(opl3_chip *chip, int16_t *buf) {
-    /* TODO: 実装 */
-    buf[0] = 0;
-    buf[1] = 0;
+static void OPL3_SlotWrite40(opl3_chip *chip, opl3_slot *slot, uint8_t data)
+{
+    slot->reg_ksl = (data >> 6) & 0x03;
+    slot->reg_tl = data & 0x3f;
+    OPL3_EnvelopeUpdateKSL(chip, slot);
 }
 
-/* リサンプリング付きサンプル生成 */
-void OPL3_GenerateResampled(opl3_chip *chip, int16_t *buf) {
-    /* TODO: 実装 */
-    OPL3_Generate(chip, buf);
+static void OPL3_SlotWrite60(opl3_slot *slot, uint8_t data)
+{
+    slot->reg_ar = (data >> 4) & 0x0f;
+    slot->reg_dr = data & 0x0f;
 }
 
-/* ストリーム生成 */
-void OPL3_GenerateStream(opl3_chip *chip, int16_t *sndptr, uint32_t numsamples) {
-    uint32_t i;
-    for (i = 0; i < numsamples; i++) {
-        OPL3_Generate(chip, sndptr);
-        sndptr += 2;
+static void OPL3_SlotWrite80(opl3_slot *slot, uint8_t data)
+{
+    slot->reg_sl = (data >> 4) & 0x0f;
+    if (slot->reg_sl == 0x0f)
+    {
+        slot->reg_sl = 0x1f;
+    }
+    slot->reg_rr = data & 0x0f;
+}
+
+static void OPL3_SlotWriteE0(opl3_chip *chip, opl3_slot *slot, uint8_t data)
+{
+#if OPL3_PROFILE_OPL2
+    /* OPL2の波形は0-3だけ */
+    (void)chip;
+    slot->reg_wf = data & 0x03;
+#else
+    slot->reg_wf = data & 0x07;
+    if (chip->newm == 0x00)
+    {
+        slot->reg_wf &= 0x03;
+    }
+#endif
+}
+#endif /* OPL_PART_PAGED */
+
+#if OPL_PART_RESIDENT
+static void OPL3_SlotGenerate(opl3_chip *chip, opl3_slot *slot)
+{
+    chip->sig[OPL_SIG_OUT + slot->slot_num]
+        = OPL3_WaveCalc(slot->reg_wf, slot->pg_phase_out + chip->sig[slot->mod], slot->eg_out);
+}
+
+static void OPL3_SlotCalcFB(opl3_chip *chip, opl3_slot *slot)
+{
+    uint8_t fb = chip->channel[slot->ch_num].fb;
+    int16_t out = chip->sig[OPL_SIG_OUT + slot->slot_num];
+
+    if (fb != 0x00)
+    {
+        chip->sig[OPL_SIG_FBMOD + slot->slot_num] = (slot->prout + out) >> (0x09 - fb);
+    }
+    else
+    {
+        chip->sig[OPL_SIG_FBMOD + slot->slot_num] = 0;
     }
+    slot->prout = out;
 }
+#endif
+
+OPL_SHARED void OPL3_SelectKernel(opl3_chip *chip);
 
+#if OPL_PART_PAGED
 /*
- * TODO: 以下の関数を元のopl3.cから移植する必要があります:
- * - エンベロープジェネレータ関連
- * - 位相ジェネレータ関連
- * - オペレータ計算
- * - チャンネル計算
- * - リズムモード
- * - その他の内部関数
+ * チャンネル
+ *
+ * スロットとペアのチャンネルは番号から求める。
+ * 変調入力とチャンネル出力の接続は chip->sig のインデックスで持つ。
  */
+
+#define OPL3_SLOT0(chip, channel)   (&(chip)->slot[ch_slot[(channel)->ch_num]])
+#define OPL3_SLOT1(chip, channel)   (&(chip)->slot[ch_slot[(channel)->ch_num] + 3u])
+
+#if !OPL3_PROFILE_OPL2
+#define OPL3_PAIR(chip, channel)    (&(chip)->channel[ch_pair[(channel)->ch_num]])
+
+/* 4opのペアになるチャンネル(3-5, 12-14は0-2, 9-11、6-8, 15-17は自分) */
+OPL3_CONST uint8_t ch_pair[18] = {
+    3, 4, 5, 0, 1, 2, 6, 7, 8, 12, 13, 14, 9, 10, 11, 15, 16, 17
+};
+#endif
+
+static void OPL3_ChannelSetupAlg(opl3_chip *chip, opl3_channel *channel);
+
+static void OPL3_ChannelSetOut(opl3_channel *channel, uint8_t out0, uint8_t out1,
+                               uint8_t out2, uint8_t out3)
+{
+    channel->out[0] = out0;
+    channel->out[1] = out1;
+    channel->out[2] = out2;
+    channel->out[3] = out3;
+}
+
+static void OPL3_ChannelUpdateRhythm(opl3_chip *chip, uint8_t data)
+{
+    opl3_channel *channel6;
+    opl3_channel *channel7;
+    opl3_channel *channel8;
+    uint8_t chnum;
+
+    chip->rhy = data & 0x3f;
+    OPL3_SelectKernel(chip);
+    if (chip->rhy & 0x20)
+    {
+        channel6 = &chip->channel[6];
+        channel7 = &chip->channel[7];
+        channel8 = &chip->channel[8];
+        /* ch6: 15(bd2), ch7: 13(hh), 16(sd), ch8: 14(tom), 17(tc) */
+        OPL3_ChannelSetOut(channel6, OPL_SIG_OUT + 15, OPL_SIG_OUT + 15,
+                           OPL_SIG_ZERO, OPL_SIG_ZERO);
+        OPL3_ChannelSetOut(channel7, OPL_SIG_OUT + 13, OPL_SIG_OUT + 13,
+                           OPL_SIG_OUT + 16, OPL_SIG_OUT + 16);
+        OPL3_ChannelSetOut(channel8, OPL_SIG_OUT + 14, OPL_SIG_OUT + 14,
+                           OPL_SIG_OUT + 17, OPL_SIG_OUT + 17);
+        for (chnum = 6; chnum < 9; chnum++)
+        {
+            chip->channel[chnum].chtype = ch_drum;
+        }
+        OPL3_ChannelSetupAlg(chip, channel6);
+        OPL3_ChannelSetupAlg(chip, channel7);
+        OPL3_ChannelSetupAlg(chip, channel8);
+        /* hh */
+        if (chip->rhy & 0x01)
+        {
+            OPL3_EnvelopeKeyOn(&chip->slot[13], egk_drum);
+        }
+        else
+        {
+            OPL3_EnvelopeKeyOff(&chip->slot[13], egk_drum);
+        }
+        /* tc */
+        if (chip->rhy & 0x02)
+        {
+            OPL3_EnvelopeKeyOn(&chip->slot[17], egk_drum);
+        }
+        else
+        {
+            OPL3_EnvelopeKeyOff(&chip->slot[17], egk_drum);
+        }
+        /* tom */
+        if (chip->rhy & 0x04)
+        {
+            OPL3_EnvelopeKeyOn(&chip->slot[14], egk_drum);
+        }
+        else
+        {
+            OPL3_EnvelopeKeyOff(&chip->slot[14], egk_drum);
+        }
+        /* sd */
+        if (chip->rhy & 0x08)
+        {
+            OPL3_EnvelopeKeyOn(&chip->slot[16], egk_drum);
+        }
+        else
+        {
+            OPL3_EnvelopeKeyOff(&chip->slot[16], egk_drum);
+        }
+        /* bd */
+        if (chip->rhy & 0x10)
+        {
+            OPL3_EnvelopeKeyOn(&chip->slot[12], egk_drum);
+            OPL3_EnvelopeKeyOn(&chip->slot[15], egk_drum);
+        }
+        else
+        {
+            OPL3_EnvelopeKeyOff(&chip->slot[12], egk_drum);
+            OPL3_EnvelopeKeyOff(&chip->slot[15], egk_drum);
+        }
+    }
+    else
+    {
+        for (chnum = 6; chnum < 9; chnum++)
+        {
+            chip->channel[chnum].chtype = ch_2op;
+            OPL3_ChannelSetupAlg(chip, &chip->channel[chnum]);
+            OPL3_EnvelopeKeyOff(OPL3_SLOT0(chip, &chip->channel[chnum]), egk_drum);
+            OPL3_EnvelopeKeyOff(OPL3_SLOT1(chip, &chip->channel[chnum]), egk_drum);
+        }
+    }
+}
+
+static void OPL3_ChannelUpdateKSL(opl3_chip *chip, opl3_channel *channel)
+{
+    OPL3_EnvelopeUpdateKSL(chip, OPL3_SLOT0(chip, channel));
+    OPL3_EnvelopeUpdateKSL(chip, OPL3_SLOT1(chip, channel));
+}
+
+static void OPL3_ChannelWriteA0(opl3_chip *chip, opl3_channel *channel, uint8_t data)
+{
+#if !OPL3_PROFILE_OPL2
+    opl3_channel *pair;
+
+    if (chip->newm && channel->chtype == ch_4op2)
+    {
+        return;
+    }
+#endif
+    channel->f_num = (channel->f_num & 0x300) | data;
+    channel->ksv = (channel->block << 1)
+                 | ((channel->f_num >> (0x09 - chip->nts)) & 0x01);
+    OPL3_ChannelUpdateKSL(chip, channel);
+#if !OPL3_PROFILE_OPL2
+    if (chip->newm && channel->chtype == ch_4op)
+    {
+        pair = OPL3_PAIR(chip, channel);
+        pair->f_num = channel->f_num;
+        pair->ksv = channel->ksv;
+        OPL3_ChannelUpdateKSL(chip, pair);
+    }
+#endif
+}
+
+static void OPL3_ChannelWriteB0(opl3_chip *chip, opl3_channel *channel, uint8_t data)
+{
+#if !OPL3_PROFILE_OPL2
+    opl3_channel *pair;
+
+    if (chip->newm && channel->chtype == ch_4op2)
+    {
+        return;
+    }
+#endif
+    channel->f_num = (channel->f_num & 0xff) | ((data & 0x03) << 8);
+    channel->block = (data >> 2) & 0x07;
+    channel->ksv = (channel->block << 1)
+                 | ((channel->f_num >> (0x09 - chip->nts)) & 0x01);
+    OPL3_ChannelUpdateKSL(chip, channel);
+#if !OPL3_PROFILE_OPL2
+    if (chip->newm && channel->chtype == ch_4op)
+    {
+        pair = OPL3_PAIR(chip, channel);
+        pair->f_num = channel->f_num;
+        pair->block = channel->block;
+        pair->ksv = channel->ksv;
+        OPL3_ChannelUpdateKSL(chip, pair);
+    }
+#endif
+}
+
+static void OPL3_ChannelSetupAlg(opl3_chip *chip, opl3_channel *channel)
+{
+    opl3_slot *slot0 = OPL3_SLOT0(chip, channel);
+    opl3_slot *slot1 = OPL3_SLOT1(chip, channel);
+    uint8_t out0 = OPL_SIG_OUT + slot0->slot_num;
+    uint8_t out1 = OPL_SIG_OUT + slot1->slot_num;
+#if !OPL3_PROFILE_OPL2
+    opl3_channel *pair;
+    opl3_slot *pslot0;
+    opl3_slot *pslot1;
+    uint8_t pout0, pout1;
+#endif
+
+    if (channel->chtype == ch_drum)
+    {
+        if (channel->ch_num == 7 || channel->ch_num == 8)
+        {
+            slot0->mod = OPL_SIG_ZERO;
+            slot1->mod = OPL_SIG_ZERO;
+            return;
+        }
+        switch (channel->alg & 0x01)
+        {
+        case 0x00:
+            slot0->mod = OPL_SIG_FBMOD + slot0->slot_num;
+            slot1->mod = out0;
+            break;
+        case 0x01:
+            slot0->mod = OPL_SIG_FBMOD + slot0->slot_num;
+            slot1->mod = OPL_SIG_ZERO;
+            break;
+        }
+        return;
+    }
+#if !OPL3_PROFILE_OPL2
+    if (channel->alg & 0x08)
+    {
+        return;
+    }
+    if (channel->alg & 0x04)
+    {
+        pair = OPL3_PAIR(chip, channel);
+        pslot0 = OPL3_SLOT0(chip, pair);
+        pslot1 = OPL3_SLOT1(chip, pair);
+        pout0 = OPL_SIG_OUT + pslot0->slot_num;
+        pout1 = OPL_SIG_OUT + pslot1->slot_num;
+        OPL3_ChannelSetOut(pair, OPL_SIG_ZERO, OPL_SIG_ZERO, OPL_SIG_ZERO, OPL_SIG_ZERO);
+        switch (channel->alg & 0x03)
+        {
+        case 0x00:
+            pslot0->mod = OPL_SIG_FBMOD + pslot0->slot_num;
+            pslot1->mod = pout0;
+            slot0->mod = pout1;
+            slot1->mod = out0;
+            OPL3_ChannelSetOut(channel, out1, OPL_SIG_ZERO, OPL_SIG_ZERO, OPL_SIG_ZERO);
+            break;
+        case 0x01:
+            pslot0->mod = OPL_SIG_FBMOD + pslot0->slot_num;
+            pslot1->mod = pout0;
+            slot0->mod = OPL_SIG_ZERO;
+            slot1->mod = out0;
+            OPL3_ChannelSetOut(channel, pout1, out1, OPL_SIG_ZERO, OPL_SIG_ZERO);
+            break;
+        case 0x02:
+            pslot0->mod = OPL_SIG_FBMOD + pslot0->slot_num;
+            pslot1->mod = OPL_SIG_ZERO;
+            slot0->mod = pout1;
+            slot1->mod = out0;
+            OPL3_ChannelSetOut(channel, pout0, out1, OPL_SIG_ZERO, OPL_SIG_ZERO);
+            break;
+        case 0x03:
+            pslot0->mod = OPL_SIG_FBMOD + pslot0->slot_num;
+            pslot1->mod = OPL_SIG_ZERO;
+            slot0->mod = pout1;
+            slot1->mod = OPL_SIG_ZERO;
+            OPL3_ChannelSetOut(channel, pout0, out0, out1, OPL_SIG_ZERO);
+            break;
+        }
+        return;
+    }
+#endif
+    switch (channel->alg & 0x01)
+    {
+    case 0x00:
+        slot0->mod = OPL_SIG_FBMOD + slot0->slot_num;
+        slot1->mod = out0;
+        OPL3_ChannelSetOut(channel, out1, OPL_SIG_ZERO, OPL_SIG_ZERO, OPL_SIG_ZERO);
+        break;
+    case 0x01:
+        slot0->mod = OPL_SIG_FBMOD + slot0->slot_num;
+        slot1->mod = OPL_SIG_ZERO;
+        OPL3_ChannelSetOut(channel, out0, out1, OPL_SIG_ZERO, OPL_SIG_ZERO);
+        break;
+    }
+}
+
+static void OPL3_ChannelUpdateAlg(opl3_chip *chip, opl3_channel *channel)
+{
+#if OPL3_PROFILE_OPL2
+    channel->alg = channel->con;
+    OPL3_ChannelSetupAlg(chip, channel);
+#else
+    opl3_channel *pair = OPL3_PAIR(chip, channel);
+
+    channel->alg = channel->con;
+    if (chip->newm)
+    {
+        if (channel->chtype == ch_4op)
+        {
+            pair->alg = 0x04 | (channel->con << 1) | (pair->con);
+            channel->alg = 0x08;
+            OPL3_ChannelSetupAlg(chip, pair);
+        }
+        else if (channel->chtype == ch_4op2)
+        {
+            channel->alg = 0x04 | (pair->con << 1) | (channel->con);
+            pair->alg = 0x08;
+            OPL3_ChannelSetupAlg(chip, channel);
+        }
+        else
+        {
+            OPL3_ChannelSetupAlg(chip, channel);
+        }
+    }
+    else
+    {
+        OPL3_ChannelSetupAlg(chip, channel);
+    }
+#endif
+}
+
+#if OPL_MIX_SIMD
+/* SIMDミックス用に、cha/chb/chc/chdをチャンネル番号のビットへ写す */
+static void OPL3_ChannelUpdateMix(opl3_chip *chip, const opl3_channel *channel)
+{
+    uint32_t bit = 1UL << channel->ch_num;
+
+    chip->mixmask[0] = (chip->mixmask[0] & ~bit) | (channel->cha ? bit : 0);
+    chip->mixmask[1] = (chip->mixmask[1] & ~bit) | (channel->chb ? bit : 0);
+    chip->mixmask[2] = (chip->mixmask[2] & ~bit) | (channel->chc ? bit : 0);
+    chip->mixmask[3] = (chip->mixmask[3] & ~bit) | (channel->chd ? bit : 0);
+}
+#endif
+
+static void OPL3_ChannelWriteC0(opl3_chip *chip, opl3_channel *channel, uint8_t data)
+{
+    channel->fb = (data & 0x0e) >> 1;
+    channel->con = data & 0x01;
+    OPL3_ChannelUpdateAlg(chip, channel);
+#if OPL3_PROFILE_OPL2
+    channel->cha = channel->chb = (uint16_t)~0;
+#else
+    if (chip->newm)
+    {
+        channel->cha = ((data >> 4) & 0x01) ? ~0 : 0;
+        channel->chb = ((data >> 5) & 0x01) ? ~0 : 0;
+        channel->chc = ((data >> 6) & 0x01) ? ~0 : 0;
+        channel->chd = ((data >> 7) & 0x01) ? ~0 : 0;
+    }
+    else
+    {
+        channel->cha = channel->chb = (uint16_t)~0;
+        /* TODO: 互換モードでDAC2出力が無効になるか実機で要確認 */
+        channel->chc = channel->chd = 0;
+    }
+#endif
+#if OPL_MIX_SIMD
+    OPL3_ChannelUpdateMix(chip, channel);
+#endif
+#if OPL_ENABLE_STEREOEXT
+    if (!chip->stereoext)
+    {
+        channel->leftpan = (int32_t)channel->cha << 16;
+        channel->rightpan = (int32_t)channel->chb << 16;
+    }
+#endif
+}
+
+#if OPL_ENABLE_STEREOEXT
+static void OPL3_ChannelWriteD0(opl3_chip *chip, opl3_channel *channel, uint8_t data)
+{
+    if (chip->stereoext)
+    {
+        channel->leftpan = panpot_lut[data ^ 0xffu];
+        channel->rightpan = panpot_lut[data];
+    }
+}
+#endif
+
+static void OPL3_ChannelKeyOn(opl3_chip *chip, opl3_channel *channel)
+{
+#if OPL3_PROFILE_OPL2
+    OPL3_EnvelopeKeyOn(OPL3_SLOT0(chip, channel), egk_norm);
+    OPL3_EnvelopeKeyOn(OPL3_SLOT1(chip, channel), egk_norm);
+#else
+    opl3_channel *pair;
+
+    if (chip->newm)
+    {
+        if (channel->chtype == ch_4op)
+        {
+            pair = OPL3_PAIR(chip, channel);
+            OPL3_EnvelopeKeyOn(OPL3_SLOT0(chip, channel), egk_norm);
+            OPL3_EnvelopeKeyOn(OPL3_SLOT1(chip, channel), egk_norm);
+            OPL3_EnvelopeKeyOn(OPL3_SLOT0(chip, pair), egk_norm);
+            OPL3_EnvelopeKeyOn(OPL3_SLOT1(chip, pair), egk_norm);
+        }
+        else if (channel->chtype == ch_2op || channel->chtype == ch_drum)
+        {
+            OPL3_EnvelopeKeyOn(OPL3_SLOT0(chip, channel), egk_norm);
+            OPL3_EnvelopeKeyOn(OPL3_SLOT1(chip, channel), egk_norm);
+        }
+    }
+    else
+    {
+        OPL3_EnvelopeKeyOn(OPL3_SLOT0(chip, channel), egk_norm);
+        OPL3_EnvelopeKeyOn(OPL3_SLOT1(chip, channel), egk_norm);
+    }
+#endif
+}
+
+static void OPL3_ChannelKeyOff(opl3_chip *chip, opl3_channel *channel)
+{
+#if OPL3_PROFILE_OPL2
+    OPL3_EnvelopeKeyOff(OPL3_SLOT0(chip, channel), egk_norm);
+    OPL3_EnvelopeKeyOff(OPL3_SLOT1(chip, channel), egk_norm);
+#else
+    opl3_channel *pair;
+
+    if (chip->newm)
+    {
+        if (channel->chtype == ch_4op)
+        {
+            pair = OPL3_PAIR(chip, channel);
+            OPL3_EnvelopeKeyOff(OPL3_SLOT0(chip, channel), egk_norm);
+            OPL3_EnvelopeKeyOff(OPL3_SLOT1(chip, channel), egk_norm);
+            OPL3_EnvelopeKeyOff(OPL3_SLOT0(chip, pair), egk_norm);
+            OPL3_EnvelopeKeyOff(OPL3_SLOT1(chip, pair), egk_norm);
+        }
+        else if (channel->chtype == ch_2op || channel->chtype == ch_drum)
+        {
+            OPL3_EnvelopeKeyOff(OPL3_SLOT0(chip, channel), egk_norm);
+            OPL3_EnvelopeKeyOff(OPL3_SLOT1(chip, channel), egk_norm);
+        }
+    }
+    else
+    {
+        OPL3_EnvelopeKeyOff(OPL3_SLOT0(chip, channel), egk_norm);
+        OPL3_EnvelopeKeyOff(OPL3_SLOT1(chip, channel), egk_norm);
+    }
+#endif
+}
+
+#if !OPL3_PROFILE_OPL2
+static void OPL3_ChannelSet4Op(opl3_chip *chip, uint8_t data)
+{
+    uint8_t bit;
+    uint8_t chnum;
+    for (bit = 0; bit < 6; bit++)
+    {
+        chnum = bit;
+        if (bit >= 3)
+        {
+            chnum += 9 - 3;
+        }
+        if ((data >> bit) & 0x01)
+        {
+            chip->channel[chnum].chtype = ch_4op;
+            chip->channel[chnum + 3u].chtype = ch_4op2;
+            OPL3_ChannelUpdateAlg(chip, &chip->channel[chnum]);
+        }
+        else
+        {
+            chip->channel[chnum].chtype = ch_2op;
+            chip->channel[chnum + 3u].chtype = ch_2op;
+            OPL3_ChannelUpdateAlg(chip, &chip->channel[chnum]);
+            OPL3_ChannelUpdateAlg(chip, &chip->channel[chnum + 3u]);
+        }
+    }
+}
+#endif
+#endif /* OPL_PART_PAGED */
+
+#if OPL_PART_RESIDENT
+/*
+ * バンク切り替え(OPL_BANKED、src/opl3_bank.h)
+ * 切り替える側を出す区間は入れ子にでき、一番外側だけで切り替える。
+ */
+#if OPL_BANKED
+#ifndef OPL_BANK_MAP
+#if OPL_BANKED == 1
+/*
+ * ZX Spectrum 128K: ポート0x7FFDのbit 0-2が0xC000のRAMバンク。
+ * 0x7FFDは読めないので、ROMと同じくシステム変数BANKM(0x5B5C)に写しを置く。
+ * 割り込み処理がBANKMを読んで切り替えても写しとポートがずれないよう、
+ * ROMと同じく読み出しから書き込みまでをdiとeiで囲む(割り込みは許可して戻る)
+ */
+__sfr __banked __at 0x7ffd opl3_port7ffd;
+#define OPL_BANKM           (*(volatile uint8_t *)0x5b5c)
+
+static uint8_t OPL3_BankMap(uint8_t bank)
+{
+    uint8_t prev, v;
+
+    intrinsic_di();
+    prev = OPL_BANKM;
+    v = (prev & 0xf8) | bank;
+    OPL_BANKM = v;
+    opl3_port7ffd = v;
+    intrinsic_ei();
+    return prev & 0x07;
+}
+#else
+/*
+ * MSXのメモリマッパー: ポート0xFEがページ2(0x8000-0xBFFF)のセグメント。
+ * 読み出せない機種があるので写しを持つ(MSX-DOSのTPAではセグメント1)
+ */
+__sfr __at 0xfe opl3_mapper2;
+static uint8_t opl3_mapper2_seg = 1;
+
+static uint8_t OPL3_BankMap(uint8_t bank)
+{
+    uint8_t prev = opl3_mapper2_seg;
+
+    opl3_mapper2_seg = bank;
+    opl3_mapper2 = bank;
+    return prev;
+}
+#endif
+#define OPL_BANK_MAP        OPL3_BankMap
+#endif
+
+#if OPL_BANKED == 2 && !defined(OPL_BANK_NUM)
+/* OPL3_BankLoadが確保したセグメント */
+static uint8_t opl3_bankseg;
+#define OPL_BANK_SEG        opl3_bankseg
+#else
+#define OPL_BANK_SEG        OPL_BANK_NUM
+#endif
+
+static uint8_t opl3_bankdepth = 0;
+static uint8_t opl3_bankprev;
+
+static void OPL3_BankEnter(void)
+{
+    if (opl3_bankdepth++ == 0)
+    {
+        opl3_bankprev = OPL_BANK_MAP(OPL_BANK_SEG);
+    }
+}
+
+static void OPL3_BankLeave(void)
+{
+    if (--opl3_bankdepth == 0)
+    {
+        OPL_BANK_MAP(opl3_bankprev);
+    }
+}
+
+void OPL3_BankBegin(void)
+{
+    OPL3_BankEnter();
+}
+
+void OPL3_BankEnd(void)
+{
+    OPL3_BankLeave();
+}
+
+/* ためているOPL3_WriteRegを書き込み順にデコードする */
+static void OPL3_BankFlush(opl3_chip *chip)
+{
+    uint8_t i;
+
+    OPL3_BankEnter();
+    for (i = 0; i < chip->bank_pending; i++)
+    {
+        OPL3_WriteRegPaged(chip, chip->bank_reg[i], chip->bank_data[i]);
+    }
+    chip->bank_pending = 0;
+    OPL3_BankLeave();
+}
+
+#if OPL_BANKED == 2
+/* src/opl3_msxbank.asm: 0 = マッパーサポートなし, 1 = 確保した, 2 = 空きなし */
+uint8_t opl3_msxallseg(uint8_t *seg) OPL3_FASTCALL;
+
+/*
+ * セグメントsegがマッパーの中にあり、TPA(セグメント0-3)に折り返して
+ * いないか確かめる。マッパーは大きさを超えた番号を下位ビットで折り返す
+ * ので、segの先頭に2通りの印を書き、TPAのセグメントの同じ番地に両方とも
+ * 現れなければよい。TPAを一時的に書き換えることがあるので割り込みを止める
+ */
+static uint8_t OPL3_BankProbe(uint8_t seg)
+{
+    volatile uint8_t *p = (volatile uint8_t *)0x8000;
+    uint8_t prev, saved, mark, tpa, alias = 0x0f;
+
+    if (seg < 4)
+    {
+        return 0;
+    }
+    intrinsic_di();
+    prev = OPL_BANK_MAP(seg);
+    saved = *p;
+    for (mark = 0x55; mark; mark = mark == 0x55 ? 0xaa : 0)
+    {
+        OPL_BANK_MAP(seg);
+        *p = saved ^ mark;
+        for (tpa = 0; tpa < 4; tpa++)
+        {
+            OPL_BANK_MAP(tpa);
+            if (*p != (uint8_t)(saved ^ mark))
+            {
+                alias &= (uint8_t)~(1u << tpa);
+            }
+        }
+    }
+    OPL_BANK_MAP(seg);
+    *p = saved;
+    OPL_BANK_MAP(prev);
+    intrinsic_ei();
+    return alias == 0;
+}
+
+uint8_t OPL3_BankLoad(const char *path)
+{
+    FILE *fp;
+    size_t n;
+    uint8_t end;
+
+#ifdef OPL_BANK_NUM
+    if (!OPL3_BankProbe(OPL_BANK_NUM))
+    {
+        return 0;
+    }
+#else
+    /* MSX-DOS2なら確保し、マッパーサポートがなければTPAの次を使う */
+    switch (opl3_msxallseg(&opl3_bankseg))
+    {
+    case 0:
+        opl3_bankseg = 4;
+        break;
+    case 1:
+        break;
+    default:
+        return 0;
+    }
+    if (!OPL3_BankProbe(opl3_bankseg))
+    {
+        return 0;
+    }
+#endif
+    fp = fopen(path, "rb");
+    if (!fp)
+    {
+        return 0;
+    }
+    OPL3_BankEnter();
+    n = fread((void *)0x8000, 1, 0x4000, fp);
+    OPL3_BankLeave();
+    /* 窓(16KB)より大きいファイルは別のビルドのもの */
+    end = fgetc(fp) == EOF;
+    fclose(fp);
+    return n > 0 && end;
+}
+#endif
+#else
+#define OPL3_BankEnter()    ((void)0)
+#define OPL3_BankLeave()    ((void)0)
+#endif
+
+/*
+ * サンプル生成
+ */
+
+static int16_t OPL3_ClipSample(int32_t sample)
+{
+    if (sample > 32767)
+    {
+        sample = 32767;
+    }
+    else if (sample < -32768)
+    {
+        sample = -32768;
+    }
+    return (int16_t)sample;
+}
+
+#if OPL3_PROFILE
+/*
+ * ステージ別の計測。前の区切りtからの時間をstageに足してtを今に進める。
+ * countは呼び出し回数に足す数(同じステージを2つに分けて測る時は片方が0)。
+ */
+static void OPL3_ProfileLap(opl3_chip *chip, uint8_t stage, uint8_t count, opl3_proftime *t)
+{
+    opl3_proftime now = OPL_PROFILE_CLOCK();
+
+    chip->profile.ticks[stage] += now - *t;
+    chip->profile.calls[stage] += count;
+    *t = now;
+}
+
+#define OPL_PROF_VAR(t)                     opl3_proftime t;
+#define OPL_PROF_START(t)                   ((t) = OPL_PROFILE_CLOCK())
+#define OPL_PROF_LAP(chip, stage, count, t) OPL3_ProfileLap(chip, stage, count, &(t))
+#else
+#define OPL_PROF_VAR(t)
+#define OPL_PROF_START(t)                   ((void)0)
+#define OPL_PROF_LAP(chip, stage, count, t) ((void)0)
+#endif
+
+/*
+ * 休止スロット(キーオフ、リリース、eg_rout == 0x1ff)では
+ * エンベロープが変化しないので計算を省略する。
+ * 減衰量が0x1ff以上なら指数変換の結果は0なので、出力は位相の
+ * 符号だけで決まる(0または-1)。位相とノイズは通常どおり進める。
+ * phaseは位相の関数で、リズムモードのhh、sd、tc用に2つ作る。
+ */
+#define OPL3_PROCESSSLOT(name, phase)                                           \
+static void name(opl3_chip *chip, opl3_slot *slot)                              \
+{                                                                               \
+    OPL_PROF_VAR(t)                                                             \
+                                                                                \
+    OPL_PROF_START(t);                                                          \
+    OPL3_SlotCalcFB(chip, slot);                                                \
+    OPL_PROF_LAP(chip, OPL_PROF_SLOT, 0, t);                                    \
+    if (slot->eg_idle)                                                          \
+    {                                                                           \
+        phase(chip, slot);                                                      \
+        chip->sig[OPL_SIG_OUT + slot->slot_num]                                 \
+            = OPL3_WaveSign(slot->reg_wf, slot->pg_phase_out + chip->sig[slot->mod]); \
+        OPL_PROF_LAP(chip, OPL_PROF_PHASE, 1, t);                               \
+        return;                                                                 \
+    }                                                                           \
+    OPL3_EnvelopeCalc(chip, slot);                                              \
+    OPL_PROF_LAP(chip, OPL_PROF_ENVELOPE, 1, t);                                \
+    phase(chip, slot);                                                          \
+    OPL_PROF_LAP(chip, OPL_PROF_PHASE, 1, t);                                   \
+    OPL3_SlotGenerate(chip, slot);                                              \
+    OPL_PROF_LAP(chip, OPL_PROF_SLOT, 1, t);                                    \
+}
+
+OPL3_PROCESSSLOT(OPL3_ProcessSlot, OPL3_PhaseGenerate)
+OPL3_PROCESSSLOT(OPL3_ProcessSlotRhythm, OPL3_PhaseGenerateRhythm)
+
+#if OPL3_PROFILE_OPL2
+/*
+ * ノイズLFSRはスロットごとに1回進むので、完全版と同じ列にするため
+ * 上位バンクの18スロット分をまとめて進める。k回目(0-17)に入るビットは
+ * k < 9 ならbit(14+k)^bit(k)、k >= 9 なら(k-9)回目に入ったビット^bit(k)。
+ */
+static void OPL3_NoiseSkip(opl3_chip *chip)
+{
+    uint32_t noise = chip->noise;
+    uint16_t lo = (uint16_t)((noise >> 14) ^ noise) & 0x1ff;
+    uint16_t hi = (uint16_t)(lo ^ (noise >> 9)) & 0x1ff;
+
+    chip->noise = (noise >> 18) | (((uint32_t)hi << 9 | lo) << 5);
+}
+#endif
+
+/*
+ * eg_timerの下位13bitで最下位の1の位置+1(すべて0なら0)
+ * 下位バイトが0の時だけ上位5bitを引く
+ */
+static uint8_t OPL3_EnvelopeAdd(uint16_t eg_timer)
+{
+    uint8_t lo = (uint8_t)eg_timer;
+
+    if (lo)
+    {
+        return eg_addtab[lo];
+    }
+    lo = (uint8_t)(eg_timer >> 8) & 0x1f;
+    return lo ? eg_addtab[lo] + 8 : 0;
+}
+
+static void OPL3_UpdateTimers(opl3_chip *chip)
+{
+    /* 210で割る剰余は比較で済ませる(Z80の除算は高価) */
+    if ((chip->timer & 0x3f) == 0x3f)
+    {
+        if (++chip->tremolopos == 210)
+        {
+            chip->tremolopos = 0;
+        }
+    }
+    if (chip->tremolopos < 105)
+    {
+        chip->tremolo = chip->tremolopos >> chip->tremoloshift;
+    }
+    else
+    {
+        chip->tremolo = (210 - chip->tremolopos) >> chip->tremoloshift;
+    }
+
+    if ((chip->timer & 0x3ff) == 0x3ff)
+    {
+        chip->vibpos = (chip->vibpos + 1) & 7;
+    }
+
+    chip->timer++;
+
+    if (chip->eg_state)
+    {
+        chip->eg_add = OPL3_EnvelopeAdd(chip->eg_timer);
+        chip->eg_timer_lo = (uint8_t)(chip->eg_timer & 0x3u);
+    }
+
+    if (chip->eg_timerrem || chip->eg_state)
+    {
+        /* 0xfffffffffで0に戻る。上位を見るのは下位16bitが桁上がりする時だけ */
+        chip->eg_timerrem = 0;
+        if (++chip->eg_timer == 0)
+        {
+            if (chip->eg_timerhi == 0xfffffUL)
+            {
+                chip->eg_timerhi = 0;
+                chip->eg_timerrem = 1;
+            }
+            else
+            {
+                chip->eg_timerhi++;
+            }
+        }
+    }
+
+    chip->eg_state ^= 1;
+}
+
+/* 時刻が来たエントリをまとめて処理し、次の時刻を更新する */
+static void OPL3_ProcessWriteBuf(opl3_chip *chip)
+{
+    opl3_writebuf *writebuf;
+    opl3_writebuf *end;
+
+    if (chip->writebuf_head == chip->writebuf_tail)
+    {
+        chip->writebuf_next = 0xffffffffUL;
+        return;
+    }
+    writebuf = &chip->writebuf[chip->writebuf_head];
+    end = &chip->writebuf[chip->writebuf_tail];
+    /* ストリーム生成の中ならバンクは出ているので切り替えない */
+    OPL3_BankEnter();
+    while (writebuf != end && writebuf->time <= chip->writebuf_samplecnt)
+    {
+        OPL_WRITEREG(chip, writebuf->reg, writebuf->data);
+        writebuf++;
+    }
+    OPL3_BankLeave();
+    if (writebuf == end)
+    {
+        chip->writebuf_head = 0;
+        chip->writebuf_tail = 0;
+        chip->writebuf_next = 0xffffffffUL;
+    }
+    else
+    {
+        chip->writebuf_head = (uint16_t)(writebuf - chip->writebuf);
+        chip->writebuf_next = writebuf->time;
+    }
+}
+
+#if OPL_MIX_SIMD
+/*
+ * チャンネルミックスのカーネル
+ * pass 0: cha/chcの2出力, pass 1: chb/chdの2出力をmix[0], mix[1]に返す。
+ * チャンネル出力は16bitで折り返す(スカラー版の(int16_t)と同じ)。
+ * SIMD版は18チャンネルを24レーンの配列に集めてから、mixmaskのビットを
+ * レーンマスクに展開して足し込む(18以降のレーンはマスクが0)。
+ */
+#define OPL_MIX_LANES   24
+
+typedef void (*opl3_mixfunc)(const opl3_chip *chip, uint8_t pass, int32_t *mix);
+
+static void OPL3_MixScalar(const opl3_chip *chip, uint8_t pass, int32_t *mix)
+{
+    const opl3_channel *channel = chip->channel;
+    const int16_t *sig = chip->sig;
+    const uint8_t *out;
+    int16_t accm;
+    uint8_t ii;
+
+    mix[0] = mix[1] = 0;
+    for (ii = 0; ii < 18; ii++, channel++)
+    {
+        out = channel->out;
+        accm = sig[out[0]] + sig[out[1]] + sig[out[2]] + sig[out[3]];
+        mix[0] += (int16_t)(accm & (pass ? channel->chb : channel->cha));
+        mix[1] += (int16_t)(accm & (pass ? channel->chd : channel->chc));
+    }
+}
+
+/* 16-23レーンを0にしてから0-17レーンに各チャンネルの出力を集める */
+__attribute__((target("sse2")))
+static void OPL3_MixGather(const opl3_chip *chip, int16_t *accm)
+{
+    const opl3_channel *channel = chip->channel;
+    const int16_t *sig = chip->sig;
+    uint8_t ii;
+
+    _mm_storeu_si128((__m128i *)&accm[16], _mm_setzero_si128());
+    for (ii = 0; ii < 18; ii++, channel++)
+    {
+        accm[ii] = (int16_t)(sig[channel->out[0]] + sig[channel->out[1]]
+                           + sig[channel->out[2]] + sig[channel->out[3]]);
+    }
+}
+
+/* 8レーン分: maskの下位8bitで選んだレーンを32bitに広げて足す */
+__attribute__((target("sse2")))
+static __m128i OPL3_MixLanes128(__m128i v, uint32_t mask)
+{
+    const __m128i bits = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+    __m128i m;
+
+    m = _mm_and_si128(_mm_set1_epi16((int16_t)mask), bits);
+    m = _mm_cmpeq_epi16(m, bits);
+    return _mm_madd_epi16(_mm_and_si128(v, m), _mm_set1_epi16(1));
+}
+
+__attribute__((target("sse2")))
+static int32_t OPL3_MixSum128(__m128i v)
+{
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v);
+}
+
+__attribute__((target("sse2")))
+static void OPL3_MixSSE2(const opl3_chip *chip, uint8_t pass, int32_t *mix)
+{
+    int16_t accm[OPL_MIX_LANES];
+    uint32_t mask0 = chip->mixmask[pass];
+    uint32_t mask1 = chip->mixmask[pass + 2];
+    __m128i sum0 = _mm_setzero_si128();
+    __m128i sum1 = _mm_setzero_si128();
+    __m128i v;
+    uint8_t ii;
+
+    OPL3_MixGather(chip, accm);
+    for (ii = 0; ii < OPL_MIX_LANES; ii += 8)
+    {
+        v = _mm_loadu_si128((const __m128i *)&accm[ii]);
+        sum0 = _mm_add_epi32(sum0, OPL3_MixLanes128(v, mask0 >> ii));
+        sum1 = _mm_add_epi32(sum1, OPL3_MixLanes128(v, mask1 >> ii));
+    }
+    mix[0] = OPL3_MixSum128(sum0);
+    mix[1] = OPL3_MixSum128(sum1);
+}
+
+/* 0-15レーンを256bitで、16-23レーンを128bitで処理する */
+__attribute__((target("avx2")))
+static void OPL3_MixAVX2(const opl3_chip *chip, uint8_t pass, int32_t *mix)
+{
+    int16_t accm[OPL_MIX_LANES];
+    const __m256i bits = _mm256_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128,
+                                           0x100, 0x200, 0x400, 0x800,
+                                           0x1000, 0x2000, 0x4000, -0x8000);
+    const __m256i ones = _mm256_set1_epi16(1);
+    uint32_t mask0 = chip->mixmask[pass];
+    uint32_t mask1 = chip->mixmask[pass + 2];
+    __m256i v, m, sum0, sum1;
+    __m128i hi;
+
+    OPL3_MixGather(chip, accm);
+    v = _mm256_loadu_si256((const __m256i *)accm);
+    m = _mm256_and_si256(_mm256_set1_epi16((int16_t)mask0), bits);
+    m = _mm256_cmpeq_epi16(m, bits);
+    sum0 = _mm256_madd_epi16(_mm256_and_si256(v, m), ones);
+    m = _mm256_and_si256(_mm256_set1_epi16((int16_t)mask1), bits);
+    m = _mm256_cmpeq_epi16(m, bits);
+    sum1 = _mm256_madd_epi16(_mm256_and_si256(v, m), ones);
+
+    hi = _mm_loadu_si128((const __m128i *)&accm[16]);
+    mix[0] = OPL3_MixSum128(_mm_add_epi32(
+        _mm_add_epi32(_mm256_castsi256_si128(sum0), _mm256_extracti128_si256(sum0, 1)),
+        OPL3_MixLanes128(hi, mask0 >> 16)));
+    mix[1] = OPL3_MixSum128(_mm_add_epi32(
+        _mm_add_epi32(_mm256_castsi256_si128(sum1), _mm256_extracti128_si256(sum1, 1)),
+        OPL3_MixLanes128(hi, mask1 >> 16)));
+}
+
+/*
+ * CPUに合わせて1度だけ選ぶ(全チップ共通)。プログラムの初期化時
+ * (mainより前、スレッドを作る前)に選ぶので、以後opl3_mixは読むだけで
+ * 複数のスレッドからOPL3_Resetしても書き込みは競合しない。
+ */
+static opl3_mixfunc opl3_mix = OPL3_MixScalar;
+
+__attribute__((constructor))
+static void OPL3_MixSelect(void)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        opl3_mix = OPL3_MixAVX2;
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+        opl3_mix = OPL3_MixSSE2;
+    }
+}
+#endif
+
+/*
+ * サンプル生成のカーネル。リズムモード(0xBDのビット5)の有無で2つ作り、
+ * 0xBDへの書き込みでchip->generateを切り替える(OPL3_SelectKernel)。
+ * どちらもスロットのループにモードの分岐はない。
+ */
+#define OPL_KERNEL_RHYTHM       0
+#define OPL_KERNEL_FN(name)     name##Melodic
+#include "opl3_kernel.h"
+#undef OPL_KERNEL_RHYTHM
+#undef OPL_KERNEL_FN
+
+#define OPL_KERNEL_RHYTHM       1
+#define OPL_KERNEL_FN(name)     name##Rhythm
+#include "opl3_kernel.h"
+#undef OPL_KERNEL_RHYTHM
+#undef OPL_KERNEL_FN
+
+OPL_SHARED void OPL3_SelectKernel(opl3_chip *chip)
+{
+    chip->generate = (chip->rhy & 0x20) ? OPL3_Generate4ChRhythm : OPL3_Generate4ChMelodic;
+}
+
+void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
+{
+#if OPL_BANKED
+    /* 直接の書き込みは、その後の最初のサンプルの前に反映する */
+    if (chip->bank_pending)
+    {
+        OPL3_BankFlush(chip);
+    }
+#endif
+    chip->generate(chip, buf4);
+}
+
+void OPL3_Generate(opl3_chip *chip, int16_t *buf)
+{
+    int16_t samples[4];
+    OPL3_Generate4Ch(chip, samples);
+    buf[0] = samples[0];
+    buf[1] = samples[1];
+}
+
+#if OPL_RESAMPLE_FAST
+/*
+ * 除算なしの線形補間
+ * rsm_wはsamplecntと同じ刻みで動かし、常に
+ *   rsm_w * rateratio + rsm_wrem == samplecnt * 2^15 + rateratio / 2
+ * を保つ(rsm_wrem < rateratio)。samplecntからrateratioを引く時は
+ * rsm_wから2^15を引けばよく、補間時は0 <= rsm_w < 2^15になる。
+ */
+#define OPL3_RSM_LERP(o, n, w) \
+    ((int16_t)(((int32_t)(o) * (int32_t)((1UL << RSM_WBITS) - (w)) \
+                + (int32_t)(n) * (int32_t)(w) + (1L << (RSM_WBITS - 1))) >> RSM_WBITS))
+
+static void OPL3_ResampleFetch(opl3_chip *chip)
+{
+    while (chip->samplecnt >= chip->rateratio)
+    {
+        chip->oldsamples[0] = chip->samples[0];
+        chip->oldsamples[1] = chip->samples[1];
+        chip->oldsamples[2] = chip->samples[2];
+        chip->oldsamples[3] = chip->samples[3];
+        OPL3_Generate4Ch(chip, chip->samples);
+        chip->samplecnt -= chip->rateratio;
+        chip->rsm_w -= 1UL << RSM_WBITS;
+    }
+}
+
+static void OPL3_ResampleAdvance(opl3_chip *chip)
+{
+    chip->samplecnt += 1 << RSM_FRAC;
+    chip->rsm_w += chip->rsm_step;
+    chip->rsm_wrem += chip->rsm_steprem;
+    if (chip->rsm_wrem >= (uint16_t)chip->rateratio)
+    {
+        chip->rsm_wrem -= (uint16_t)chip->rateratio;
+        chip->rsm_w++;
+    }
+}
+
+void OPL3_Generate4ChResampled(opl3_chip *chip, int16_t *buf4)
+{
+    uint16_t w;
+
+    OPL3_ResampleFetch(chip);
+    w = (uint16_t)chip->rsm_w;
+    buf4[0] = OPL3_RSM_LERP(chip->oldsamples[0], chip->samples[0], w);
+    buf4[1] = OPL3_RSM_LERP(chip->oldsamples[1], chip->samples[1], w);
+    buf4[2] = OPL3_RSM_LERP(chip->oldsamples[2], chip->samples[2], w);
+    buf4[3] = OPL3_RSM_LERP(chip->oldsamples[3], chip->samples[3], w);
+    OPL3_ResampleAdvance(chip);
+}
+
+void OPL3_GenerateResampled(opl3_chip *chip, int16_t *buf)
+{
+    uint16_t w;
+
+    /* ステレオでは後ろの2チャンネルを補間しない */
+    OPL3_ResampleFetch(chip);
+    w = (uint16_t)chip->rsm_w;
+    buf[0] = OPL3_RSM_LERP(chip->oldsamples[0], chip->samples[0], w);
+    buf[1] = OPL3_RSM_LERP(chip->oldsamples[1], chip->samples[1], w);
+    OPL3_ResampleAdvance(chip);
+}
+#else
+void OPL3_Generate4ChResampled(opl3_chip *chip, int16_t *buf4)
+{
+    while (chip->samplecnt >= chip->rateratio)
+    {
+        chip->oldsamples[0] = chip->samples[0];
+        chip->oldsamples[1] = chip->samples[1];
+        chip->oldsamples[2] = chip->samples[2];
+        chip->oldsamples[3] = chip->samples[3];
+        OPL3_Generate4Ch(chip, chip->samples);
+        chip->samplecnt -= chip->rateratio;
+    }
+    buf4[0] = (int16_t)((chip->oldsamples[0] * (chip->rateratio - chip->samplecnt)
+                        + chip->samples[0] * chip->samplecnt) / chip->rateratio);
+    buf4[1] = (int16_t)((chip->oldsamples[1] * (chip->rateratio - chip->samplecnt)
+                        + chip->samples[1] * chip->samplecnt) / chip->rateratio);
+    buf4[2] = (int16_t)((chip->oldsamples[2] * (chip->rateratio - chip->samplecnt)
+                        + chip->samples[2] * chip->samplecnt) / chip->rateratio);
+    buf4[3] = (int16_t)((chip->oldsamples[3] * (chip->rateratio - chip->samplecnt)
+                        + chip->samples[3] * chip->samplecnt) / chip->rateratio);
+    chip->samplecnt += 1 << RSM_FRAC;
+}
+
+void OPL3_GenerateResampled(opl3_chip *chip, int16_t *buf)
+{
+    int16_t samples[4];
+    OPL3_Generate4ChResampled(chip, samples);
+    buf[0] = samples[0];
+    buf[1] = samples[1];
+}
+#endif
+#endif /* OPL_PART_RESIDENT */
+
+/*
+ * 公開API関数
+ */
+
+#if OPL_PART_PAGED
+/* チップのリセットと初期化 */
+void OPL_RESET(opl3_chip *chip, uint32_t samplerate)
+{
+    opl3_slot *slot;
+    opl3_channel *channel;
+    uint8_t slotnum;
+    uint8_t channum;
+    uint8_t local_ch_slot;
+
+#if OPL_WRITEBUF_GROW || OPL_STREAM_HOOK
+    /* 前のリセットから持っているヒープ(キューとストリームフック)を返す */
+    OPL3_Release(chip);
+#endif
+    /* すべてをゼロクリア */
+    memset(chip, 0, sizeof(opl3_chip));
+
+    /* スロットとチャンネルの初期化 */
+    for (slotnum = 0; slotnum < OPL_NUM_SLOTS; slotnum++)
+    {
+        slot = &chip->slot[slotnum];
+        slot->mod = OPL_SIG_ZERO;
+        slot->eg_rout = 0x1ff;
+        slot->eg_out = 0x1ff;
+        slot->eg_gen = envelope_gen_num_release;
+        slot->eg_idle = 1;
+        slot->slot_num = slotnum;
+    }
+    for (channum = 0; channum < OPL_NUM_CHANNELS; channum++)
+    {
+        channel = &chip->channel[channum];
+        local_ch_slot = ch_slot[channum];
+        chip->slot[local_ch_slot].ch_num = channum;
+        chip->slot[local_ch_slot + 3u].ch_num = channum;
+        OPL3_ChannelSetOut(channel, OPL_SIG_ZERO, OPL_SIG_ZERO, OPL_SIG_ZERO, OPL_SIG_ZERO);
+        channel->chtype = ch_2op;
+        channel->cha = 0xffff;
+        channel->chb = 0xffff;
+#if OPL_ENABLE_STEREOEXT
+        channel->leftpan = 0x10000;
+        channel->rightpan = 0x10000;
+#endif
+        channel->ch_num = channum;
+        OPL3_ChannelSetupAlg(chip, channel);
+#if OPL_MIX_SIMD
+        OPL3_ChannelUpdateMix(chip, channel);
+#endif
+    }
+    chip->noise = 1;
+    chip->writebuf_next = 0xffffffffUL;
+    /* サンプリングレートの設定 */
+    chip->rateratio = (samplerate << RSM_FRAC) / 49716;
+#if OPL_RESAMPLE_FAST
+    /* 生成中の除算をなくすため、重みの刻み幅をここで一度だけ求める */
+    chip->rsm_step = (1UL << (RSM_FRAC + RSM_WBITS)) / (uint32_t)chip->rateratio;
+    chip->rsm_steprem = (uint16_t)((1UL << (RSM_FRAC + RSM_WBITS)) % (uint32_t)chip->rateratio);
+    chip->rsm_wrem = (uint16_t)(chip->rateratio >> 1);
+#endif
+    chip->tremoloshift = 4;
+    chip->vibshift = 1;
+    OPL3_SelectKernel(chip);
+
+#if OPL_ENABLE_STEREOEXT
+    if (!panpot_lut_build)
+    {
+        int32_t i;
+        for (i = 0; i < 256; i++)
+        {
+            panpot_lut[i] = OPL_SIN(i);
+        }
+        panpot_lut_build = 1;
+    }
+#endif
+}
+
+/* レジスタ書き込み */
+void OPL_WRITEREG(opl3_chip *chip, uint16_t reg, uint8_t v)
+{
+    uint8_t high = (reg >> 8) & 0x01;
+    uint8_t regm = reg & 0xff;
+    opl3_slot *slot = 0;
+    opl3_channel *channel;
+    int8_t slotnum;
+
+#if OPL3_PROFILE_OPL2
+    /* 上位バンク(0x100-0x1FF)はない */
+    if (high)
+    {
+        return;
+    }
+#endif
+    /* 0x20-0x9F, 0xE0-0xFF: スロットレジスタ */
+    switch (regm & 0xf0)
+    {
+    case 0x20:
+    case 0x30:
+    case 0x40:
+    case 0x50:
+    case 0x60:
+    case 0x70:
+    case 0x80:
+    case 0x90:
+    case 0xe0:
+    case 0xf0:
+        slotnum = ad_slot[regm & 0x1fu];
+        if (slotnum < 0)
+        {
+            return;
+        }
+        slot = &chip->slot[(high ? 18u : 0u) + (uint8_t)slotnum];
+        break;
+    }
+
+    switch (regm & 0xf0)
+    {
+    case 0x00:
+#if !OPL3_PROFILE_OPL2
+        if (high)
+        {
+            switch (regm & 0x0f)
+            {
+            case 0x04:
+                OPL3_ChannelSet4Op(chip, v);
+                break;
+            case 0x05:
+                chip->newm = v & 0x01;
+#if OPL_ENABLE_STEREOEXT
+                chip->stereoext = (v >> 1) & 0x01;
+#endif
+                break;
+            }
+            break;
+        }
+#endif
+        switch (regm & 0x0f)
+        {
+        case 0x08:
+            chip->nts = (v >> 6) & 0x01;
+            break;
+        }
+        break;
+    case 0x20:
+    case 0x30:
+        OPL3_SlotWrite20(slot, v);
+        break;
+    case 0x40:
+    case 0x50:
+        OPL3_SlotWrite40(chip, slot, v);
+        break;
+    case 0x60:
+    case 0x70:
+        OPL3_SlotWrite60(slot, v);
+        break;
+    case 0x80:
+    case 0x90:
+        OPL3_SlotWrite80(slot, v);
+        break;
+    case 0xe0:
+    case 0xf0:
+        OPL3_SlotWriteE0(chip, slot, v);
+        break;
+    case 0xa0:
+        if ((regm & 0x0f) < 9)
+        {
+            OPL3_ChannelWriteA0(chip, &chip->channel[(high ? 9u : 0u) + (regm & 0x0fu)], v);
+        }
+        break;
+    case 0xb0:
+        if (regm == 0xbd && !high)
+        {
+            chip->tremoloshift = (((v >> 7) ^ 1) << 1) + 2;
+            chip->vibshift = ((v >> 6) & 0x01) ^ 1;
+            OPL3_ChannelUpdateRhythm(chip, v);
+        }
+        else if ((regm & 0x0f) < 9)
+        {
+            channel = &chip->channel[(high ? 9u : 0u) + (regm & 0x0fu)];
+            OPL3_ChannelWriteB0(chip, channel, v);
+            if (v & 0x20)
+            {
+                OPL3_ChannelKeyOn(chip, channel);
+            }
+            else
+            {
+                OPL3_ChannelKeyOff(chip, channel);
+            }
+        }
+        break;
+    case 0xc0:
+        if ((regm & 0x0f) < 9)
+        {
+            OPL3_ChannelWriteC0(chip, &chip->channel[(high ? 9u : 0u) + (regm & 0x0fu)], v);
+        }
+        break;
+#if OPL_ENABLE_STEREOEXT
+    case 0xd0:
+        if ((regm & 0x0f) < 9)
+        {
+            OPL3_ChannelWriteD0(chip, &chip->channel[(high ? 9u : 0u) + (regm & 0x0fu)], v);
+        }
+        break;
+#endif
+    }
+}
+#endif /* OPL_PART_PAGED */
+
+#if OPL_PART_RESIDENT
+#if OPL_BANK_PART
+/* 切り替える側を出して呼ぶ */
+void OPL3_Reset(opl3_chip *chip, uint32_t samplerate)
+{
+    OPL3_BankEnter();
+    OPL3_ResetPaged(chip, samplerate);
+    OPL3_BankLeave();
+}
+
+#if OPL_BANKED
+/* 次の生成までためる(一杯ならその場でデコードする) */
+void OPL3_WriteReg(opl3_chip *chip, uint16_t reg, uint8_t v)
+{
+    if (chip->bank_pending == OPL_BANK_PENDING)
+    {
+        OPL3_BankFlush(chip);
+    }
+    chip->bank_reg[chip->bank_pending] = reg;
+    chip->bank_data[chip->bank_pending] = v;
+    chip->bank_pending++;
+}
+#else
+void OPL3_WriteReg(opl3_chip *chip, uint16_t reg, uint8_t v)
+{
+    OPL3_WriteRegPaged(chip, reg, v);
+}
+#endif
+#endif
+
+/* バッファリングされたレジスタ書き込み(OPL_WRITEBUF_DELAYサンプル間隔で適用) */
+/*
+ * キューの末尾に空きを作る。処理済みの先頭を詰め、それでも足りなければ
+ * (OPL_WRITEBUF_GROWなら)倍に伸ばす。空きができなければ0を返す。
+ */
+static uint8_t OPL3_WriteBufMakeRoom(opl3_chip *chip)
+{
+#if OPL_WRITEBUF_GROW
+    opl3_writebuf *writebuf;
+    uint32_t size;
+#endif
+
+    if (chip->writebuf_head > 0)
+    {
+        memmove(chip->writebuf, &chip->writebuf[chip->writebuf_head],
+                (chip->writebuf_tail - chip->writebuf_head) * sizeof(opl3_writebuf));
+        chip->writebuf_tail -= chip->writebuf_head;
+        chip->writebuf_head = 0;
+        return 1;
+    }
+#if OPL_WRITEBUF_GROW
+    size = chip->writebuf_size ? (uint32_t)chip->writebuf_size * 2 : OPL_WRITEBUF_SIZE;
+    if (size > OPL_WRITEBUF_MAX)
+    {
+        return 0;
+    }
+    writebuf = realloc(chip->writebuf, size * sizeof(opl3_writebuf));
+    if (!writebuf)
+    {
+        return 0;
+    }
+    chip->writebuf = writebuf;
+    chip->writebuf_size = (uint16_t)size;
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * バッファリング書き込み
+ * キューが一杯なら(元の実装のように古いエントリを早めに書き込まず)
+ * OPL_WRITEBUF_FULLを返す。呼び出し側でサンプルを生成してから再試行する。
+ */
+uint8_t OPL3_WriteRegBuffered(opl3_chip *chip, uint16_t reg, uint8_t v)
+{
+    uint32_t time1, time2;
+    opl3_writebuf *writebuf;
+
+#if OPL_WRITEBUF_GROW
+    if (chip->writebuf_tail == chip->writebuf_size && !OPL3_WriteBufMakeRoom(chip))
+#else
+    if (chip->writebuf_tail == OPL_WRITEBUF_SIZE && !OPL3_WriteBufMakeRoom(chip))
+#endif
+    {
+        chip->writebuf_overflow++;
+        return OPL_WRITEBUF_FULL;
+    }
+
+    time1 = chip->writebuf_lasttime + OPL_WRITEBUF_DELAY;
+    time2 = chip->writebuf_samplecnt;
+
+    if (time1 < time2)
+    {
+        time1 = time2;
+    }
+
+    writebuf = &chip->writebuf[chip->writebuf_tail++];
+    writebuf->time = time1;
+    writebuf->reg = reg & 0x1ff;
+    writebuf->data = v;
+    chip->writebuf_lasttime = time1;
+    if (chip->writebuf_tail - chip->writebuf_head == 1)
+    {
+        chip->writebuf_next = time1;
+    }
+    return OPL_WRITEBUF_OK;
+}
+
+void OPL3_Init(opl3_chip *chip, uint32_t samplerate)
+{
+    memset(chip, 0, sizeof(opl3_chip));
+    OPL3_Reset(chip, samplerate);
+}
+
+void OPL3_Release(opl3_chip *chip)
+{
+#if OPL_STREAM_HOOK
+    if (chip->streamhook)
+    {
+        chip->streamhook->release(chip->streamhook);
+        chip->streamhook = 0;
+    }
+#endif
+#if OPL_WRITEBUF_GROW
+    free(chip->writebuf);
+    chip->writebuf = 0;
+    chip->writebuf_size = 0;
+#endif
+    chip->writebuf_head = 0;
+    chip->writebuf_tail = 0;
+    chip->writebuf_next = 0xffffffffUL;
+}
+
+/* 4チャンネルストリーム生成 */
+void OPL3_Generate4ChStream(opl3_chip *chip, int16_t *sndptr1, int16_t *sndptr2, uint32_t numsamples)
+{
+    uint32_t i;
+    int16_t samples[4];
+
+#if OPL_STREAM_HOOK
+    if (chip->streamhook)
+    {
+        chip->streamhook->stream(chip->streamhook, chip, sndptr1, sndptr2, numsamples);
+        return;
+    }
+#endif
+    /* ためた直接の書き込みとキューから呼ぶデコーダーのバンクはブロックの出入り口だけで切り替える */
+    OPL3_BankEnter();
+    for (i = 0; i < numsamples; i++)
+    {
+        OPL3_Generate4ChResampled(chip, samples);
+        sndptr1[0] = samples[0];
+        sndptr1[1] = samples[1];
+        sndptr2[0] = samples[2];
+        sndptr2[1] = samples[3];
+        sndptr1 += 2;
+        sndptr2 += 2;
+    }
+    OPL3_BankLeave();
+}
+
+/* ストリーム生成 */
+void OPL3_GenerateStream(opl3_chip *chip, int16_t *sndptr, uint32_t numsamples)
+{
+    uint32_t i;
+
+#if OPL_STREAM_HOOK
+    if (chip->streamhook)
+    {
+        chip->streamhook->stream(chip->streamhook, chip, sndptr, 0, numsamples);
+        return;
+    }
+#endif
+    OPL3_BankEnter();
+    for (i = 0; i < numsamples; i++)
+    {
+        OPL3_GenerateResampled(chip, sndptr);
+        sndptr += 2;
+    }
+    OPL3_BankLeave();
+}
+
+#if OPL3_PROFILE
+void OPL3_GetProfile(const opl3_chip *chip, opl3_profile *stats)
+{
+    memcpy(stats, &chip->profile, sizeof(opl3_profile));
+}
+
+void OPL3_ClearProfile(opl3_chip *chip)
+{
+    memset(&chip->profile, 0, sizeof(opl3_profile));
+}
+#endif
+
+#if OPL_SAVESTATE
+/*
+ * 状態の保存と復元
+ *
+ * 各フィールドをリトルエンディアンで決まった順に並べる。slot_num/ch_num は
+ * OPL3_Resetで決まる定数、writebuf_nextとmixmaskとrsm_*は他の値から
+ * 求め直せるので保存しない。接続(slot->mod, channel->out)は書き込みの
+ * 履歴に依存する(例えば4opを解除してもC0を書くまで前の接続が残る)ので、
+ * レジスタから組み直さずに値として保存する。
+ */
+#define OPL_STATE_HEADER    8
+#define OPL_STATE_SLOT      30
+#define OPL_STATE_CHANNEL   (13 + 8 * OPL_ENABLE_STEREOEXT)
+#define OPL_STATE_CHIP      (80 + 2 * OPL_SIG_NUM + OPL_ENABLE_STEREOEXT)
+#define OPL_STATE_WRITE     7
+#define OPL_STATE_FIXED     (OPL_STATE_HEADER + OPL_NUM_SLOTS * OPL_STATE_SLOT \
+                             + OPL_NUM_CHANNELS * OPL_STATE_CHANNEL + OPL_STATE_CHIP)
+/* チップ部分の先頭からvibshift、tremoloshift、rateratioまでのバイト数 */
+#define OPL_STATE_VIBSHIFT  16
+#define OPL_STATE_TREMSHIFT 19
+#define OPL_STATE_RATERATIO (46 + 2 * OPL_SIG_NUM + OPL_ENABLE_STEREOEXT)
+/* ヘッダーの構成バイト(bit0: ステレオ拡張, bit1: OPL2専用) */
+#define OPL_STATE_CONFIG    (OPL_ENABLE_STEREOEXT | (OPL3_PROFILE_OPL2 << 1))
+
+static uint8_t *OPL3_StatePut16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t *OPL3_StatePut32(uint8_t *p, uint32_t v)
+{
+    p = OPL3_StatePut16(p, (uint16_t)v);
+    return OPL3_StatePut16(p, (uint16_t)(v >> 16));
+}
+
+static uint16_t OPL3_StateGet16(const uint8_t **p)
+{
+    uint16_t v = (uint16_t)((*p)[0] | ((uint16_t)(*p)[1] << 8));
+
+    *p += 2;
+    return v;
+}
+
+static uint32_t OPL3_StateGet32(const uint8_t **p)
+{
+    uint32_t v = OPL3_StateGet16(p);
+
+    return v | ((uint32_t)OPL3_StateGet16(p) << 16);
+}
+
+uint32_t OPL3_StateSize(const opl3_chip *chip)
+{
+    return OPL_STATE_FIXED
+         + (uint32_t)(chip->writebuf_tail - chip->writebuf_head) * OPL_STATE_WRITE;
+}
+
+uint32_t OPL3_SaveState(const opl3_chip *chip, uint8_t *buf, uint32_t size)
+{
+    const opl3_slot *slot;
+    const opl3_channel *channel;
+    const opl3_writebuf *writebuf;
+    uint8_t *p = buf;
+    uint16_t i;
+
+    if (size < OPL3_StateSize(chip))
+    {
+        return 0;
+    }
+#if OPL_BANKED
+    /* ためている書き込みは保存する前にデコードする(出力は変わらない) */
+    if (chip->bank_pending)
+    {
+        OPL3_BankFlush((opl3_chip *)chip);
+    }
+#endif
+    memcpy(p, "OPL3", 4);
+    p[4] = OPL_STATE_VERSION;
+    p[5] = OPL_STATE_CONFIG;
+    p = OPL3_StatePut16(p + 6, (uint16_t)(chip->writebuf_tail - chip->writebuf_head));
+
+    for (i = 0; i < OPL_NUM_SLOTS; i++)
+    {
+        slot = &chip->slot[i];
+        p = OPL3_StatePut32(p, slot->pg_phase);
+        p = OPL3_StatePut16(p, slot->pg_phase_out);
+        p = OPL3_StatePut16(p, slot->eg_rout);
+        p = OPL3_StatePut16(p, slot->eg_out);
+        p = OPL3_StatePut16(p, (uint16_t)slot->prout);
+        *p++ = slot->mod;
+        *p++ = slot->eg_gen;
+        *p++ = slot->eg_idle;
+        *p++ = slot->eg_ksl;
+        *p++ = slot->reg_am;
+        *p++ = slot->reg_vib;
+        *p++ = slot->reg_type;
+        *p++ = slot->reg_ksr;
+        *p++ = slot->reg_mult;
+        *p++ = slot->reg_ksl;
+        *p++ = slot->reg_tl;
+        *p++ = slot->reg_ar;
+        *p++ = slot->reg_dr;
+        *p++ = slot->reg_sl;
+        *p++ = slot->reg_rr;
+        *p++ = slot->reg_wf;
+        *p++ = slot->key;
+        *p++ = slot->pg_reset;
+    }
+    for (i = 0; i < OPL_NUM_CHANNELS; i++)
+    {
+        channel = &chip->channel[i];
+        p = OPL3_StatePut16(p, channel->f_num);
+        /* cha-chdは0か0xffffなので1bitずつ */
+#if OPL3_PROFILE_OPL2
+        *p++ = (uint8_t)((channel->cha & 0x01) | ((channel->chb & 0x01) << 1));
+#else
+        *p++ = (uint8_t)((channel->cha & 0x01) | ((channel->chb & 0x01) << 1)
+                       | ((channel->chc & 0x01) << 2) | ((channel->chd & 0x01) << 3));
+#endif
+        memcpy(p, channel->out, 4);
+        p += 4;
+        *p++ = channel->chtype;
+        *p++ = channel->block;
+        *p++ = channel->fb;
+        *p++ = channel->con;
+        *p++ = channel->alg;
+        *p++ = channel->ksv;
+#if OPL_ENABLE_STEREOEXT
+        p = OPL3_StatePut32(p, (uint32_t)channel->leftpan);
+        p = OPL3_StatePut32(p, (uint32_t)channel->rightpan);
+#endif
+    }
+
+    p = OPL3_StatePut16(p, chip->timer);
+    p = OPL3_StatePut16(p, chip->eg_timer);
+    p = OPL3_StatePut32(p, chip->eg_timerhi);
+    *p++ = chip->eg_timerrem;
+    *p++ = chip->eg_state;
+    *p++ = chip->eg_add;
+    *p++ = chip->eg_timer_lo;
+#if OPL3_PROFILE_OPL2
+    *p++ = 0;
+#else
+    *p++ = chip->newm;
+#endif
+    *p++ = chip->nts;
+    *p++ = chip->rhy;
+    *p++ = chip->vibpos;
+    *p++ = chip->vibshift;
+    *p++ = chip->tremolo;
+    *p++ = chip->tremolopos;
+    *p++ = chip->tremoloshift;
+    p = OPL3_StatePut32(p, chip->noise);
+    for (i = 0; i < OPL_SIG_NUM; i++)
+    {
+        p = OPL3_StatePut16(p, (uint16_t)chip->sig[i]);
+    }
+    for (i = 0; i < 4; i++)
+    {
+        p = OPL3_StatePut32(p, (uint32_t)chip->mixbuff[i]);
+    }
+    *p++ = chip->rm_hh_bit2;
+    *p++ = chip->rm_hh_bit3;
+    *p++ = chip->rm_hh_bit7;
+    *p++ = chip->rm_hh_bit8;
+    *p++ = chip->rm_tc_bit3;
+    *p++ = chip->rm_tc_bit5;
+#if OPL_ENABLE_STEREOEXT
+    *p++ = chip->stereoext;
+#endif
+    p = OPL3_StatePut32(p, (uint32_t)chip->rateratio);
+    p = OPL3_StatePut32(p, (uint32_t)chip->samplecnt);
+    for (i = 0; i < 4; i++)
+    {
+        p = OPL3_StatePut16(p, (uint16_t)chip->oldsamples[i]);
+    }
+    for (i = 0; i < 4; i++)
+    {
+        p = OPL3_StatePut16(p, (uint16_t)chip->samples[i]);
+    }
+    p = OPL3_StatePut32(p, chip->writebuf_samplecnt);
+    p = OPL3_StatePut32(p, chip->writebuf_lasttime);
+    p = OPL3_StatePut16(p, chip->writebuf_overflow);
+
+    for (i = chip->writebuf_head; i < chip->writebuf_tail; i++)
+    {
+        writebuf = &chip->writebuf[i];
+        p = OPL3_StatePut32(p, writebuf->time);
+        p = OPL3_StatePut16(p, writebuf->reg);
+        *p++ = writebuf->data;
+    }
+    return (uint32_t)(p - buf);
+}
+
+/*
+ * 書き換える前に、書式と、配列の添字になる接続、シフト量になる
+ * vibshiftとtremoloshift(0xBDの書き込みで作れる値だけ)、rateratioを検査する
+ */
+static uint8_t OPL3_StateCheck(const uint8_t *buf, uint32_t size, uint16_t *numwrites)
+{
+    const uint8_t *p;
+    uint16_t i;
+    uint8_t j;
+
+    if (size < OPL_STATE_HEADER)
+    {
+        return OPL_STATE_SHORT;
+    }
+    if (memcmp(buf, "OPL3", 4) != 0 || buf[4] != OPL_STATE_VERSION
+     || buf[5] != OPL_STATE_CONFIG)
+    {
+        return OPL_STATE_BADFORMAT;
+    }
+    p = buf + 6;
+    *numwrites = OPL3_StateGet16(&p);
+    if (size < OPL_STATE_FIXED + (uint32_t)*numwrites * OPL_STATE_WRITE)
+    {
+        return OPL_STATE_SHORT;
+    }
+    for (i = 0; i < OPL_NUM_SLOTS; i++)
+    {
+        if (p[i * OPL_STATE_SLOT + 12] >= OPL_SIG_NUM)
+        {
+            return OPL_STATE_BADFORMAT;
+        }
+    }
+    p += OPL_NUM_SLOTS * OPL_STATE_SLOT;
+    for (i = 0; i < OPL_NUM_CHANNELS; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            if (p[i * OPL_STATE_CHANNEL + 3 + j] >= OPL_SIG_NUM)
+            {
+                return OPL_STATE_BADFORMAT;
+            }
+        }
+    }
+    p += OPL_NUM_CHANNELS * OPL_STATE_CHANNEL;
+    if (p[OPL_STATE_VIBSHIFT] > 1
+     || (p[OPL_STATE_TREMSHIFT] != 2 && p[OPL_STATE_TREMSHIFT] != 4))
+    {
+        return OPL_STATE_BADFORMAT;
+    }
+    p += OPL_STATE_RATERATIO;
+    if ((int32_t)OPL3_StateGet32(&p) <= 0)
+    {
+        return OPL_STATE_BADFORMAT;
+    }
+#if !OPL_WRITEBUF_GROW
+    if (*numwrites > OPL_WRITEBUF_SIZE)
+    {
+        return OPL_STATE_FULL;
+    }
+#endif
+    return OPL_STATE_OK;
+}
+
+uint8_t OPL3_CheckState(opl3_chip *chip, const uint8_t *buf, uint32_t size)
+{
+#if OPL_WRITEBUF_GROW
+    opl3_writebuf *writebuf;
+#endif
+    uint16_t numwrites = 0;
+    uint8_t err;
+
+    err = OPL3_StateCheck(buf, size, &numwrites);
+    if (err != OPL_STATE_OK)
+    {
+        return err;
+    }
+#if OPL_WRITEBUF_GROW
+    /* キューの領域を先に確保する(失敗してもチップはそのまま) */
+    if (numwrites > chip->writebuf_size)
+    {
+        if (numwrites > OPL_WRITEBUF_MAX)
+        {
+            return OPL_STATE_FULL;
+        }
+        writebuf = realloc(chip->writebuf, numwrites * sizeof(opl3_writebuf));
+        if (!writebuf)
+        {
+            return OPL_STATE_FULL;
+        }
+        chip->writebuf = writebuf;
+        chip->writebuf_size = numwrites;
+    }
+#else
+    (void)chip;
+#endif
+    return OPL_STATE_OK;
+}
+
+uint8_t OPL3_LoadState(opl3_chip *chip, const uint8_t *buf, uint32_t size)
+{
+    opl3_slot *slot;
+    opl3_channel *channel;
+    opl3_writebuf *writebuf;
+    const uint8_t *p;
+    uint16_t i, numwrites;
+    uint8_t err, flags;
+
+    err = OPL3_CheckState(chip, buf, size);
+    if (err != OPL_STATE_OK)
+    {
+        return err;
+    }
+    p = buf + 6;
+    numwrites = OPL3_StateGet16(&p);
+    p = buf + OPL_STATE_HEADER;
+#if OPL_BANKED
+    /* 復元する状態で上書きされるので、ためている書き込みは捨てる */
+    chip->bank_pending = 0;
+#endif
+
+    /* 表の添字になる値は書き込み時と同じビット幅に丸める */
+    for (i = 0; i < OPL_NUM_SLOTS; i++)
+    {
+        slot = &chip->slot[i];
+        slot->pg_phase = OPL3_StateGet32(&p);
+        slot->pg_phase_out = OPL3_StateGet16(&p);
+        slot->eg_rout = OPL3_StateGet16(&p) & 0x1ff;
+        slot->eg_out = OPL3_StateGet16(&p);
+        slot->prout = (int16_t)OPL3_StateGet16(&p);
+        slot->mod = *p++;
+        slot->eg_gen = *p++ & 0x03;
+        slot->eg_idle = *p++;
+        slot->eg_ksl = *p++;
+        slot->reg_am = *p++;
+        slot->reg_vib = *p++ & 0x01;
+        slot->reg_type = *p++ & 0x01;
+        slot->reg_ksr = *p++ & 0x01;
+        slot->reg_mult = *p++ & 0x0f;
+        slot->reg_ksl = *p++ & 0x03;
+        slot->reg_tl = *p++ & 0x3f;
+        slot->reg_ar = *p++ & 0x0f;
+        slot->reg_dr = *p++ & 0x0f;
+        slot->reg_sl = *p++ & 0x1f;
+        slot->reg_rr = *p++ & 0x0f;
+        slot->reg_wf = *p++ & (OPL_NUM_WAVEFORMS - 1);
+        slot->key = *p++;
+        slot->pg_reset = *p++;
+    }
+    for (i = 0; i < OPL_NUM_CHANNELS; i++)
+    {
+        channel = &chip->channel[i];
+        channel->f_num = OPL3_StateGet16(&p) & 0x3ff;
+        flags = *p++;
+        channel->cha = (flags & 0x01) ? 0xffff : 0;
+        channel->chb = (flags & 0x02) ? 0xffff : 0;
+#if !OPL3_PROFILE_OPL2
+        channel->chc = (flags & 0x04) ? 0xffff : 0;
+        channel->chd = (flags & 0x08) ? 0xffff : 0;
+#endif
+        memcpy(channel->out, p, 4);
+        p += 4;
+        channel->chtype = *p++ & 0x03;
+        channel->block = *p++ & 0x07;
+        channel->fb = *p++ & 0x07;
+        channel->con = *p++ & 0x01;
+        channel->alg = *p++ & 0x0f;
+        channel->ksv = *p++ & 0x0f;
+#if OPL_ENABLE_STEREOEXT
+        channel->leftpan = (int32_t)OPL3_StateGet32(&p);
+        channel->rightpan = (int32_t)OPL3_StateGet32(&p);
+#endif
+#if OPL_MIX_SIMD
+        OPL3_ChannelUpdateMix(chip, channel);
+#endif
+    }
+
+    chip->timer = OPL3_StateGet16(&p);
+    chip->eg_timer = OPL3_StateGet16(&p);
+    chip->eg_timerhi = OPL3_StateGet32(&p);
+    chip->eg_timerrem = *p++;
+    chip->eg_state = *p++;
+    chip->eg_add = *p++;
+    chip->eg_timer_lo = *p++ & 0x03;
+#if OPL3_PROFILE_OPL2
+    p++;
+#else
+    chip->newm = *p++ & 0x01;
+#endif
+    chip->nts = *p++ & 0x01;
+    chip->rhy = *p++ & 0x3f;
+    OPL3_SelectKernel(chip);
+    chip->vibpos = *p++ & 0x07;
+    chip->vibshift = *p++;
+    chip->tremolo = *p++;
+    chip->tremolopos = *p++;
+    chip->tremoloshift = *p++;
+    chip->noise = OPL3_StateGet32(&p);
+    for (i = 0; i < OPL_SIG_NUM; i++)
+    {
+        chip->sig[i] = (int16_t)OPL3_StateGet16(&p);
+    }
+    for (i = 0; i < 4; i++)
+    {
+        chip->mixbuff[i] = (int32_t)OPL3_StateGet32(&p);
+    }
+    chip->rm_hh_bit2 = *p++;
+    chip->rm_hh_bit3 = *p++;
+    chip->rm_hh_bit7 = *p++;
+    chip->rm_hh_bit8 = *p++;
+    chip->rm_tc_bit3 = *p++;
+    chip->rm_tc_bit5 = *p++;
+#if OPL_ENABLE_STEREOEXT
+    chip->stereoext = *p++ & 0x01;
+#endif
+    chip->rateratio = (int32_t)OPL3_StateGet32(&p);
+    chip->samplecnt = (int32_t)OPL3_StateGet32(&p);
+#if OPL_RESAMPLE_FAST
+    /* OPL3_Resetと同じ刻み幅と、samplecntに対応する重み */
+    chip->rsm_step = (1UL << (RSM_FRAC + RSM_WBITS)) / (uint32_t)chip->rateratio;
+    chip->rsm_steprem = (uint16_t)((1UL << (RSM_FRAC + RSM_WBITS)) % (uint32_t)chip->rateratio);
+    chip->rsm_w = (((uint32_t)chip->samplecnt << RSM_WBITS) + ((uint32_t)chip->rateratio >> 1))
+                / (uint32_t)chip->rateratio;
+    chip->rsm_wrem = (uint16_t)((((uint32_t)chip->samplecnt << RSM_WBITS)
+                   + ((uint32_t)chip->rateratio >> 1)) % (uint32_t)chip->rateratio);
+#endif
+    for (i = 0; i < 4; i++)
+    {
+        chip->oldsamples[i] = (int16_t)OPL3_StateGet16(&p);
+    }
+    for (i = 0; i < 4; i++)
+    {
+        chip->samples[i] = (int16_t)OPL3_StateGet16(&p);
+    }
+    chip->writebuf_samplecnt = OPL3_StateGet32(&p);
+    chip->writebuf_lasttime = OPL3_StateGet32(&p);
+    chip->writebuf_overflow = OPL3_StateGet16(&p);
+
+    chip->writebuf_head = 0;
+    chip->writebuf_tail = numwrites;
+    chip->writebuf_next = 0xffffffffUL;
+    for (i = 0; i < numwrites; i++)
+    {
+        writebuf = &chip->writebuf[i];
+        writebuf->time = OPL3_StateGet32(&p);
+        writebuf->reg = OPL3_StateGet16(&p) & 0x1ff;
+        writebuf->data = *p++;
+    }
+    if (numwrites)
+    {
+        chip->writebuf_next = chip->writebuf[0].time;
+    }
+    return OPL_STATE_OK;
+}
+#endif
+#endif /* OPL_PART_RESIDENT */
@@ -0,0 +1,65 @@
+/*
+ * Nuked OPL3 - z88dk port
+ *
+ * バンク切り替えメモリへの配置(OPL_BANKED)
+ *
+ * src/opl3.c はOPL_BANK_PARTで2つの翻訳単位に分けてコンパイルできます。
+ *   0: 全部(既定)
+ *   1: 常駐側。サンプル生成と毎サンプル引く表、書き込みキュー、状態の保存
+ *   2: 切り替える側。レジスタのデコード、リセット、書き込み時だけ引く表
+ * 常駐側は切り替える側の関数を、OPL3_BankEnterとOPL3_BankLeaveの間
+ * (ストリーム生成1回とOPL3_Resetの出入り口、1サンプル単位の生成で
+ * デコードするものがある時)だけで呼びます。OPL3_WriteRegはチップに
+ * ためて、次の生成の先頭でデコードします。
+ *
+ * OPL_BANK_MAPに関数名を定義すると機種ごとの切り替えを差し替えられます。
+ * 関数は uint8_t name(uint8_t bank) で、bankを出してそれまでの番号を返します。
+ */
+
+#ifndef OPL3_BANK_H
+#define OPL3_BANK_H
+
+#include "opl3.h"
+
+#ifndef OPL_BANK_PART
+#define OPL_BANK_PART       0
+#endif
+#define OPL_PART_RESIDENT   (OPL_BANK_PART != 2)
+#define OPL_PART_PAGED      (OPL_BANK_PART != 1)
+
+#if OPL_BANKED && !OPL_BANK_PART
+#error "OPL_BANKED requires building src/opl3.c twice with OPL_BANK_PART=1 and 2"
+#endif
+#if OPL_BANK_PART && OPL_MIX_SIMD
+#error "OPL_BANK_PART cannot be combined with OPL_MIX_SIMD"
+#endif
+
+#if OPL_BANK_PART
+/* 両方の側から呼ぶ関数(分けない場合はstatic) */
+#define OPL_SHARED
+
+/* 切り替える側の本体。常駐側の公開関数がバンクを出して呼ぶ */
+void OPL3_ResetPaged(opl3_chip *chip, uint32_t samplerate);
+void OPL3_WriteRegPaged(opl3_chip *chip, uint16_t reg, uint8_t v);
+#define OPL_RESET           OPL3_ResetPaged
+#define OPL_WRITEREG        OPL3_WriteRegPaged
+#else
+#define OPL_SHARED          static
+#define OPL_RESET           OPL3_Reset
+#define OPL_WRITEREG        OPL3_WriteReg
+#endif
+
+/*
+ * 切り替える側のバンク番号。MSXでは定義しなければOPL3_BankLoadが
+ * 実行時に決める(MSX-DOS2のマッパーサポートで確保、なければセグメント4)
+ */
+#if OPL_BANKED
+#if OPL_BANKED == 1 && !defined(OPL_BANK_NUM)
+#define OPL_BANK_NUM        6   /* ZX Spectrum 128K: RAMバンク6 */
+#endif
+#ifdef OPL_BANK_MAP
+uint8_t OPL_BANK_MAP(uint8_t bank);
+#endif
+#endif
+
+#endif /* OPL3_BANK_H */
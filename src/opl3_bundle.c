@@ -0,0 +1,379 @@
+/*
+ * Nuked OPL3 - cross-chip SIMD bundle (host only)
+ *
+ * 状態はすべて [スロット][レーン] の32bit配列で持ち、カーネル
+ * (src/opl3_bundle_kernel.h)はそれをGCCのベクトル型で読み書きします。
+ * OPL3_EnvelopeCalc等の分岐はマスク演算による選択に置き換えてあるので、
+ * 1つの演算がそのままSSE2(4レーン)/AVX2(8レーン)/AVX-512(16レーン)の
+ * 1命令になります。テーブル参照(波形、指数変換、変調入力、出力の集約)だけは
+ * レーンごとのループで引きます。
+ *
+ * レジスタ書き込みはレーンごとのopl3_chip(chip[])にOPL3_WriteRegで
+ * デコードさせ、次の生成の前にレジスタ由来の値だけを配列に写します。
+ * 書き込みはエンベロープや位相の状態に触れないので、これで単体の
+ * opl3_chipと同じ結果になります。
+ *
+ * 処理順はOPL3_Generate4Ch(OPL_QUIRK_CHANNELSAMPLEDELAYあり)と同じです。
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "opl3_bundle.h"
+#include "opl3_tables.h"
+
+#if OPL_ENABLE_STEREOEXT || !OPL_WAVETAB_LARGE || OPL3_PROFILE_OPL2
+#error "opl3_bundle requires the default host configuration (no STEREOEXT, large wavetab, full OPL3)"
+#endif
+#ifndef __GNUC__
+#error "opl3_bundle requires GCC vector extensions"
+#endif
+#if OPL_BUNDLE_LANES % 8 != 0 || OPL_BUNDLE_LANES > 32
+#error "OPL_BUNDLE_LANES must be 8, 16, 24 or 32"
+#endif
+
+#define OPL_BUNDLE_ALIGN    64
+
+#if defined(__x86_64__) || defined(__i386__)
+#define OPL_BUNDLE_X86      1
+#else
+#define OPL_BUNDLE_X86      0
+#endif
+/* AVX-512のカーネルは16レーン単位なので、レーン数が16の倍数の時だけ作る */
+#define OPL_BUNDLE_AVX512   (OPL_BUNDLE_X86 && OPL_BUNDLE_LANES % 16 == 0)
+#define OPL_BUNDLE_INLINE   static inline __attribute__((always_inline))
+
+typedef int32_t opl3_vec4 __attribute__((vector_size(16), may_alias));
+typedef uint32_t opl3_uvec4 __attribute__((vector_size(16), may_alias));
+typedef int32_t opl3_vec8 __attribute__((vector_size(32), may_alias));
+typedef uint32_t opl3_uvec8 __attribute__((vector_size(32), may_alias));
+typedef int32_t opl3_vec16 __attribute__((vector_size(64), may_alias));
+typedef uint32_t opl3_uvec16 __attribute__((vector_size(64), may_alias));
+
+/* m: 比較結果(0/-1)のマスク */
+#define OPL_SEL(m, a, b)    (((m) & (a)) | (~(m) & (b)))
+
+enum {
+    eg_attack = 0,
+    eg_decay = 1,
+    eg_sustain = 2,
+    eg_release = 3
+};
+
+/* eg_incstep[rate_lo][eg_timer_lo]を (rate_lo << 2 | eg_timer_lo) 番目のビットで持つ */
+#define OPL_BUNDLE_INCSTEP  0x7510
+
+#define OPL_BUNDLE_VEC(name)    int32_t name[OPL_BUNDLE_LANES]
+
+typedef struct {
+    /* レジスタ由来の値(書き込み後にchip[]から写す) */
+    OPL_BUNDLE_VEC(eg_base);        /* (tl << 2) + ksl減衰 */
+    OPL_BUNDLE_VEC(reg_am);
+    OPL_BUNDLE_VEC(reg_ar);
+    OPL_BUNDLE_VEC(reg_dr);
+    OPL_BUNDLE_VEC(reg_sl);
+    OPL_BUNDLE_VEC(reg_rr);
+    OPL_BUNDLE_VEC(reg_type);       /* 0/-1 */
+    OPL_BUNDLE_VEC(reg_vib);        /* 0/-1 */
+    OPL_BUNDLE_VEC(key);
+    OPL_BUNDLE_VEC(ks);
+    OPL_BUNDLE_VEC(f_num);
+    OPL_BUNDLE_VEC(block);
+    OPL_BUNDLE_VEC(mult);           /* mt[reg_mult] */
+    OPL_BUNDLE_VEC(wave);           /* reg_wf * 1024 */
+    OPL_BUNDLE_VEC(fb);
+
+    /* 生成で変わる状態 */
+    uint32_t pg_phase[OPL_BUNDLE_LANES];
+    OPL_BUNDLE_VEC(pg_phase_out);
+    OPL_BUNDLE_VEC(pg_reset);       /* 0/-1 */
+    OPL_BUNDLE_VEC(eg_rout);
+    OPL_BUNDLE_VEC(eg_out);
+    OPL_BUNDLE_VEC(eg_gen);
+    OPL_BUNDLE_VEC(prout);
+} opl3_bundleslot;
+
+struct _opl3_bundle {
+    opl3_bundleslot slot[36];
+    int32_t sig[OPL_SIG_NUM][OPL_BUNDLE_LANES];
+    int32_t mixbuff[4][OPL_BUNDLE_LANES];
+    int32_t chmask[4][18][OPL_BUNDLE_LANES];    /* cha/chb/chc/chd (0/-1) */
+    OPL_BUNDLE_VEC(tremoloshift);
+    OPL_BUNDLE_VEC(vibshift);
+    OPL_BUNDLE_VEC(rhy);                        /* 0/-1 (リズムモード) */
+    uint32_t noise[OPL_BUNDLE_LANES];
+    OPL_BUNDLE_VEC(eg_state);
+    OPL_BUNDLE_VEC(eg_add);
+    OPL_BUNDLE_VEC(eg_timer_lo);
+    OPL_BUNDLE_VEC(timer);
+    OPL_BUNDLE_VEC(vibpos);
+    OPL_BUNDLE_VEC(tremolo);
+    OPL_BUNDLE_VEC(tremolopos);
+    OPL_BUNDLE_VEC(rm_hh_bit2);
+    OPL_BUNDLE_VEC(rm_hh_bit3);
+    OPL_BUNDLE_VEC(rm_hh_bit7);
+    OPL_BUNDLE_VEC(rm_hh_bit8);
+    OPL_BUNDLE_VEC(rm_tc_bit3);
+    OPL_BUNDLE_VEC(rm_tc_bit5);
+    uint32_t eg_timerhi[OPL_BUNDLE_LANES];
+    uint16_t eg_timer[OPL_BUNDLE_LANES];
+    uint8_t eg_timerrem[OPL_BUNDLE_LANES];
+    /* sigを平らにした配列でのインデックス(番号 * レーン数 + レーン) */
+    uint16_t mod[36][OPL_BUNDLE_LANES];
+    uint16_t out[18][4][OPL_BUNDLE_LANES];
+
+    /* レジスタのデコード用 */
+    uint32_t dirty;                             /* 写していないレーンのビット */
+    opl3_chip chip[OPL_BUNDLE_LANES];
+} __attribute__((aligned(OPL_BUNDLE_ALIGN)));
+
+/* chip[lane]のレジスタ由来の値を配列に写す */
+static void OPL3_BundleSync(opl3_bundle *bundle, uint8_t lane)
+{
+    const opl3_chip *chip = &bundle->chip[lane];
+    const opl3_slot *slot;
+    const opl3_channel *channel;
+    opl3_bundleslot *bslot;
+    uint8_t s, ch, i;
+
+    for (s = 0; s < 36; s++)
+    {
+        slot = &chip->slot[s];
+        channel = &chip->channel[slot->ch_num];
+        bslot = &bundle->slot[s];
+        bslot->eg_base[lane] = (slot->reg_tl << 2) + (slot->eg_ksl >> kslshift[slot->reg_ksl]);
+        bslot->reg_am[lane] = slot->reg_am;
+        bslot->reg_ar[lane] = slot->reg_ar;
+        bslot->reg_dr[lane] = slot->reg_dr;
+        bslot->reg_sl[lane] = slot->reg_sl;
+        bslot->reg_rr[lane] = slot->reg_rr;
+        bslot->reg_type[lane] = -(int32_t)(slot->reg_type != 0);
+        bslot->reg_vib[lane] = -(int32_t)(slot->reg_vib != 0);
+        bslot->key[lane] = slot->key;
+        bslot->ks[lane] = channel->ksv >> ((slot->reg_ksr ^ 1) << 1);
+        bslot->f_num[lane] = channel->f_num;
+        bslot->block[lane] = channel->block;
+        bslot->mult[lane] = mt[slot->reg_mult];
+        bslot->wave[lane] = slot->reg_wf << 10;
+        bundle->mod[s][lane] = slot->mod * OPL_BUNDLE_LANES + lane;
+        bslot->fb[lane] = channel->fb;
+    }
+    for (ch = 0; ch < 18; ch++)
+    {
+        channel = &chip->channel[ch];
+        for (i = 0; i < 4; i++)
+        {
+            bundle->out[ch][i][lane] = channel->out[i] * OPL_BUNDLE_LANES + lane;
+        }
+        bundle->chmask[0][ch][lane] = (int16_t)channel->cha;
+        bundle->chmask[1][ch][lane] = (int16_t)channel->chb;
+        bundle->chmask[2][ch][lane] = (int16_t)channel->chc;
+        bundle->chmask[3][ch][lane] = (int16_t)channel->chd;
+    }
+    bundle->tremoloshift[lane] = chip->tremoloshift;
+    bundle->vibshift[lane] = chip->vibshift;
+    bundle->rhy[lane] = -(int32_t)((chip->rhy & 0x20) != 0);
+}
+
+/*
+ * 汎用(x86ではSSE2、4レーン)、AVX2(8レーン)、AVX-512(16レーン)の本体
+ */
+#define OPL_KW                  4
+#define OPL_KVEC                opl3_vec4
+#define OPL_KUVEC               opl3_uvec4
+#define OPL_BUNDLE_FN(name)     name##Generic
+#include "opl3_bundle_kernel.h"
+#undef OPL_KW
+#undef OPL_KVEC
+#undef OPL_KUVEC
+#undef OPL_BUNDLE_FN
+
+#if OPL_BUNDLE_X86
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#define OPL_KW                  8
+#define OPL_KVEC                opl3_vec8
+#define OPL_KUVEC               opl3_uvec8
+#define OPL_BUNDLE_FN(name)     name##AVX2
+#include "opl3_bundle_kernel.h"
+#undef OPL_KW
+#undef OPL_KVEC
+#undef OPL_KUVEC
+#undef OPL_BUNDLE_FN
+#pragma GCC pop_options
+#endif
+
+#if OPL_BUNDLE_AVX512
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#define OPL_KW                  16
+#define OPL_KVEC                opl3_vec16
+#define OPL_KUVEC               opl3_uvec16
+#define OPL_BUNDLE_FN(name)     name##AVX512
+#include "opl3_bundle_kernel.h"
+#undef OPL_KW
+#undef OPL_KVEC
+#undef OPL_KUVEC
+#undef OPL_BUNDLE_FN
+#pragma GCC pop_options
+#endif
+
+typedef void (*opl3_bundlestep)(opl3_bundle *bundle, int16_t (*buf4)[4]);
+
+static opl3_bundlestep opl3_bundlekernel = OPL3_BundleStepGeneric;
+static uint8_t opl3_bundleselect = 0;
+
+/* CPUが対応する一番広いカーネルを選ぶ(最初のOPL3_BundleCreateで1回) */
+static void OPL3_BundleSelect(void)
+{
+    if (opl3_bundleselect)
+    {
+        return;
+    }
+    opl3_bundleselect = 1;
+#if OPL_BUNDLE_X86
+    __builtin_cpu_init();
+#if OPL_BUNDLE_AVX512
+    if (OPL_BUNDLE_ISA == 2 || (OPL_BUNDLE_ISA < 0 && __builtin_cpu_supports("avx512f")))
+    {
+        opl3_bundlekernel = OPL3_BundleStepAVX512;
+        return;
+    }
+#endif
+    if (OPL_BUNDLE_ISA >= 1 || (OPL_BUNDLE_ISA < 0 && __builtin_cpu_supports("avx2")))
+    {
+        opl3_bundlekernel = OPL3_BundleStepAVX2;
+    }
+#endif
+}
+
+static void OPL3_BundleFlush(opl3_bundle *bundle)
+{
+    uint8_t lane;
+
+    for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+    {
+        if ((bundle->dirty >> lane) & 1)
+        {
+            OPL3_BundleSync(bundle, lane);
+        }
+    }
+    bundle->dirty = 0;
+}
+
+opl3_bundle *OPL3_BundleCreate(void)
+{
+    size_t size = (sizeof(opl3_bundle) + OPL_BUNDLE_ALIGN - 1) & ~(size_t)(OPL_BUNDLE_ALIGN - 1);
+    opl3_bundle *bundle = aligned_alloc(OPL_BUNDLE_ALIGN, size);
+    uint8_t lane;
+
+    if (!bundle)
+    {
+        return NULL;
+    }
+    memset(bundle, 0, sizeof(opl3_bundle));
+    OPL3_BundleSelect();
+    for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+    {
+        OPL3_BundleReset(bundle, lane);
+    }
+    return bundle;
+}
+
+void OPL3_BundleDestroy(opl3_bundle *bundle)
+{
+    uint8_t lane;
+
+    if (!bundle)
+    {
+        return;
+    }
+    for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+    {
+        OPL3_Release(&bundle->chip[lane]);
+    }
+    free(bundle);
+}
+
+void OPL3_BundleReset(opl3_bundle *bundle, uint8_t lane)
+{
+    opl3_bundleslot *slot;
+    uint8_t s, i;
+
+    OPL3_Release(&bundle->chip[lane]);
+    OPL3_Reset(&bundle->chip[lane], 49716);
+    for (s = 0; s < 36; s++)
+    {
+        slot = &bundle->slot[s];
+        slot->pg_phase[lane] = 0;
+        slot->pg_phase_out[lane] = 0;
+        slot->pg_reset[lane] = 0;
+        slot->eg_rout[lane] = 0x1ff;
+        slot->eg_out[lane] = 0x1ff;
+        slot->eg_gen[lane] = eg_release;
+        slot->prout[lane] = 0;
+    }
+    for (i = 0; i < OPL_SIG_NUM; i++)
+    {
+        bundle->sig[i][lane] = 0;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        bundle->mixbuff[i][lane] = 0;
+    }
+    bundle->noise[lane] = 1;
+    bundle->eg_state[lane] = 0;
+    bundle->eg_add[lane] = 0;
+    bundle->eg_timer_lo[lane] = 0;
+    bundle->timer[lane] = 0;
+    bundle->vibpos[lane] = 0;
+    bundle->tremolo[lane] = 0;
+    bundle->tremolopos[lane] = 0;
+    bundle->rm_hh_bit2[lane] = 0;
+    bundle->rm_hh_bit3[lane] = 0;
+    bundle->rm_hh_bit7[lane] = 0;
+    bundle->rm_hh_bit8[lane] = 0;
+    bundle->rm_tc_bit3[lane] = 0;
+    bundle->rm_tc_bit5[lane] = 0;
+    bundle->eg_timerhi[lane] = 0;
+    bundle->eg_timer[lane] = 0;
+    bundle->eg_timerrem[lane] = 0;
+    bundle->dirty |= 1UL << lane;
+}
+
+void OPL3_BundleWriteReg(opl3_bundle *bundle, uint8_t lane, uint16_t reg, uint8_t v)
+{
+    OPL3_WriteReg(&bundle->chip[lane], reg, v);
+    bundle->dirty |= 1UL << lane;
+}
+
+void OPL3_BundleGenerate4Ch(opl3_bundle *bundle, int16_t (*buf4)[4])
+{
+    if (bundle->dirty)
+    {
+        OPL3_BundleFlush(bundle);
+    }
+    opl3_bundlekernel(bundle, buf4);
+}
+
+void OPL3_BundleGenerateStream(opl3_bundle *bundle, int16_t *const *sndptr,
+                               uint32_t numsamples)
+{
+    int16_t buf4[OPL_BUNDLE_LANES][4];
+    uint32_t i;
+    uint8_t lane;
+
+    if (bundle->dirty)
+    {
+        OPL3_BundleFlush(bundle);
+    }
+    for (i = 0; i < numsamples; i++)
+    {
+        opl3_bundlekernel(bundle, buf4);
+        for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+        {
+            sndptr[lane][i * 2] = buf4[lane][0];
+            sndptr[lane][i * 2 + 1] = buf4[lane][1];
+        }
+    }
+}
@@ -0,0 +1,312 @@
+/*
+ * Nuked OPL3 - cross-chip SIMD bundle kernel
+ *
+ * src/opl3_bundle.c から命令セットごとに1回ずつ取り込む本体です
+ * (インクルードガードはありません)。取り込む側で次を定義します。
+ *
+ *   OPL_BUNDLE_FN(name)  関数名に命令セットの接尾辞を付ける
+ *   OPL_KW               1命令で処理するレーン数(4, 8, 16)
+ *   OPL_KVEC, OPL_KUVEC  OPL_KW x 32bitのベクトル型
+ *
+ * レーンは互いに独立なので、OPL_KWレーンずつのグループごとに1サンプル分を
+ * すべて処理します。ベクトル演算はヘルパーにインライン展開される前に
+ * 分解されるので、ヘルパーも含めて同じ#pragma GCC targetの範囲に置きます。
+ */
+
+/* lanes[g..g+OPL_KW-1]をベクトルとして読み書きする */
+#define OPL_K(lanes)    (*(OPL_KVEC *)&(lanes)[g])
+#define OPL_KU(lanes)   (*(OPL_KUVEC *)&(lanes)[g])
+
+/* OPL3_SlotCalcFB */
+OPL_BUNDLE_INLINE void OPL_BUNDLE_FN(OPL3_BundleCalcFB)(opl3_bundle *bundle, uint8_t s, uint8_t g)
+{
+    opl3_bundleslot *slot = &bundle->slot[s];
+    OPL_KVEC out = OPL_K(bundle->sig[OPL_SIG_OUT + s]);
+    OPL_KVEC fb = OPL_K(slot->fb);
+
+    OPL_K(bundle->sig[OPL_SIG_FBMOD + s]) = (fb != 0) & ((OPL_K(slot->prout) + out) >> (9 - fb));
+    OPL_K(slot->prout) = out;
+}
+
+/* OPL3_EnvelopeCalc */
+OPL_BUNDLE_INLINE void OPL_BUNDLE_FN(OPL3_BundleEnvelope)(opl3_bundle *bundle, uint8_t s, uint8_t g)
+{
+    opl3_bundleslot *slot = &bundle->slot[s];
+    OPL_KVEC gen = OPL_K(slot->eg_gen);
+    OPL_KVEC rout = OPL_K(slot->eg_rout);
+    OPL_KVEC eg_state = OPL_K(bundle->eg_state);
+    OPL_KVEC key = OPL_K(slot->key) != 0;
+    OPL_KVEC attack = gen == eg_attack;
+    OPL_KVEC reset = key & (gen == eg_release);
+    OPL_KVEC reg_rate, rate, rate_hi, rate_lo, eg_shift;
+    OPL_KVEC shift, shift_lo, shift_hi, eg_off, sustain;
+    OPL_KVEC newrout, newgen, inc_attack, inc;
+
+    OPL_K(slot->eg_out) = rout + OPL_K(slot->eg_base)
+                        + (OPL_K(bundle->tremolo) & OPL_K(slot->reg_am));
+    reg_rate = OPL_SEL(reset | attack, OPL_K(slot->reg_ar),
+               OPL_SEL(gen == eg_decay, OPL_K(slot->reg_dr),
+               OPL_SEL((gen == eg_sustain) & OPL_K(slot->reg_type), 0, OPL_K(slot->reg_rr))));
+    OPL_K(slot->pg_reset) = reset;
+    rate = OPL_K(slot->ks) + (reg_rate << 2);
+    rate_hi = rate >> 2;
+    rate_lo = rate & 0x03;
+    rate_hi = OPL_SEL((rate_hi & 0x10) != 0, 0x0f, rate_hi);
+    eg_shift = rate_hi + OPL_K(bundle->eg_add);
+    shift_lo = (eg_state != 0)
+             & (((eg_shift == 12) & 1)
+              | ((eg_shift == 13) & ((rate_lo >> 1) & 0x01))
+              | ((eg_shift == 14) & (rate_lo & 0x01)));
+    shift_hi = (rate_hi & 0x03)
+             + ((OPL_BUNDLE_INCSTEP >> ((rate_lo << 2) | OPL_K(bundle->eg_timer_lo))) & 0x01);
+    shift_hi = OPL_SEL((shift_hi & 0x04) != 0, 0x03, shift_hi);
+    shift_hi = OPL_SEL(shift_hi == 0, eg_state, shift_hi);
+    shift = (reg_rate != 0) & OPL_SEL(rate_hi < 12, shift_lo, shift_hi);
+
+    eg_off = (rout & 0x1f8) == 0x1f8;
+    newrout = ~(reset & (rate_hi == 0x0f)) & rout;
+    newrout = OPL_SEL(~attack & ~reset & eg_off, 0x1ff, newrout);
+    /* アタック: ~eg_rout >> (4 - shift) */
+    inc_attack = (rout != 0) & key & (shift > 0) & (rate_hi != 0x0f) & (~rout >> (4 - shift));
+    /* ディケイ以降: 1 << (shift - 1)。shiftは0-3なので足し算で作る */
+    sustain = (gen == eg_decay) & ((rout >> 4) == OPL_K(slot->reg_sl));
+    inc = ~sustain & ~eg_off & ~reset & (shift + ((shift == 3) & 1));
+    newgen = OPL_SEL(attack, OPL_SEL(rout == 0, eg_decay, gen), OPL_SEL(sustain, eg_sustain, gen));
+    inc = OPL_SEL(attack, inc_attack, inc);
+    OPL_K(slot->eg_rout) = (newrout + inc) & 0x1ff;
+    OPL_K(slot->eg_gen) = OPL_SEL(key, ~reset & newgen, eg_release);
+}
+
+/* OPL3_PhaseGenerate(リズムモードとノイズを除く) */
+OPL_BUNDLE_INLINE void OPL_BUNDLE_FN(OPL3_BundlePhase)(opl3_bundle *bundle, uint8_t s, uint8_t g)
+{
+    opl3_bundleslot *slot = &bundle->slot[s];
+    OPL_KVEC vibpos = OPL_K(bundle->vibpos);
+    OPL_KVEC f_num = OPL_K(slot->f_num);
+    OPL_KVEC range = (f_num >> 7) & 7;
+    OPL_KUVEC phase = OPL_KU(slot->pg_phase);
+    OPL_KVEC basefreq;
+
+    range = OPL_SEL((vibpos & 3) == 0, 0, OPL_SEL((vibpos & 1) != 0, range >> 1, range));
+    range >>= OPL_K(bundle->vibshift);
+    range = OPL_SEL((vibpos & 4) != 0, -range, range);
+    f_num += OPL_K(slot->reg_vib) & range;
+    basefreq = (f_num << OPL_K(slot->block)) >> 1;
+    OPL_K(slot->pg_phase_out) = (OPL_KVEC)(phase >> 9) & 0xffff;
+    OPL_KU(slot->pg_phase) = ((OPL_KUVEC)~OPL_K(slot->pg_reset) & phase)
+                           + (OPL_KUVEC)((basefreq * OPL_K(slot->mult)) >> 1);
+}
+
+/* リズムモード(hh: 13, sd: 16, tc: 17) */
+OPL_BUNDLE_INLINE void OPL_BUNDLE_FN(OPL3_BundleRhythm)(opl3_bundle *bundle, uint8_t s, uint8_t g)
+{
+    opl3_bundleslot *slot = &bundle->slot[s];
+    OPL_KVEC phase = OPL_K(slot->pg_phase_out);
+    OPL_KVEC noise = (OPL_KVEC)OPL_KU(bundle->noise) & 1;
+    OPL_KVEC rhy = OPL_K(bundle->rhy);
+    OPL_KVEC rm_xor, hh8;
+
+    if (s == 13)
+    {
+        OPL_K(bundle->rm_hh_bit2) = (phase >> 2) & 1;
+        OPL_K(bundle->rm_hh_bit3) = (phase >> 3) & 1;
+        OPL_K(bundle->rm_hh_bit7) = (phase >> 7) & 1;
+        OPL_K(bundle->rm_hh_bit8) = (phase >> 8) & 1;
+    }
+    else if (s == 17)
+    {
+        OPL_K(bundle->rm_tc_bit3) = OPL_SEL(rhy, (phase >> 3) & 1, OPL_K(bundle->rm_tc_bit3));
+        OPL_K(bundle->rm_tc_bit5) = OPL_SEL(rhy, (phase >> 5) & 1, OPL_K(bundle->rm_tc_bit5));
+    }
+    rm_xor = (OPL_K(bundle->rm_hh_bit2) ^ OPL_K(bundle->rm_hh_bit7))
+           | (OPL_K(bundle->rm_hh_bit3) ^ OPL_K(bundle->rm_tc_bit5))
+           | (OPL_K(bundle->rm_tc_bit3) ^ OPL_K(bundle->rm_tc_bit5));
+    if (s == 13)
+    {
+        phase = OPL_SEL(rhy, (rm_xor << 9) | OPL_SEL((rm_xor ^ noise) != 0, 0xd0, 0x34), phase);
+    }
+    else if (s == 16)
+    {
+        hh8 = OPL_K(bundle->rm_hh_bit8);
+        phase = OPL_SEL(rhy, (hh8 << 9) | ((hh8 ^ noise) << 8), phase);
+    }
+    else
+    {
+        phase = OPL_SEL(rhy, (rm_xor << 9) | 0x80, phase);
+    }
+    OPL_K(slot->pg_phase_out) = phase;
+}
+
+/* OPL3_SlotGenerate(テーブル参照はレーンごと) */
+OPL_BUNDLE_INLINE void OPL_BUNDLE_FN(OPL3_BundleWave)(opl3_bundle *bundle, uint8_t s, uint8_t g)
+{
+    opl3_bundleslot *slot = &bundle->slot[s];
+    const int32_t *sig = &bundle->sig[0][0];
+    const uint16_t *mod = &bundle->mod[s][g];
+    int32_t lanes[OPL_KW] __attribute__((aligned(OPL_KW * 4)));
+    OPL_KVEC phase, wave, level, exp;
+    uint8_t l;
+
+    for (l = 0; l < OPL_KW; l++)
+    {
+        lanes[l] = sig[mod[l]];
+    }
+    phase = ((OPL_K(slot->pg_phase_out) + *(OPL_KVEC *)lanes) & 0x3ff) + OPL_K(slot->wave);
+    for (l = 0; l < OPL_KW; l++)
+    {
+        lanes[l] = (&opl3_wavetab[0][0])[phase[l]];
+    }
+    wave = *(OPL_KVEC *)lanes;
+    level = (wave & 0x1fff) + (OPL_K(slot->eg_out) << 3);
+    level = OPL_SEL(level > 0x1fff, 0x1fff, level);
+    for (l = 0; l < OPL_KW; l++)
+    {
+        lanes[l] = exprom[level[l] & 0xff];
+    }
+    exp = *(OPL_KVEC *)lanes;
+    OPL_K(bundle->sig[OPL_SIG_OUT + s]) = ((exp << 1) >> (level >> 8)) ^ -(wave >> 15);
+}
+
+OPL_BUNDLE_INLINE void OPL_BUNDLE_FN(OPL3_BundleSlot)(opl3_bundle *bundle, uint8_t s, uint8_t g)
+{
+    OPL_KUVEC noise;
+
+    OPL_BUNDLE_FN(OPL3_BundleCalcFB)(bundle, s, g);
+    OPL_BUNDLE_FN(OPL3_BundleEnvelope)(bundle, s, g);
+    OPL_BUNDLE_FN(OPL3_BundlePhase)(bundle, s, g);
+    if (s == 13 || s == 16 || s == 17)
+    {
+        OPL_BUNDLE_FN(OPL3_BundleRhythm)(bundle, s, g);
+    }
+    /* ノイズLFSR(1スロットに1回) */
+    noise = OPL_KU(bundle->noise);
+    OPL_KU(bundle->noise) = (noise >> 1) | (((noise >> 14) ^ noise) & 0x01) << 22;
+    OPL_BUNDLE_FN(OPL3_BundleWave)(bundle, s, g);
+}
+
+/* ミックス1回分(pass 0: cha/chc, 1: chb/chd) */
+OPL_BUNDLE_INLINE void OPL_BUNDLE_FN(OPL3_BundleMix)(opl3_bundle *bundle, uint8_t pass, uint8_t g)
+{
+    const int32_t *sig = &bundle->sig[0][0];
+    const uint16_t (*out)[OPL_BUNDLE_LANES];
+    int32_t lanes[OPL_KW] __attribute__((aligned(OPL_KW * 4)));
+    OPL_KVEC mix0 = { 0 };
+    OPL_KVEC mix1 = { 0 };
+    OPL_KVEC accm;
+    uint8_t ch, l;
+
+    for (ch = 0; ch < 18; ch++)
+    {
+        out = bundle->out[ch];
+        for (l = g; l < g + OPL_KW; l++)
+        {
+            lanes[l - g] = (int16_t)(sig[out[0][l]] + sig[out[1][l]]
+                                   + sig[out[2][l]] + sig[out[3][l]]);
+        }
+        accm = *(OPL_KVEC *)lanes;
+        mix0 += accm & OPL_K(bundle->chmask[pass][ch]);
+        mix1 += accm & OPL_K(bundle->chmask[pass + 2][ch]);
+    }
+    OPL_K(bundle->mixbuff[pass]) = mix0;
+    OPL_K(bundle->mixbuff[pass + 2]) = mix1;
+}
+
+/* OPL3_UpdateTimers */
+OPL_BUNDLE_INLINE void OPL_BUNDLE_FN(OPL3_BundleTimers)(opl3_bundle *bundle, uint8_t g)
+{
+    OPL_KVEC timer = OPL_K(bundle->timer);
+    OPL_KVEC pos = OPL_K(bundle->tremolopos);
+    uint16_t eg_timer;
+    uint8_t l, lo, hi;
+
+    pos -= (timer & 0x3f) == 0x3f;
+    pos = ~(pos == 210) & pos;
+    OPL_K(bundle->tremolopos) = pos;
+    OPL_K(bundle->tremolo) = OPL_SEL(pos < 105, pos, 210 - pos) >> OPL_K(bundle->tremoloshift);
+    OPL_K(bundle->vibpos) = (OPL_K(bundle->vibpos) - ((timer & 0x3ff) == 0x3ff)) & 7;
+    OPL_K(bundle->timer) = (timer + 1) & 0xffff;
+
+    for (l = g; l < g + OPL_KW; l++)
+    {
+        eg_timer = bundle->eg_timer[l];
+        if (bundle->eg_state[l])
+        {
+            lo = (uint8_t)eg_timer;
+            hi = (uint8_t)(eg_timer >> 8) & 0x1f;
+            bundle->eg_add[l] = lo ? eg_addtab[lo] : hi ? eg_addtab[hi] + 8 : 0;
+            bundle->eg_timer_lo[l] = eg_timer & 0x03;
+        }
+        if (bundle->eg_timerrem[l] || bundle->eg_state[l])
+        {
+            bundle->eg_timerrem[l] = 0;
+            if (++bundle->eg_timer[l] == 0)
+            {
+                if (bundle->eg_timerhi[l] == 0xfffffUL)
+                {
+                    bundle->eg_timerhi[l] = 0;
+                    bundle->eg_timerrem[l] = 1;
+                }
+                else
+                {
+                    bundle->eg_timerhi[l]++;
+                }
+            }
+        }
+    }
+    OPL_K(bundle->eg_state) ^= 1;
+}
+
+OPL_BUNDLE_INLINE int16_t OPL_BUNDLE_FN(OPL3_BundleClip)(int32_t sample)
+{
+    return (int16_t)(sample > 32767 ? 32767 : sample < -32768 ? -32768 : sample);
+}
+
+/* OPL3_Generate4Chの1サンプル分(lanes g..g+OPL_KW-1) */
+OPL_BUNDLE_INLINE void OPL_BUNDLE_FN(OPL3_BundleGroup)(opl3_bundle *bundle, int16_t (*buf4)[4],
+                                                       uint8_t g)
+{
+    uint8_t s, l;
+
+    for (l = g; l < g + OPL_KW; l++)
+    {
+        buf4[l][1] = OPL_BUNDLE_FN(OPL3_BundleClip)(bundle->mixbuff[1][l]);
+        buf4[l][3] = OPL_BUNDLE_FN(OPL3_BundleClip)(bundle->mixbuff[3][l]);
+    }
+    for (s = 0; s < 15; s++)
+    {
+        OPL_BUNDLE_FN(OPL3_BundleSlot)(bundle, s, g);
+    }
+    OPL_BUNDLE_FN(OPL3_BundleMix)(bundle, 0, g);
+    for (s = 15; s < 18; s++)
+    {
+        OPL_BUNDLE_FN(OPL3_BundleSlot)(bundle, s, g);
+    }
+    for (l = g; l < g + OPL_KW; l++)
+    {
+        buf4[l][0] = OPL_BUNDLE_FN(OPL3_BundleClip)(bundle->mixbuff[0][l]);
+        buf4[l][2] = OPL_BUNDLE_FN(OPL3_BundleClip)(bundle->mixbuff[2][l]);
+    }
+    for (s = 18; s < 33; s++)
+    {
+        OPL_BUNDLE_FN(OPL3_BundleSlot)(bundle, s, g);
+    }
+    OPL_BUNDLE_FN(OPL3_BundleMix)(bundle, 1, g);
+    for (s = 33; s < 36; s++)
+    {
+        OPL_BUNDLE_FN(OPL3_BundleSlot)(bundle, s, g);
+    }
+    OPL_BUNDLE_FN(OPL3_BundleTimers)(bundle, g);
+}
+
+static void OPL_BUNDLE_FN(OPL3_BundleStep)(opl3_bundle *bundle, int16_t (*buf4)[4])
+{
+    uint8_t g;
+
+    for (g = 0; g < OPL_BUNDLE_LANES; g += OPL_KW)
+    {
+        OPL_BUNDLE_FN(OPL3_BundleGroup)(bundle, buf4, g);
+    }
+}
+
+#undef OPL_K
+#undef OPL_KU
@@ -0,0 +1,489 @@
+/*
+ * Nuked OPL3 - checkpoint index for seeking (host only)
+ *
+ * 索引ファイルの書式(リトルエンディアン):
+ *   "OPLI", 版(1), チップ数, 予約(2), samplerate(4), interval(4), key(4),
+ *   チェックポイント数(4)
+ *   チェックポイントごとに
+ *     出力サンプル位置(8), 再生位置の長さ(2), 再生位置,
+ *     チップごとに 状態の長さ(4), OPL3_SaveStateの状態
+ * メモリ上でもファイルの本体と同じバイト列を持ち、各チェックポイントの
+ * 先頭位置の配列で二分探索します。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "opl3_index.h"
+
+#define OPL_INDEX_VERSION   1
+#define OPL_INDEX_HEADER    24
+#define OPL_INDEX_SCRATCH   1024
+
+struct _opl3_index {
+    uint8_t *data;              /* チェックポイントの列 */
+    size_t size;
+    size_t capacity;
+    size_t *offsets;            /* 各チェックポイントのdata内の先頭 */
+    uint32_t count;
+    uint32_t offcapacity;
+    uint32_t samplerate;
+    uint32_t interval;
+    uint32_t key;
+    uint8_t numchips;
+};
+
+static void OPL3_IndexPut16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void OPL3_IndexPut32(uint8_t *p, uint32_t v)
+{
+    OPL3_IndexPut16(p, (uint16_t)v);
+    OPL3_IndexPut16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t OPL3_IndexGet16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t OPL3_IndexGet32(const uint8_t *p)
+{
+    return OPL3_IndexGet16(p) | ((uint32_t)OPL3_IndexGet16(p + 2) << 16);
+}
+
+static uint64_t OPL3_IndexGet64(const uint8_t *p)
+{
+    return OPL3_IndexGet32(p) | ((uint64_t)OPL3_IndexGet32(p + 4) << 32);
+}
+
+uint32_t OPL3_IndexKey(const uint8_t *data, size_t size)
+{
+    uint32_t h = 0x811c9dc5UL;
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        h = (h ^ data[i]) * 0x01000193UL;
+    }
+    return h;
+}
+
+opl3_index *OPL3_IndexCreate(uint8_t numchips, uint32_t samplerate, uint32_t interval,
+                             uint32_t key)
+{
+    opl3_index *index;
+
+    if (numchips == 0 || numchips > OPL_INDEX_MAXCHIPS || interval == 0)
+    {
+        return 0;
+    }
+    index = (opl3_index *)calloc(1, sizeof(opl3_index));
+    if (index)
+    {
+        index->numchips = numchips;
+        index->samplerate = samplerate;
+        index->interval = interval;
+        index->key = key;
+    }
+    return index;
+}
+
+void OPL3_IndexFree(opl3_index *index)
+{
+    if (index)
+    {
+        free(index->data);
+        free(index->offsets);
+        free(index);
+    }
+}
+
+uint32_t OPL3_IndexCount(const opl3_index *index)
+{
+    return index->count;
+}
+
+/* dataの末尾にsizeバイトの空きを用意する */
+static uint8_t *OPL3_IndexReserve(opl3_index *index, size_t size)
+{
+    uint8_t *data;
+    size_t capacity = index->capacity ? index->capacity : 65536;
+
+    while (capacity - index->size < size)
+    {
+        capacity *= 2;
+    }
+    if (capacity != index->capacity)
+    {
+        data = (uint8_t *)realloc(index->data, capacity);
+        if (!data)
+        {
+            return 0;
+        }
+        index->data = data;
+        index->capacity = capacity;
+    }
+    return index->data + index->size;
+}
+
+/* offsetから始まるチェックポイントを登録する */
+static uint8_t OPL3_IndexPushOffset(opl3_index *index, size_t offset)
+{
+    size_t *offsets;
+    uint32_t capacity;
+
+    if (index->count == index->offcapacity)
+    {
+        capacity = index->offcapacity ? index->offcapacity * 2 : 256;
+        offsets = (size_t *)realloc(index->offsets, capacity * sizeof(size_t));
+        if (!offsets)
+        {
+            return OPL_INDEX_NOMEM;
+        }
+        index->offsets = offsets;
+        index->offcapacity = capacity;
+    }
+    index->offsets[index->count++] = offset;
+    return OPL_INDEX_OK;
+}
+
+/* ストリームフックが付いたチップがあるか */
+static uint8_t OPL3_IndexHooked(const opl3_index *index, opl3_chip *const *chips)
+{
+#if OPL_STREAM_HOOK
+    uint8_t i;
+
+    for (i = 0; i < index->numchips; i++)
+    {
+        if (chips[i]->streamhook)
+        {
+            return 1;
+        }
+    }
+#else
+    (void)index;
+    (void)chips;
+#endif
+    return 0;
+}
+
+uint8_t OPL3_IndexAdd(opl3_index *index, uint64_t sample, const uint8_t *pos,
+                      uint16_t poslen, opl3_chip *const *chips)
+{
+    size_t need = 10 + (size_t)poslen, offset = index->size;
+    uint32_t statesize;
+    uint8_t *p, i;
+
+    if (OPL3_IndexHooked(index, chips))
+    {
+        return OPL_INDEX_HOOKED;
+    }
+    for (i = 0; i < index->numchips; i++)
+    {
+        need += 4 + OPL3_StateSize(chips[i]);
+    }
+    p = OPL3_IndexReserve(index, need);
+    if (!p || OPL3_IndexPushOffset(index, offset) != OPL_INDEX_OK)
+    {
+        return OPL_INDEX_NOMEM;
+    }
+    OPL3_IndexPut32(p, (uint32_t)sample);
+    OPL3_IndexPut32(p + 4, (uint32_t)(sample >> 32));
+    OPL3_IndexPut16(p + 8, poslen);
+    memcpy(p + 10, pos, poslen);
+    p += 10 + poslen;
+    for (i = 0; i < index->numchips; i++)
+    {
+        statesize = OPL3_SaveState(chips[i], p + 4, OPL3_StateSize(chips[i]));
+        OPL3_IndexPut32(p, statesize);
+        p += 4 + statesize;
+    }
+    index->size = offset + need;
+    return OPL_INDEX_OK;
+}
+
+uint8_t OPL3_IndexSave(const opl3_index *index, const char *path)
+{
+    uint8_t header[OPL_INDEX_HEADER];
+    FILE *fp;
+    int ok;
+
+    memcpy(header, "OPLI", 4);
+    header[4] = OPL_INDEX_VERSION;
+    header[5] = index->numchips;
+    OPL3_IndexPut16(&header[6], 0);
+    OPL3_IndexPut32(&header[8], index->samplerate);
+    OPL3_IndexPut32(&header[12], index->interval);
+    OPL3_IndexPut32(&header[16], index->key);
+    OPL3_IndexPut32(&header[20], index->count);
+
+    fp = fopen(path, "wb");
+    if (!fp)
+    {
+        return OPL_INDEX_IOERR;
+    }
+    ok = fwrite(header, 1, sizeof(header), fp) == sizeof(header)
+      && fwrite(index->data, 1, index->size, fp) == index->size;
+    if (fclose(fp) != 0 || !ok)
+    {
+        return OPL_INDEX_IOERR;
+    }
+    return OPL_INDEX_OK;
+}
+
+/* 読み込んだ本体を先頭からたどり、各チェックポイントの位置を登録する */
+static uint8_t OPL3_IndexScan(opl3_index *index, uint32_t count)
+{
+    const uint8_t *end = index->data + index->size;
+    const uint8_t *p = index->data;
+    uint64_t sample, last = 0;
+    uint32_t n, statesize;
+    uint8_t i;
+
+    for (n = 0; n < count; n++)
+    {
+        if (end - p < 10)
+        {
+            return OPL_INDEX_BADFILE;
+        }
+        sample = OPL3_IndexGet64(p);
+        if (n > 0 && sample < last)
+        {
+            return OPL_INDEX_BADFILE;
+        }
+        last = sample;
+        if (OPL3_IndexPushOffset(index, (size_t)(p - index->data)) != OPL_INDEX_OK)
+        {
+            return OPL_INDEX_NOMEM;
+        }
+        p += 10;
+        if ((size_t)(end - p) < OPL3_IndexGet16(p - 2))
+        {
+            return OPL_INDEX_BADFILE;
+        }
+        p += OPL3_IndexGet16(p - 2);
+        for (i = 0; i < index->numchips; i++)
+        {
+            if (end - p < 4 || (size_t)(end - p - 4) < OPL3_IndexGet32(p))
+            {
+                return OPL_INDEX_BADFILE;
+            }
+            statesize = OPL3_IndexGet32(p);
+            p += 4 + statesize;
+        }
+    }
+    return p == end ? OPL_INDEX_OK : OPL_INDEX_BADFILE;
+}
+
+uint8_t OPL3_IndexLoad(opl3_index **index, const char *path, uint8_t numchips,
+                       uint32_t samplerate, uint32_t key)
+{
+    uint8_t header[OPL_INDEX_HEADER];
+    opl3_index *idx;
+    FILE *fp;
+    long size;
+    uint8_t err = OPL_INDEX_OK;
+
+    *index = 0;
+    fp = fopen(path, "rb");
+    if (!fp)
+    {
+        return OPL_INDEX_IOERR;
+    }
+    if (fread(header, 1, sizeof(header), fp) != sizeof(header)
+     || memcmp(header, "OPLI", 4) != 0 || header[4] != OPL_INDEX_VERSION
+     || fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) < OPL_INDEX_HEADER)
+    {
+        fclose(fp);
+        return OPL_INDEX_BADFILE;
+    }
+    if (header[5] != numchips || OPL3_IndexGet32(&header[8]) != samplerate
+     || OPL3_IndexGet32(&header[16]) != key)
+    {
+        fclose(fp);
+        return OPL_INDEX_STALE;
+    }
+    if (OPL3_IndexGet32(&header[12]) == 0)
+    {
+        fclose(fp);
+        return OPL_INDEX_BADFILE;
+    }
+    idx = OPL3_IndexCreate(numchips, samplerate, OPL3_IndexGet32(&header[12]), key);
+    if (!idx)
+    {
+        fclose(fp);
+        return OPL_INDEX_NOMEM;
+    }
+    idx->size = (size_t)size - OPL_INDEX_HEADER;
+    idx->capacity = idx->size ? idx->size : 1;
+    idx->data = (uint8_t *)malloc(idx->capacity);
+    if (!idx->data)
+    {
+        err = OPL_INDEX_NOMEM;
+    }
+    else if (fseek(fp, OPL_INDEX_HEADER, SEEK_SET) != 0
+          || fread(idx->data, 1, idx->size, fp) != idx->size)
+    {
+        err = OPL_INDEX_IOERR;
+    }
+    else
+    {
+        err = OPL3_IndexScan(idx, OPL3_IndexGet32(&header[20]));
+    }
+    fclose(fp);
+    if (err != OPL_INDEX_OK)
+    {
+        OPL3_IndexFree(idx);
+        return err;
+    }
+    *index = idx;
+    return OPL_INDEX_OK;
+}
+
+uint8_t OPL3_IndexFind(const opl3_index *index, uint64_t sample, opl3_chip *const *chips,
+                       uint64_t *at, const uint8_t **pos, uint16_t *poslen)
+{
+    const uint8_t *p, *states;
+    uint32_t lo = 0, hi, mid, statesize;
+    uint8_t i, err;
+
+    if (!index || index->count == 0 || OPL3_IndexGet64(index->data) > sample)
+    {
+        return OPL_INDEX_NOTFOUND;
+    }
+    if (OPL3_IndexHooked(index, chips))
+    {
+        return OPL_INDEX_HOOKED;
+    }
+    /* sample以前で最後のチェックポイント */
+    hi = index->count - 1;
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo + 1) / 2;
+        if (OPL3_IndexGet64(index->data + index->offsets[mid]) <= sample)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+    p = index->data + index->offsets[lo];
+    *at = OPL3_IndexGet64(p);
+    *poslen = OPL3_IndexGet16(p + 8);
+    *pos = p + 10;
+    states = p + 10 + *poslen;
+    /* 一部のチップだけ書き換えないよう、全部を確かめてから復元する */
+    for (p = states, i = 0; i < index->numchips; i++)
+    {
+        statesize = OPL3_IndexGet32(p);
+        err = OPL3_CheckState(chips[i], p + 4, statesize);
+        if (err != OPL_STATE_OK)
+        {
+            return err == OPL_STATE_FULL ? OPL_INDEX_NOMEM : OPL_INDEX_BADFILE;
+        }
+        p += 4 + statesize;
+    }
+    for (p = states, i = 0; i < index->numchips; i++)
+    {
+        statesize = OPL3_IndexGet32(p);
+        OPL3_LoadState(chips[i], p + 4, statesize);
+        p += 4 + statesize;
+    }
+    return OPL_INDEX_OK;
+}
+
+/* タイムラインの再生位置: イベントの番号(4)と残りの待ち(2) */
+static void OPL3_TimelinePos(const opl3_timeline *tl, const opl3_event *events, uint8_t *pos)
+{
+    OPL3_IndexPut32(pos, (uint32_t)(tl->cur - events));
+    OPL3_IndexPut16(pos + 4, tl->remain);
+}
+
+uint8_t OPL3_TimelineBuildIndex(const opl3_event *events, uint32_t numevents,
+                                opl3_chip *chip, uint32_t samplerate, uint32_t interval,
+                                uint32_t key, const char *path)
+{
+    int16_t scratch[OPL_INDEX_SCRATCH * 2];
+    opl3_chip *chips[1] = { chip };
+    opl3_index *index;
+    opl3_timeline tl;
+    uint64_t sample = 0;
+    uint32_t count, n, left = interval;
+    uint8_t pos[6], err;
+
+    index = OPL3_IndexCreate(1, samplerate, interval, key);
+    if (!index)
+    {
+        return OPL_INDEX_NOMEM;
+    }
+    OPL3_TimelineStart(&tl, events, numevents);
+    OPL3_TimelinePos(&tl, events, pos);
+    err = OPL3_IndexAdd(index, 0, pos, sizeof(pos), chips);
+    while (err == OPL_INDEX_OK)
+    {
+        count = left < OPL_INDEX_SCRATCH ? left : OPL_INDEX_SCRATCH;
+        n = OPL3_TimelineRender(&tl, chip, scratch, count);
+        sample += n;
+        left -= n;
+        if (n < count)
+        {
+            break;
+        }
+        if (left == 0)
+        {
+            OPL3_TimelinePos(&tl, events, pos);
+            err = OPL3_IndexAdd(index, sample, pos, sizeof(pos), chips);
+            left = interval;
+        }
+    }
+    if (err == OPL_INDEX_OK)
+    {
+        err = OPL3_IndexSave(index, path);
+    }
+    OPL3_IndexFree(index);
+    return err;
+}
+
+uint8_t OPL3_TimelineSeek(opl3_timeline *tl, const opl3_event *events, uint32_t numevents,
+                          const opl3_index *index, opl3_chip *chip, uint64_t sample)
+{
+    int16_t scratch[OPL_INDEX_SCRATCH * 2];
+    opl3_chip *chips[1] = { chip };
+    const uint8_t *pos;
+    uint64_t at;
+    uint32_t cur, count;
+    uint16_t poslen;
+    uint8_t err;
+
+    err = OPL3_IndexFind(index, sample, chips, &at, &pos, &poslen);
+    if (err != OPL_INDEX_OK)
+    {
+        return err;
+    }
+    cur = poslen == 6 ? OPL3_IndexGet32(pos) : numevents + 1;
+    if (cur > numevents)
+    {
+        return OPL_INDEX_BADFILE;
+    }
+    tl->cur = events + cur;
+    tl->end = events + numevents;
+    tl->remain = OPL3_IndexGet16(pos + 4);
+    /* 残りを生成して捨てる */
+    while (at < sample)
+    {
+        count = sample - at < OPL_INDEX_SCRATCH ? (uint32_t)(sample - at) : OPL_INDEX_SCRATCH;
+        if (OPL3_TimelineRender(tl, chip, scratch, count) < count)
+        {
+            break;
+        }
+        at += count;
+    }
+    return OPL_INDEX_OK;
+}
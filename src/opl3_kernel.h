@@ -0,0 +1,170 @@
+/*
+ * Nuked OPL3 - z88dk port
+ *
+ * サンプル生成(OPL3_Generate4Ch)の本体
+ *
+ * src/opl3.c からモードごとに1回ずつ取り込みます(インクルードガードは
+ * ありません)。取り込む側で次を定義します。
+ *
+ *   OPL_KERNEL_FN(name)  関数名にモードの接尾辞を付ける
+ *   OPL_KERNEL_RHYTHM    1ならリズムモード(hh、sd、tcの位相を置き換える)
+ *
+ * ステレオ拡張とOPL_QUIRK_CHANNELSAMPLEDELAYはコンパイル時に決まり、
+ * NEW(0x105)は書き込み時にチャンネルのマスクへ反映されるので、
+ * カーネルを分けるのはリズムモードだけです。
+ */
+
+/* スロット0-14(リズムモードではhhの13) */
+static void OPL_KERNEL_FN(OPL3_ProcessSlots0)(opl3_chip *chip)
+{
+    opl3_slot *slot = chip->slot;
+    uint8_t ii;
+
+#if OPL_KERNEL_RHYTHM
+    for (ii = 0; ii < 13; ii++)
+    {
+        OPL3_ProcessSlot(chip, slot++);
+    }
+    OPL3_ProcessSlotRhythm(chip, slot++);
+    OPL3_ProcessSlot(chip, slot);
+#else
+    for (ii = 0; ii < 15; ii++)
+    {
+        OPL3_ProcessSlot(chip, slot++);
+    }
+    OPL3_PhaseHH(chip, chip->slot[13].pg_phase_out);
+#endif
+}
+
+/* スロット15-17(リズムモードではsdの16とtcの17) */
+static void OPL_KERNEL_FN(OPL3_ProcessSlots15)(opl3_chip *chip)
+{
+    opl3_slot *slot = &chip->slot[15];
+
+    OPL3_ProcessSlot(chip, slot);
+#if OPL_KERNEL_RHYTHM
+    OPL3_ProcessSlotRhythm(chip, slot + 1);
+    OPL3_ProcessSlotRhythm(chip, slot + 2);
+#else
+    OPL3_ProcessSlot(chip, slot + 1);
+    OPL3_ProcessSlot(chip, slot + 2);
+#endif
+}
+
+static void OPL_KERNEL_FN(OPL3_Generate4Ch)(opl3_chip *chip, int16_t *buf4)
+{
+#if !OPL_MIX_SIMD
+    opl3_channel *channel;
+    const int16_t *sig = chip->sig;
+    uint8_t *out;
+    int16_t accm;
+#endif
+#if OPL_NUM_SLOTS > 18
+    opl3_slot *slot;
+#endif
+    int32_t mix[2];
+    uint8_t ii;
+    OPL_PROF_VAR(t)
+    OPL_PROF_VAR(total)
+
+    OPL_PROF_START(total);
+    buf4[1] = OPL3_ClipSample(chip->mixbuff[1]);
+    buf4[3] = OPL3_ClipSample(chip->mixbuff[3]);
+
+    OPL_KERNEL_FN(OPL3_ProcessSlots0)(chip);
+#if !OPL_QUIRK_CHANNELSAMPLEDELAY
+    OPL_KERNEL_FN(OPL3_ProcessSlots15)(chip);
+#if OPL_NUM_SLOTS > 18
+    slot = &chip->slot[18];
+    for (ii = 18; ii < OPL_NUM_SLOTS; ii++)
+    {
+        OPL3_ProcessSlot(chip, slot++);
+    }
+#endif
+#endif
+
+    OPL_PROF_START(t);
+#if OPL_MIX_SIMD
+    opl3_mix(chip, 0, mix);
+#else
+    mix[0] = mix[1] = 0;
+    channel = chip->channel;
+    for (ii = 0; ii < OPL_NUM_CHANNELS; ii++, channel++)
+    {
+        out = channel->out;
+        accm = sig[out[0]] + sig[out[1]] + sig[out[2]] + sig[out[3]];
+#if OPL_ENABLE_STEREOEXT
+        mix[0] += (int16_t)((accm * channel->leftpan) >> 16);
+#else
+        mix[0] += (int16_t)(accm & channel->cha);
+#endif
+#if !OPL3_PROFILE_OPL2
+        mix[1] += (int16_t)(accm & channel->chc);
+#endif
+    }
+#endif
+    chip->mixbuff[0] = mix[0];
+    chip->mixbuff[2] = mix[1];
+    OPL_PROF_LAP(chip, OPL_PROF_MIX, 1, t);
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY
+    OPL_KERNEL_FN(OPL3_ProcessSlots15)(chip);
+#endif
+
+    buf4[0] = OPL3_ClipSample(chip->mixbuff[0]);
+    buf4[2] = OPL3_ClipSample(chip->mixbuff[2]);
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY && !OPL3_PROFILE_OPL2
+    slot = &chip->slot[18];
+    for (ii = 18; ii < 33; ii++)
+    {
+        OPL3_ProcessSlot(chip, slot++);
+    }
+#endif
+
+    OPL_PROF_START(t);
+#if OPL_MIX_SIMD
+    opl3_mix(chip, 1, mix);
+#else
+    mix[0] = mix[1] = 0;
+    channel = chip->channel;
+    for (ii = 0; ii < OPL_NUM_CHANNELS; ii++, channel++)
+    {
+        out = channel->out;
+        accm = sig[out[0]] + sig[out[1]] + sig[out[2]] + sig[out[3]];
+#if OPL_ENABLE_STEREOEXT
+        mix[0] += (int16_t)((accm * channel->rightpan) >> 16);
+#else
+        mix[0] += (int16_t)(accm & channel->chb);
+#endif
+#if !OPL3_PROFILE_OPL2
+        mix[1] += (int16_t)(accm & channel->chd);
+#endif
+    }
+#endif
+    chip->mixbuff[1] = mix[0];
+    chip->mixbuff[3] = mix[1];
+    OPL_PROF_LAP(chip, OPL_PROF_MIX, 1, t);
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY && !OPL3_PROFILE_OPL2
+    for (ii = 33; ii < 36; ii++)
+    {
+        OPL3_ProcessSlot(chip, slot++);
+    }
+#endif
+
+    OPL_PROF_START(t);
+#if OPL3_PROFILE_OPL2
+    OPL3_NoiseSkip(chip);
+    OPL_PROF_LAP(chip, OPL_PROF_PHASE, 0, t);
+#endif
+    OPL3_UpdateTimers(chip);
+    OPL_PROF_LAP(chip, OPL_PROF_TIMERS, 1, t);
+    if (chip->writebuf_next <= chip->writebuf_samplecnt)
+    {
+        OPL3_ProcessWriteBuf(chip);
+        OPL_PROF_LAP(chip, OPL_PROF_WRITEBUF, 1, t);
+    }
+    chip->writebuf_samplecnt++;
+    OPL_PROF_LAP(chip, OPL_PROF_TOTAL, 1, total);
+}
@@ -0,0 +1,63 @@
+;
+; Nuked OPL3 - z88dk port
+;
+; MSXのバンク(OPL_BANKED == 2)のセクションとセグメントの確保
+;
+; 切り替える側(src/opl3.c を OPL_BANK_PART=2 でコンパイルしたもの)は
+; --codesegBANK_02 --constsegBANK_02 でこのセクションに入ります。
+; マッパーのページ2に出したときの番地でリンクし、z88dkが別に出力する
+; _BANK_02.bin を実行時に OPL3_BankLoad でセグメントへ読み込みます。
+
+    SECTION BANK_02
+    org     0x8000
+
+    SECTION code_user
+
+    PUBLIC  _opl3_msxallseg
+
+    defc    HOKVLD = 0xfb20         ; bit 0: 拡張BIOS(EXTBIO)のフックが有効
+    defc    EXTBIO = 0xffca
+
+; uint8_t opl3_msxallseg(uint8_t *seg)  (__z88dk_fastcall、HL = seg)
+;
+; MSX-DOS2のマッパーサポートルーチンのALL_SEGで、1次マッパーから
+; ユーザーセグメントを1つ確保して*segに書きます。ユーザーセグメントは
+; プログラムの終了時にDOS2が解放します。
+; 戻り値(L): 0 = マッパーサポートがない(MSX-DOS1など)
+;            1 = 確保した
+;            2 = 空いているセグメントがない
+; AF、BC、DE、HLを壊します。拡張BIOSが壊すことのあるIX、IYは保存します。
+_opl3_msxallseg:
+    push    ix
+    push    iy
+    push    hl                      ; 書き込み先
+    ld      a, (HOKVLD)
+    rra
+    jr      nc, allseg_none
+    xor     a
+    ld      de, 0x0402              ; D = 4 (マッパー), E = 2 (サポートルーチンの表)
+    call    EXTBIO                  ; A = 全セグメント数(0ならなし), HL = 表の先頭
+    or      a
+    jr      z, allseg_none
+    xor     a                       ; A = 0: ユーザーセグメント
+    ld      b, a                    ; B = 0: 1次マッパー
+    call    allseg_call             ; ALL_SEG(表の先頭 + 0): Cy = 空きなし, A = 番号
+    jr      c, allseg_full
+    pop     hl
+    ld      (hl), a
+    ld      l, 1
+    jr      allseg_done
+allseg_full:
+    pop     hl
+    ld      l, 2
+    jr      allseg_done
+allseg_none:
+    pop     hl
+    ld      l, 0
+allseg_done:
+    pop     iy
+    pop     ix
+    ret
+
+allseg_call:
+    jp      (hl)
@@ -0,0 +1,301 @@
+/*
+ * Nuked OPL3 - multi-chip render pool (host only)
+ *
+ * ワーカーごとに担当範囲 [head, tail) を1つの64bit値で持ち、
+ * 担当ワーカーは先頭から、盗む側は末尾からCASで1チップずつ取ります。
+ * ロックは周期の開始と終了の通知だけで、チップの処理中は使いません。
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "opl3_pool.h"
+
+#define OPL_POOL_CACHELINE  64
+
+typedef struct {
+    _Atomic uint64_t range;     /* 下位32bit: head, 上位32bit: tail */
+    char pad[OPL_POOL_CACHELINE - sizeof(uint64_t)];
+} opl3_poolqueue;
+
+typedef struct {
+    opl3_pool *pool;
+    uint32_t index;
+    pthread_t thread;
+} opl3_poolworker;
+
+struct _opl3_pool {
+    opl3_poolqueue *queues;
+    opl3_poolworker *workers;
+    uint32_t numworkers;
+    uint32_t numpinned;
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    uint32_t generation;
+    uint32_t running;
+    int quit;
+    opl3_pooljob *jobs;
+    uint32_t numsamples;
+};
+
+static uint64_t OPL3_PoolRange(uint32_t head, uint32_t tail)
+{
+    return ((uint64_t)tail << 32) | head;
+}
+
+/* 担当ワーカー: 先頭から取る */
+static int OPL3_PoolTakeHead(opl3_poolqueue *queue, uint32_t *job)
+{
+    uint64_t range = atomic_load_explicit(&queue->range, memory_order_relaxed);
+    uint32_t head, tail;
+
+    do
+    {
+        head = (uint32_t)range;
+        tail = (uint32_t)(range >> 32);
+        if (head >= tail)
+        {
+            return 0;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&queue->range, &range,
+                                                    OPL3_PoolRange(head + 1, tail),
+                                                    memory_order_acquire,
+                                                    memory_order_relaxed));
+    *job = head;
+    return 1;
+}
+
+/* 他のワーカー: 末尾から盗む */
+static int OPL3_PoolTakeTail(opl3_poolqueue *queue, uint32_t *job)
+{
+    uint64_t range = atomic_load_explicit(&queue->range, memory_order_relaxed);
+    uint32_t head, tail;
+
+    do
+    {
+        head = (uint32_t)range;
+        tail = (uint32_t)(range >> 32);
+        if (head >= tail)
+        {
+            return 0;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&queue->range, &range,
+                                                    OPL3_PoolRange(head, tail - 1),
+                                                    memory_order_acquire,
+                                                    memory_order_relaxed));
+    *job = tail - 1;
+    return 1;
+}
+
+static void OPL3_PoolRenderJob(const opl3_pooljob *job, uint32_t numsamples)
+{
+    const opl3_poolwrite *write = job->writes;
+    const opl3_poolwrite *end = job->writes + job->numwrites;
+    uint32_t pos = 0;
+    uint32_t until;
+
+    while (pos < numsamples)
+    {
+        while (write < end && write->time <= pos)
+        {
+            OPL3_WriteReg(job->chip, write->reg, write->data);
+            write++;
+        }
+        until = numsamples;
+        if (write < end && write->time < numsamples)
+        {
+            until = write->time;
+        }
+        OPL3_GenerateStream(job->chip, job->sndptr + pos * 2, until - pos);
+        pos = until;
+    }
+    while (write < end)
+    {
+        OPL3_WriteReg(job->chip, write->reg, write->data);
+        write++;
+    }
+}
+
+static void *OPL3_PoolWorker(void *arg)
+{
+    opl3_poolworker *worker = (opl3_poolworker *)arg;
+    opl3_pool *pool = worker->pool;
+    uint32_t seen = 0;
+    uint32_t victim, i, job;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->generation == seen && !pool->quit)
+        {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->quit)
+        {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        while (OPL3_PoolTakeHead(&pool->queues[worker->index], &job))
+        {
+            OPL3_PoolRenderJob(&pool->jobs[job], pool->numsamples);
+        }
+        for (i = 1; i < pool->numworkers; i++)
+        {
+            victim = (worker->index + i) % pool->numworkers;
+            while (OPL3_PoolTakeTail(&pool->queues[victim], &job))
+            {
+                OPL3_PoolRenderJob(&pool->jobs[job], pool->numsamples);
+            }
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running == 0)
+        {
+            pthread_cond_signal(&pool->done);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+    return NULL;
+}
+
+/* 固定できれば1。失敗してもワーカーは固定なしで動く */
+static int OPL3_PoolPin(opl3_poolworker *worker, uint32_t numcpus)
+{
+#ifdef __linux__
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(worker->index % numcpus, &set);
+    return pthread_setaffinity_np(worker->thread, sizeof(set), &set) == 0;
+#else
+    (void)worker;
+    (void)numcpus;
+    return 0;
+#endif
+}
+
+opl3_pool *OPL3_PoolCreate(uint32_t numworkers)
+{
+    opl3_pool *pool;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t numcpus = cpus > 0 ? (uint32_t)cpus : 1;
+    uint32_t i;
+
+    if (numworkers == 0)
+    {
+        numworkers = numcpus;
+    }
+    pool = calloc(1, sizeof(opl3_pool));
+    if (!pool)
+    {
+        return NULL;
+    }
+    pool->queues = aligned_alloc(OPL_POOL_CACHELINE,
+                                 numworkers * sizeof(opl3_poolqueue));
+    pool->workers = calloc(numworkers, sizeof(opl3_poolworker));
+    if (!pool->queues || !pool->workers)
+    {
+        free(pool->queues);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    for (i = 0; i < numworkers; i++)
+    {
+        atomic_init(&pool->queues[i].range, 0);
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    for (i = 0; i < numworkers; i++)
+    {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        if (pthread_create(&pool->workers[i].thread, NULL, OPL3_PoolWorker,
+                           &pool->workers[i]) != 0)
+        {
+            break;
+        }
+        pool->numpinned += OPL3_PoolPin(&pool->workers[i], numcpus);
+    }
+    pool->numworkers = i;
+    if (i == 0)
+    {
+        OPL3_PoolDestroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+uint32_t OPL3_PoolPinned(const opl3_pool *pool)
+{
+    return pool->numpinned;
+}
+
+void OPL3_PoolDestroy(opl3_pool *pool)
+{
+    uint32_t i;
+
+    if (!pool)
+    {
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (i = 0; i < pool->numworkers; i++)
+    {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->queues);
+    free(pool->workers);
+    free(pool);
+}
+
+void OPL3_PoolRender(opl3_pool *pool, opl3_pooljob *jobs, uint32_t numjobs,
+                     uint32_t numsamples)
+{
+    uint32_t i, head, tail;
+
+    if (numjobs == 0)
+    {
+        return;
+    }
+    /* チップiの担当は常に同じワーカーになるよう、連続した範囲で分ける */
+    for (i = 0; i < pool->numworkers; i++)
+    {
+        head = (uint32_t)((uint64_t)numjobs * i / pool->numworkers);
+        tail = (uint32_t)((uint64_t)numjobs * (i + 1) / pool->numworkers);
+        atomic_store_explicit(&pool->queues[i].range, OPL3_PoolRange(head, tail),
+                              memory_order_relaxed);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->jobs = jobs;
+    pool->numsamples = numsamples;
+    pool->running = pool->numworkers;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    while (pool->running)
+    {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
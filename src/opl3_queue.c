@@ -0,0 +1,147 @@
+/*
+ * Nuked OPL3 - lock-free register write queue (host only)
+ *
+ * 書き込む側だけがheadを、生成する側だけがtailを進めます。
+ * エントリはheadのrelease/acquireで生成する側に見え、空いた場所は
+ * tailのrelease/acquireで書き込む側に戻ります。書き込む側は最後に
+ * 読んだtailを持っておき、一杯に見えたときだけ読み直します。
+ * headとtailは別のキャッシュラインに置きます。
+ */
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "opl3_queue.h"
+
+#define OPL_QUEUE_CACHELINE 64
+
+typedef struct {
+    uint64_t time;
+    uint16_t reg;
+    uint8_t data;
+} opl3_queueentry;
+
+struct _opl3_queue {
+    /* 書き込む側 */
+    _Atomic uint32_t head;
+    uint32_t tailcache;
+    char pad0[OPL_QUEUE_CACHELINE - 2 * sizeof(uint32_t)];
+    /* 生成する側 */
+    _Atomic uint32_t tail;
+    _Atomic uint64_t now;
+    char pad1[OPL_QUEUE_CACHELINE - sizeof(uint32_t) - sizeof(uint64_t)];
+    /* 作成時に決まる */
+    opl3_queueentry *entries;
+    uint32_t mask;
+    opl3_chip *chip;
+};
+
+opl3_queue *OPL3_QueueCreate(opl3_chip *chip, uint32_t capacity)
+{
+    opl3_queue *queue;
+    uint32_t size = 1;
+
+    while (size < capacity && size < 0x80000000u)
+    {
+        size <<= 1;
+    }
+    queue = aligned_alloc(OPL_QUEUE_CACHELINE,
+                          (sizeof(opl3_queue) + OPL_QUEUE_CACHELINE - 1)
+                          & ~(size_t)(OPL_QUEUE_CACHELINE - 1));
+    if (!queue)
+    {
+        return NULL;
+    }
+    queue->entries = calloc(size, sizeof(opl3_queueentry));
+    if (!queue->entries)
+    {
+        free(queue);
+        return NULL;
+    }
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->now, 0);
+    queue->tailcache = 0;
+    queue->mask = size - 1;
+    queue->chip = chip;
+    return queue;
+}
+
+void OPL3_QueueDestroy(opl3_queue *queue)
+{
+    if (!queue)
+    {
+        return;
+    }
+    free(queue->entries);
+    free(queue);
+}
+
+uint8_t OPL3_QueuePush(opl3_queue *queue, uint64_t time, uint16_t reg, uint8_t data)
+{
+    uint32_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    opl3_queueentry *entry;
+
+    if (head - queue->tailcache > queue->mask)
+    {
+        queue->tailcache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        if (head - queue->tailcache > queue->mask)
+        {
+            return 0;
+        }
+    }
+    entry = &queue->entries[head & queue->mask];
+    entry->time = time;
+    entry->reg = reg;
+    entry->data = data;
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return 1;
+}
+
+uint64_t OPL3_QueueNow(const opl3_queue *queue)
+{
+    return atomic_load_explicit(&queue->now, memory_order_acquire);
+}
+
+void OPL3_QueueRender(opl3_queue *queue, int16_t *sndptr, uint32_t numsamples)
+{
+    uint32_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    uint64_t pos = atomic_load_explicit(&queue->now, memory_order_relaxed);
+    const opl3_queueentry *entry = NULL;
+    uint32_t count;
+
+    for (;;)
+    {
+        count = tail;
+        while (tail != head)
+        {
+            entry = &queue->entries[tail & queue->mask];
+            if (entry->time > pos)
+            {
+                break;
+            }
+            OPL3_WriteReg(queue->chip, entry->reg, entry->data);
+            tail++;
+        }
+        if (tail != count)
+        {
+            /* 適用した分の場所を書き込む側に返す */
+            atomic_store_explicit(&queue->tail, tail, memory_order_release);
+        }
+        if (numsamples == 0)
+        {
+            break;
+        }
+        count = numsamples;
+        if (tail != head && entry->time - pos < count)
+        {
+            count = (uint32_t)(entry->time - pos);
+        }
+        OPL3_GenerateStream(queue->chip, sndptr, count);
+        sndptr += count * 2;
+        pos += count;
+        numsamples -= count;
+    }
+    atomic_store_explicit(&queue->now, pos, memory_order_release);
+}
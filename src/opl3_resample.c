@@ -0,0 +1,478 @@
+/*
+ * Nuked OPL3 - block polyphase resampler (host only)
+ *
+ * ネイティブレートのサンプルをチャンネルごとのfloat配列に溜め、
+ * 出力1サンプルごとに位相で選んだ係数列との内積を取ります。
+ * 出力時刻は整数部pos(配列の位置)と端数frac(出力レート分の1単位)で
+ * 正確に進めるので、長時間生成しても位相がずれません。
+ */
+
+#include "opl3_resample.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#if OPL_RESAMPLE_SIMD
+#include <immintrin.h>
+#endif
+
+#define OPL_RESAMPLE_NATIVE 49716
+#define OPL_RESAMPLE_PHASES 128
+#define OPL_RESAMPLE_PI     3.14159265358979323846
+
+/*
+ * tapsは出力レート換算のタップ数。ダウンサンプル時は入力レートとの比を
+ * 掛けて8の倍数に切り上げる(出力レートに対する遷移帯の幅を揃える)。
+ */
+typedef struct {
+    uint16_t taps;
+    double cutoff;      /* 通過域の端(出力と入力の低い方のナイキスト周波数に対する比) */
+    double beta;        /* カイザー窓 */
+} opl3_resamplepreset;
+
+static const opl3_resamplepreset opl3_resamplepresets[4] = {
+    { 0, 0.0, 0.0 },
+    { 8, 0.80, 5.0 },
+    { 16, 0.88, 7.0 },
+    { 32, 0.93, 9.0 },
+};
+
+/*
+ * FIRのカーネル
+ * x[0..chans)のtaps個のサンプルと、係数 coef[j] + f * coef[taps + j] の
+ * 内積をy[0..chans)に返す。chansは2か4、tapsは8の倍数。
+ */
+typedef void (*opl3_firfunc)(const float *const *x, const float *coef, float f,
+                             uint16_t taps, uint8_t chans, float *y);
+
+typedef struct {
+    opl3_streamhook hook;       /* 先頭に置く(chip->streamhookから戻す) */
+    opl3_firfunc fir;
+    float *coef;                /* OPL_RESAMPLE_PHASES x (係数taps個 + 次の位相との差taps個) */
+    float *in[4];               /* ネイティブレートのサンプル(チャンネルごと) */
+    uint32_t cap;               /* in[]の長さ */
+    uint32_t avail;             /* in[]に溜まっているサンプル数 */
+    uint32_t pos;               /* 次の出力時刻の整数部(in[]の位置) */
+    uint32_t frac;              /* 次の出力時刻の端数(1/outrate単位) */
+    uint32_t outrate;
+    uint32_t stepint;           /* 1出力サンプルあたりの時刻の増分 */
+    uint32_t steprem;
+    float phasescale;           /* OPL_RESAMPLE_PHASES / outrate */
+    uint16_t taps;
+    uint16_t half;
+} opl3_resampler;
+
+static void OPL3_FirScalar(const float *const *x, const float *coef, float f,
+                           uint16_t taps, uint8_t chans, float *y)
+{
+    float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float c;
+    uint16_t j;
+    uint8_t ch;
+
+    for (j = 0; j < taps; j++)
+    {
+        c = coef[j] + f * coef[taps + j];
+        for (ch = 0; ch < chans; ch++)
+        {
+            acc[ch] += x[ch][j] * c;
+        }
+    }
+    for (ch = 0; ch < chans; ch++)
+    {
+        y[ch] = acc[ch];
+    }
+}
+
+#if OPL_RESAMPLE_SIMD
+__attribute__((target("sse2")))
+static float OPL3_FirSum128(__m128 v)
+{
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+__attribute__((target("sse2")))
+static void OPL3_FirSSE2(const float *const *x, const float *coef, float f,
+                         uint16_t taps, uint8_t chans, float *y)
+{
+    const __m128 vf = _mm_set1_ps(f);
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+    __m128 c;
+    uint16_t j;
+
+    for (j = 0; j < taps; j += 4)
+    {
+        c = _mm_add_ps(_mm_loadu_ps(&coef[j]), _mm_mul_ps(vf, _mm_loadu_ps(&coef[taps + j])));
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&x[0][j]), c));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&x[1][j]), c));
+        if (chans > 2)
+        {
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(&x[2][j]), c));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(&x[3][j]), c));
+        }
+    }
+    y[0] = OPL3_FirSum128(acc0);
+    y[1] = OPL3_FirSum128(acc1);
+    if (chans > 2)
+    {
+        y[2] = OPL3_FirSum128(acc2);
+        y[3] = OPL3_FirSum128(acc3);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static float OPL3_FirSum256(__m256 v)
+{
+    return OPL3_FirSum128(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+}
+
+__attribute__((target("avx2,fma")))
+static void OPL3_FirAVX2(const float *const *x, const float *coef, float f,
+                         uint16_t taps, uint8_t chans, float *y)
+{
+    const __m256 vf = _mm256_set1_ps(f);
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+    __m256 c;
+    uint16_t j;
+
+    for (j = 0; j < taps; j += 8)
+    {
+        c = _mm256_fmadd_ps(vf, _mm256_loadu_ps(&coef[taps + j]), _mm256_loadu_ps(&coef[j]));
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[0][j]), c, acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[1][j]), c, acc1);
+        if (chans > 2)
+        {
+            acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[2][j]), c, acc2);
+            acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[3][j]), c, acc3);
+        }
+    }
+    y[0] = OPL3_FirSum256(acc0);
+    y[1] = OPL3_FirSum256(acc1);
+    if (chans > 2)
+    {
+        y[2] = OPL3_FirSum256(acc2);
+        y[3] = OPL3_FirSum256(acc3);
+    }
+}
+#endif
+
+/* CPUに合わせて1度だけ選ぶ(全チップ共通) */
+static opl3_firfunc opl3_fir = 0;
+
+static opl3_firfunc OPL3_FirSelect(void)
+{
+    if (!opl3_fir)
+    {
+        opl3_fir = OPL3_FirScalar;
+#if OPL_RESAMPLE_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        {
+            opl3_fir = OPL3_FirAVX2;
+        }
+        else if (__builtin_cpu_supports("sse2"))
+        {
+            opl3_fir = OPL3_FirSSE2;
+        }
+#endif
+    }
+    return opl3_fir;
+}
+
+/* 第1種変形ベッセル関数I0(カイザー窓用) */
+static double OPL3_ResampleBesselI0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    int k;
+
+    for (k = 1; k < 64 && term > sum * 1e-12; k++)
+    {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+/*
+ * 位相p(0 <= p <= 1)の係数列
+ * 出力時刻n+pに対してj番目のタップはx[n - half + 1 + j]に掛かる。
+ * 直流の利得が1になるように正規化する。
+ */
+static void OPL3_ResamplePhase(double *h, uint16_t taps, double beta, double fc, double p)
+{
+    const uint16_t half = taps / 2;
+    double tau, x, w, sum = 0.0;
+    uint16_t j;
+
+    for (j = 0; j < taps; j++)
+    {
+        tau = (double)j - half + 1 - p;
+        x = tau / half;
+        w = x > -1.0 && x < 1.0
+          ? OPL3_ResampleBesselI0(beta * sqrt(1.0 - x * x)) / OPL3_ResampleBesselI0(beta)
+          : 0.0;
+        h[j] = tau == 0.0 ? 2.0 * fc
+             : sin(2.0 * OPL_RESAMPLE_PI * fc * tau) / (OPL_RESAMPLE_PI * tau);
+        h[j] *= w;
+        sum += h[j];
+    }
+    for (j = 0; j < taps; j++)
+    {
+        h[j] /= sum;
+    }
+}
+
+static void OPL3_ResampleDestroy(opl3_resampler *rs)
+{
+    if (rs)
+    {
+        free(rs->coef);
+        free(rs->in[0]);
+        free(rs);
+    }
+}
+
+static void OPL3_ResampleHookRelease(opl3_streamhook *hook)
+{
+    OPL3_ResampleDestroy((opl3_resampler *)hook);
+}
+
+static void OPL3_ResampleHookStream(opl3_streamhook *hook, opl3_chip *chip,
+                                    int16_t *sndptr1, int16_t *sndptr2, uint32_t numsamples);
+
+/* 出力レートに合わせたタップ数(8の倍数) */
+static uint16_t OPL3_ResampleTaps(uint32_t samplerate, uint8_t quality)
+{
+    uint32_t taps = opl3_resamplepresets[quality].taps;
+
+    if (samplerate < OPL_RESAMPLE_NATIVE)
+    {
+        taps = ((taps * OPL_RESAMPLE_NATIVE + samplerate - 1) / samplerate + 7) & ~7UL;
+    }
+    return (uint16_t)taps;
+}
+
+static opl3_resampler *OPL3_ResampleCreate(uint32_t samplerate, uint8_t quality)
+{
+    const opl3_resamplepreset *preset = &opl3_resamplepresets[quality];
+    const uint16_t taps = OPL3_ResampleTaps(samplerate, quality);
+    double *h[2];
+    double fc;
+    opl3_resampler *rs;
+    float *row;
+    uint32_t k;
+    uint16_t j;
+    uint8_t ch;
+
+    rs = (opl3_resampler *)calloc(1, sizeof(opl3_resampler));
+    if (!rs)
+    {
+        return 0;
+    }
+    rs->taps = taps;
+    rs->half = taps / 2;
+    rs->outrate = samplerate;
+    rs->stepint = OPL_RESAMPLE_NATIVE / samplerate;
+    rs->steprem = OPL_RESAMPLE_NATIVE % samplerate;
+    rs->phasescale = (float)OPL_RESAMPLE_PHASES / (float)samplerate;
+    /* 1ブロック分の出力に要るネイティブサンプル + フィルタの長さ */
+    rs->cap = (uint32_t)((uint64_t)OPL_RESAMPLE_BLOCK * OPL_RESAMPLE_NATIVE / samplerate)
+            + rs->taps + 4;
+    rs->coef = (float *)malloc(sizeof(float) * OPL_RESAMPLE_PHASES * 2 * rs->taps);
+    rs->in[0] = (float *)calloc((size_t)rs->cap * 4, sizeof(float));
+    h[0] = (double *)malloc(sizeof(double) * 2 * taps);
+    if (!rs->coef || !rs->in[0] || !h[0])
+    {
+        free(h[0]);
+        OPL3_ResampleDestroy(rs);
+        return 0;
+    }
+    h[1] = h[0] + taps;
+    for (ch = 1; ch < 4; ch++)
+    {
+        rs->in[ch] = rs->in[ch - 1] + rs->cap;
+    }
+
+    /* 遮断周波数(入力サンプル単位)は入力と出力の低い方のナイキストに合わせる */
+    fc = 0.5 * preset->cutoff;
+    if (samplerate < OPL_RESAMPLE_NATIVE)
+    {
+        fc = fc * samplerate / OPL_RESAMPLE_NATIVE;
+    }
+    OPL3_ResamplePhase(h[0], rs->taps, preset->beta, fc, 0.0);
+    for (k = 0; k < OPL_RESAMPLE_PHASES; k++)
+    {
+        OPL3_ResamplePhase(h[(k + 1) & 1], rs->taps, preset->beta, fc,
+                           (double)(k + 1) / OPL_RESAMPLE_PHASES);
+        row = &rs->coef[k * 2 * rs->taps];
+        for (j = 0; j < rs->taps; j++)
+        {
+            row[j] = (float)h[k & 1][j];
+            row[rs->taps + j] = (float)(h[(k + 1) & 1][j] - h[k & 1][j]);
+        }
+    }
+    free(h[0]);
+
+    /* 先頭の出力がネイティブの0サンプル目になるよう、履歴を無音で埋める */
+    rs->avail = rs->half - 1;
+    rs->pos = rs->half - 1;
+    rs->fir = OPL3_FirSelect();
+    rs->hook.stream = OPL3_ResampleHookStream;
+    rs->hook.release = OPL3_ResampleHookRelease;
+    return rs;
+}
+
+/* countサンプル出力するのに必要なin[]の長さ */
+static uint32_t OPL3_ResampleNeed(const opl3_resampler *rs, uint32_t count)
+{
+    uint64_t last = rs->pos + ((uint64_t)(count - 1) * OPL_RESAMPLE_NATIVE + rs->frac)
+                            / rs->outrate;
+    return (uint32_t)last + rs->half + 1;
+}
+
+/* ネイティブレートでin[avail..need)を生成する */
+static void OPL3_ResampleRender(opl3_resampler *rs, opl3_chip *chip, uint32_t need)
+{
+    int16_t buf4[4];
+    uint32_t i;
+
+    for (i = rs->avail; i < need; i++)
+    {
+        OPL3_Generate4Ch(chip, buf4);
+        rs->in[0][i] = buf4[0];
+        rs->in[1][i] = buf4[1];
+        rs->in[2][i] = buf4[2];
+        rs->in[3][i] = buf4[3];
+    }
+    if (need > rs->avail)
+    {
+        rs->avail = need;
+    }
+}
+
+/* 最近接丸めとクリップ(符号で分岐しないように、比較はmin/maxで行う) */
+static int16_t OPL3_ResampleClip(float v)
+{
+    v = v > 32767.0f ? 32767.0f : v;
+    v = v < -32768.0f ? -32768.0f : v;
+    return (int16_t)lrintf(v);
+}
+
+/*
+ * in[]からcountサンプルを出力する(in[]は足りている前提)
+ * sndptr2がNULLなら前の2チャンネルだけを計算する。
+ */
+static void OPL3_ResampleRun(opl3_resampler *rs, int16_t *sndptr1, int16_t *sndptr2,
+                             uint32_t count)
+{
+    const uint8_t chans = sndptr2 ? 4 : 2;
+    const float *x[4];
+    float y[4];
+    float t, f;
+    uint32_t i, k, off;
+    uint8_t ch;
+
+    for (i = 0; i < count; i++)
+    {
+        t = (float)rs->frac * rs->phasescale;
+        k = (uint32_t)t;
+        f = t - (float)k;
+        if (k >= OPL_RESAMPLE_PHASES)
+        {
+            k = OPL_RESAMPLE_PHASES - 1;
+            f = 1.0f;
+        }
+        off = rs->pos - rs->half + 1;
+        for (ch = 0; ch < chans; ch++)
+        {
+            x[ch] = rs->in[ch] + off;
+        }
+        rs->fir(x, &rs->coef[k * 2 * rs->taps], f, rs->taps, chans, y);
+        sndptr1[0] = OPL3_ResampleClip(y[0]);
+        sndptr1[1] = OPL3_ResampleClip(y[1]);
+        sndptr1 += 2;
+        if (sndptr2)
+        {
+            sndptr2[0] = OPL3_ResampleClip(y[2]);
+            sndptr2[1] = OPL3_ResampleClip(y[3]);
+            sndptr2 += 2;
+        }
+
+        rs->pos += rs->stepint;
+        rs->frac += rs->steprem;
+        if (rs->frac >= rs->outrate)
+        {
+            rs->frac -= rs->outrate;
+            rs->pos++;
+        }
+    }
+}
+
+/* 次の出力に要らなくなった先頭のサンプルを捨てる */
+static void OPL3_ResampleDiscard(opl3_resampler *rs)
+{
+    uint32_t drop = rs->pos - rs->half + 1;
+    uint8_t ch;
+
+    if (drop > rs->avail)
+    {
+        drop = rs->avail;
+    }
+    for (ch = 0; ch < 4; ch++)
+    {
+        memmove(rs->in[ch], rs->in[ch] + drop, sizeof(float) * (rs->avail - drop));
+    }
+    rs->avail -= drop;
+    rs->pos -= drop;
+}
+
+static void OPL3_ResampleHookStream(opl3_streamhook *hook, opl3_chip *chip,
+                                    int16_t *sndptr1, int16_t *sndptr2, uint32_t numsamples)
+{
+    opl3_resampler *rs = (opl3_resampler *)hook;
+    uint32_t count;
+
+    while (numsamples > 0)
+    {
+        count = numsamples > OPL_RESAMPLE_BLOCK ? OPL_RESAMPLE_BLOCK : numsamples;
+        OPL3_ResampleRender(rs, chip, OPL3_ResampleNeed(rs, count));
+        OPL3_ResampleRun(rs, sndptr1, sndptr2, count);
+        OPL3_ResampleDiscard(rs);
+        sndptr1 += count * 2;
+        if (sndptr2)
+        {
+            sndptr2 += count * 2;
+        }
+        numsamples -= count;
+    }
+}
+
+uint8_t OPL3_SetResampler(opl3_chip *chip, uint32_t samplerate, uint8_t quality)
+{
+    opl3_resampler *rs;
+
+    if (quality > OPL_RESAMPLE_HIGH || samplerate < OPL_RESAMPLE_MINRATE)
+    {
+        return OPL_RESAMPLE_BADARG;
+    }
+    if (chip->streamhook)
+    {
+        chip->streamhook->release(chip->streamhook);
+        chip->streamhook = 0;
+    }
+    if (quality == OPL_RESAMPLE_LINEAR)
+    {
+        return OPL_RESAMPLE_OK;
+    }
+    rs = OPL3_ResampleCreate(samplerate, quality);
+    if (!rs)
+    {
+        return OPL_RESAMPLE_NOMEM;
+    }
+    chip->streamhook = &rs->hook;
+    return OPL_RESAMPLE_OK;
+}
@@ -0,0 +1,21 @@
+/*
+ * Nuked OPL3 - z88dk port
+ *
+ * src/opl3.c の定数テーブルの宣言
+ * ホスト向けの拡張(別の翻訳単位)から同じテーブルを参照するために使います。
+ */
+
+#ifndef OPL3_TABLES_H
+#define OPL3_TABLES_H
+
+#include "opl3.h"
+
+extern OPL3_CONST uint16_t exprom[256];
+extern OPL3_CONST uint8_t mt[16];
+extern OPL3_CONST uint8_t kslshift[4];
+extern OPL3_CONST uint8_t eg_addtab[256];
+#if OPL_WAVETAB_LARGE
+extern OPL3_CONST uint16_t opl3_wavetab[OPL_NUM_WAVEFORMS][1024];
+#endif
+
+#endif /* OPL3_TABLES_H */
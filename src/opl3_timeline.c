@@ -0,0 +1,244 @@
+/*
+ * Nuked OPL3 - precomputed event timeline (DRO v2 / IMF)
+ *
+ * デコーダは入力を先頭から1回だけ読み、ソースの時刻(ミリ秒やIMFのtick)を
+ * 64bitで積み上げて、書き込みごとに src_time * samplerate / src_rate で
+ * 出力サンプル位置を求め直します。イベントには直前のイベントとの差分だけを
+ * 入れるので、長い曲でもずれは累積しません。
+ */
+
+#include "opl3_timeline.h"
+
+#if OPL_TIMELINE_DECODE
+#include <stdlib.h>
+#include <string.h>
+
+#define OPL_TIMELINE_GROW   1024
+
+/* DRO v2のヘッダの長さ(署名を含み、コードマップを除く) */
+#define DRO_HEADER          26
+#endif
+
+void OPL3_TimelineStart(opl3_timeline *tl, const opl3_event *events, uint32_t numevents)
+{
+    tl->cur = events;
+    tl->end = events + numevents;
+    tl->remain = numevents ? events[0].wait & OPL_EVENT_MAXWAIT : 0;
+}
+
+uint32_t OPL3_TimelineRender(opl3_timeline *tl, opl3_chip *chip, int16_t *sndptr,
+                             uint32_t numsamples)
+{
+    const opl3_event *ev;
+    uint32_t done = 0, count;
+
+    while (done < numsamples)
+    {
+        if (tl->remain)
+        {
+            /* 次の書き込みまで1回でまとめて生成する */
+            count = numsamples - done;
+            if (tl->remain < count)
+            {
+                count = tl->remain;
+            }
+            OPL3_GenerateStream(chip, sndptr + done * 2, count);
+            tl->remain -= (uint16_t)count;
+            done += count;
+            continue;
+        }
+        if (tl->cur == tl->end)
+        {
+            break;
+        }
+        ev = tl->cur++;
+        OPL3_WriteReg(chip, (uint16_t)(((ev->wait & OPL_EVENT_HIGH) >> 7) | ev->reg), ev->val);
+        if (tl->cur != tl->end)
+        {
+            tl->remain = tl->cur->wait & OPL_EVENT_MAXWAIT;
+        }
+    }
+    return done;
+}
+
+#if OPL_TIMELINE_DECODE
+
+typedef struct {
+    opl3_event *events;
+    uint32_t numevents;
+    uint32_t capacity;
+    uint64_t src_time;          /* ソースの時刻(src_rate単位) */
+    uint64_t out_time;          /* 最後のイベントの出力サンプル位置 */
+    uint32_t src_rate;
+    uint32_t samplerate;
+    uint8_t nomem;
+} opl3_tlbuild;
+
+static void OPL3_TimelineAppend(opl3_tlbuild *b, uint16_t wait, uint8_t reg, uint8_t val)
+{
+    opl3_event *events;
+    uint32_t capacity;
+
+    if (b->numevents == b->capacity)
+    {
+        capacity = b->capacity ? b->capacity * 2 : OPL_TIMELINE_GROW;
+        events = b->nomem ? 0 : (opl3_event *)realloc(b->events, capacity * sizeof(opl3_event));
+        if (!events)
+        {
+            b->nomem = 1;
+            return;
+        }
+        b->events = events;
+        b->capacity = capacity;
+    }
+    b->events[b->numevents].wait = wait;
+    b->events[b->numevents].reg = reg;
+    b->events[b->numevents].val = val;
+    b->numevents++;
+}
+
+/* 現在のソース時刻にregへの書き込みを置く */
+static void OPL3_TimelinePush(opl3_tlbuild *b, uint16_t reg, uint8_t val)
+{
+    uint64_t t = b->src_time * b->samplerate / b->src_rate;
+    uint64_t wait = t - b->out_time;
+
+    while (wait > OPL_EVENT_MAXWAIT)
+    {
+        OPL3_TimelineAppend(b, OPL_EVENT_MAXWAIT, 0x00, 0x00);
+        wait -= OPL_EVENT_MAXWAIT;
+    }
+    OPL3_TimelineAppend(b, (uint16_t)(wait | ((reg & 0x100) << 7)), (uint8_t)reg, val);
+    b->out_time = t;
+}
+
+static void OPL3_TimelineInit(opl3_tlbuild *b, uint32_t src_rate, uint32_t samplerate)
+{
+    memset(b, 0, sizeof(*b));
+    b->src_rate = src_rate;
+    b->samplerate = samplerate;
+}
+
+/* 終わりの待ちを置いて結果を渡す */
+static uint8_t OPL3_TimelineFinish(opl3_tlbuild *b, opl3_event **events, uint32_t *numevents)
+{
+    OPL3_TimelinePush(b, 0x000, 0x00);
+    if (b->nomem)
+    {
+        free(b->events);
+        return OPL_TIMELINE_NOMEM;
+    }
+    *events = b->events;
+    *numevents = b->numevents;
+    return OPL_TIMELINE_OK;
+}
+
+static uint32_t OPL3_TimelineRead32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16)
+         | ((uint32_t)p[3] << 24);
+}
+
+uint8_t OPL3_TimelineFromDro(const uint8_t *data, size_t size, uint32_t samplerate,
+                             opl3_event **events, uint32_t *numevents)
+{
+    opl3_tlbuild b;
+    const uint8_t *p, *codemap, *end;
+    uint32_t pairs;
+    uint16_t reg;
+    uint8_t shortdelay, longdelay, codemaplen;
+
+    if (samplerate == 0 || size < DRO_HEADER || memcmp(data, "DBRAWOPL", 8) != 0
+     || data[8] != 2 || data[9] != 0 || data[10] != 0 || data[11] != 0)
+    {
+        return OPL_TIMELINE_BADFILE;
+    }
+    /* data[20]はハードウェアの種類(0: OPL2, 1: デュアルOPL2, 2: OPL3) */
+    pairs = OPL3_TimelineRead32(&data[12]);
+    /* 非インターリーブ形式と圧縮は定義されていない */
+    if (data[21] != 0 || data[22] != 0)
+    {
+        return OPL_TIMELINE_BADFILE;
+    }
+    shortdelay = data[23];
+    longdelay = data[24];
+    codemaplen = data[25];
+    if (codemaplen > 128 || size < DRO_HEADER + (size_t)codemaplen)
+    {
+        return OPL_TIMELINE_BADFILE;
+    }
+    codemap = &data[DRO_HEADER];
+    p = codemap + codemaplen;
+    /* 途中で切れたファイルは、ある分だけ読む */
+    if ((size_t)(data + size - p) / 2 < pairs)
+    {
+        pairs = (uint32_t)((size_t)(data + size - p) / 2);
+    }
+    end = p + (size_t)pairs * 2;
+
+    OPL3_TimelineInit(&b, 1000, samplerate);
+    for (; p < end; p += 2)
+    {
+        if (p[0] == shortdelay)
+        {
+            b.src_time += p[1] + 1u;
+        }
+        else if (p[0] == longdelay)
+        {
+            b.src_time += (p[1] + 1u) << 8;
+        }
+        else if ((p[0] & 0x7f) < codemaplen)
+        {
+            reg = codemap[p[0] & 0x7f];
+            /* OPL3の2バンク目、またはデュアルOPL2の2チップ目 */
+            if (p[0] & 0x80)
+            {
+                reg |= 0x100;
+            }
+            OPL3_TimelinePush(&b, reg, p[1]);
+        }
+    }
+    return OPL3_TimelineFinish(&b, events, numevents);
+}
+
+uint8_t OPL3_TimelineFromImf(const uint8_t *data, size_t size, uint32_t imfrate,
+                             uint32_t samplerate, opl3_event **events,
+                             uint32_t *numevents)
+{
+    opl3_tlbuild b;
+    const uint8_t *p, *end;
+    size_t len;
+
+    if (samplerate == 0 || imfrate == 0 || size < 4)
+    {
+        return OPL_TIMELINE_BADFILE;
+    }
+    len = (size_t)data[0] | ((size_t)data[1] << 8);
+    if (len != 0 && len % 4 == 0 && len + 2 <= size)
+    {
+        /* タイプ1: 長さ付き */
+        p = data + 2;
+    }
+    else
+    {
+        p = data;
+        len = size & ~(size_t)3;
+    }
+    end = p + len;
+
+    OPL3_TimelineInit(&b, imfrate, samplerate);
+    for (; p < end; p += 4)
+    {
+        /* 書き込んでから待つ */
+        OPL3_TimelinePush(&b, p[0], p[1]);
+        b.src_time += (uint32_t)p[2] | ((uint32_t)p[3] << 8);
+    }
+    return OPL3_TimelineFinish(&b, events, numevents);
+}
+
+void OPL3_TimelineFree(opl3_event *events)
+{
+    free(events);
+}
+
+#endif
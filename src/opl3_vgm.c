@@ -0,0 +1,534 @@
+/*
+ * Nuked OPL3 - memory-mapped VGM player (host only)
+ *
+ * ファイル全体を読み取り専用でmmapし、curをコマンド列の中で進めます。
+ * 時刻はVGMの44100Hz単位(vgm_time)と出力サンプル数(out_time)の
+ * 2本を64bitで持ち、出力側の目標は毎回 vgm_time * samplerate / 44100 で
+ * 求めるので、レートが違っても丸め誤差は累積しません。
+ */
+
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "opl3_vgm.h"
+#include "opl3_index.h"
+
+#define OPL_VGM_LOOPFOREVER 0xffff
+#define OPL_VGM_POSLEN      31      /* 索引に入れる再生位置のバイト数 */
+#define OPL_VGM_SCRATCH     1024
+
+struct _opl3_vgm {
+    const uint8_t *map;
+    size_t size;
+    const uint8_t *cur;         /* 次のコマンド */
+    const uint8_t *end;         /* コマンド列の終わり(EOFオフセット) */
+    const uint8_t *loop;        /* ループ先(なければNULL) */
+    uint64_t vgm_time;          /* 次のコマンドの時刻(44100Hz単位) */
+    uint64_t out_time;          /* 生成済みの出力サンプル数 */
+    uint64_t loop_time;         /* 最後にループした時のvgm_time */
+    uint32_t samplerate;
+    uint16_t loops;             /* 残りのループ回数 */
+    uint8_t flags;
+    uint8_t ended;
+    opl3_vgminfo info;
+    opl3_index *index;
+};
+
+static uint32_t OPL3_VgmRead32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16)
+         | ((uint32_t)p[3] << 24);
+}
+
+/*
+ * コマンドの長さ(バイト数、コマンドバイトを含む)
+ * VGM 1.71までの割り当てに従う。未定義のコマンドもオペランド数は
+ * 範囲ごとに決まっている。end を越える場合は0を返す。
+ */
+static uint32_t OPL3_VgmCmdLength(const uint8_t *p, const uint8_t *end)
+{
+    uint32_t len;
+
+    switch (p[0] & 0xf0)
+    {
+    case 0x30:
+        len = 2;
+        break;
+    case 0x40:
+        len = p[0] == 0x4f ? 2 : 3;
+        break;
+    case 0x50:
+        len = p[0] == 0x50 ? 2 : 3;
+        break;
+    case 0x60:
+        switch (p[0])
+        {
+        case 0x61:
+            len = 3;
+            break;
+        case 0x67:
+            /* データブロック: 0x67 0x66 tt ssssssss */
+            if (end - p < 7)
+            {
+                return 0;
+            }
+            len = 7 + (OPL3_VgmRead32(&p[3]) & 0x7fffffff);
+            break;
+        case 0x68:
+            len = 12;
+            break;
+        default:
+            len = 1;
+            break;
+        }
+        break;
+    case 0x70:
+    case 0x80:
+        len = 1;
+        break;
+    case 0x90:
+        switch (p[0])
+        {
+        case 0x90: case 0x91: case 0x95:
+            len = 5;
+            break;
+        case 0x92:
+            len = 6;
+            break;
+        case 0x93:
+            len = 11;
+            break;
+        case 0x94:
+            len = 2;
+            break;
+        default:
+            len = 1;
+            break;
+        }
+        break;
+    case 0xa0:
+    case 0xb0:
+        len = 3;
+        break;
+    case 0xc0:
+    case 0xd0:
+        len = 4;
+        break;
+    case 0xe0:
+    case 0xf0:
+        len = 5;
+        break;
+    default:
+        len = 1;
+        break;
+    }
+    return (size_t)(end - p) < len ? 0 : len;
+}
+
+static void OPL3_VgmWrite(opl3_vgm *vgm, opl3_chip *chip, uint16_t reg, uint8_t v)
+{
+    if (vgm->flags & OPL_VGM_BUFFERED)
+    {
+        OPL3_WriteRegBuffered(chip, reg, v);
+    }
+    else
+    {
+        OPL3_WriteReg(chip, reg, v);
+    }
+}
+
+/* 終端に来た: ループするか止まる */
+static void OPL3_VgmEnd(opl3_vgm *vgm)
+{
+    /* 待ちのないループは無限に回るので止める */
+    if (vgm->loop && vgm->loops > 0 && vgm->vgm_time != vgm->loop_time)
+    {
+        if (vgm->loops != OPL_VGM_LOOPFOREVER)
+        {
+            vgm->loops--;
+        }
+        vgm->loop_time = vgm->vgm_time;
+        vgm->cur = vgm->loop;
+    }
+    else
+    {
+        vgm->ended = 1;
+    }
+}
+
+/* 次の待ちまでのコマンドを実行し、vgm_timeを進める */
+static void OPL3_VgmStep(opl3_vgm *vgm, opl3_chip *const *chips)
+{
+    const uint8_t *p = vgm->cur;
+    uint32_t len, wait = 0;
+
+    while (!wait)
+    {
+        len = p < vgm->end ? OPL3_VgmCmdLength(p, vgm->end) : 0;
+        if (len == 0 || p[0] == 0x66)
+        {
+            vgm->cur = p;
+            OPL3_VgmEnd(vgm);
+            if (vgm->ended)
+            {
+                return;
+            }
+            p = vgm->cur;
+            continue;
+        }
+        switch (p[0])
+        {
+        case 0x5e:
+        case 0x5f:
+            OPL3_VgmWrite(vgm, chips[0], (uint16_t)(((p[0] & 0x01) << 8) | p[1]), p[2]);
+            break;
+        case 0xae:
+        case 0xaf:
+            if (vgm->info.numchips > 1)
+            {
+                OPL3_VgmWrite(vgm, chips[1], (uint16_t)(((p[0] & 0x01) << 8) | p[1]), p[2]);
+            }
+            break;
+        case 0x61:
+            wait = (uint32_t)p[1] | ((uint32_t)p[2] << 8);
+            break;
+        case 0x62:
+            wait = 735;
+            break;
+        case 0x63:
+            wait = 882;
+            break;
+        default:
+            if ((p[0] & 0xf0) == 0x70)
+            {
+                wait = (p[0] & 0x0f) + 1u;
+            }
+            else if ((p[0] & 0xf0) == 0x80)
+            {
+                /* YM2612のDAC書き込み + n サンプル待ち */
+                wait = p[0] & 0x0fu;
+            }
+            break;
+        }
+        p += len;
+        /* 長さ0の待ち(0x61 00 00)は次のコマンドへ */
+        vgm->vgm_time += wait;
+    }
+    vgm->cur = p;
+}
+
+/* ヘッダを読んでコマンド列の範囲を決める。YMF262がなければ0を返す */
+static int OPL3_VgmParse(opl3_vgm *vgm)
+{
+    const uint8_t *map = vgm->map;
+    uint32_t version, dataofs, eofofs, loopofs, clock;
+
+    if (vgm->size < 0x40 || memcmp(map, "Vgm ", 4) != 0)
+    {
+        return 0;
+    }
+    version = OPL3_VgmRead32(&map[0x08]);
+    dataofs = version >= 0x150 && OPL3_VgmRead32(&map[0x34])
+            ? 0x34 + OPL3_VgmRead32(&map[0x34]) : 0x40;
+    eofofs = 0x04 + OPL3_VgmRead32(&map[0x04]);
+    if (eofofs > vgm->size || eofofs < dataofs)
+    {
+        eofofs = (uint32_t)vgm->size;
+    }
+    if (dataofs >= eofofs)
+    {
+        return 0;
+    }
+    /* データの開始位置より後ろのヘッダ項目は無効(0とみなす) */
+    clock = version >= 0x151 && dataofs >= 0x60 ? OPL3_VgmRead32(&map[0x5c]) : 0;
+    if ((clock & 0x3fffffff) == 0)
+    {
+        return 0;
+    }
+    loopofs = OPL3_VgmRead32(&map[0x1c]);
+    if (loopofs && 0x1c + loopofs >= dataofs && 0x1c + loopofs < eofofs)
+    {
+        vgm->loop = map + 0x1c + loopofs;
+    }
+
+    vgm->cur = map + dataofs;
+    vgm->end = map + eofofs;
+    vgm->info.version = version;
+    vgm->info.clock = clock & 0x3fffffff;
+    vgm->info.total_samples = OPL3_VgmRead32(&map[0x18]);
+    vgm->info.loop_samples = vgm->loop ? OPL3_VgmRead32(&map[0x20]) : 0;
+    vgm->info.numchips = (clock & 0x40000000) ? 2 : 1;
+    return 1;
+}
+
+opl3_vgm *OPL3_VgmOpen(const char *path, uint32_t samplerate, uint8_t flags)
+{
+    opl3_vgm *vgm;
+    void *map;
+    struct stat st;
+    int fd;
+
+    if (samplerate == 0)
+    {
+        return 0;
+    }
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return 0;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return 0;
+    }
+    map = mmap(0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        return 0;
+    }
+    vgm = (opl3_vgm *)calloc(1, sizeof(opl3_vgm));
+    if (vgm)
+    {
+        vgm->map = (const uint8_t *)map;
+        vgm->size = (size_t)st.st_size;
+    }
+    if (!vgm || !OPL3_VgmParse(vgm))
+    {
+        free(vgm);
+        munmap(map, (size_t)st.st_size);
+        return 0;
+    }
+    vgm->samplerate = samplerate;
+    vgm->flags = flags;
+    vgm->loop_time = ~(uint64_t)0;
+#ifdef MADV_SEQUENTIAL
+    madvise(map, vgm->size, MADV_SEQUENTIAL);
+#endif
+    return vgm;
+}
+
+void OPL3_VgmClose(opl3_vgm *vgm)
+{
+    if (vgm)
+    {
+        munmap((void *)vgm->map, vgm->size);
+        OPL3_IndexFree(vgm->index);
+        free(vgm);
+    }
+}
+
+const opl3_vgminfo *OPL3_VgmInfo(const opl3_vgm *vgm)
+{
+    return &vgm->info;
+}
+
+void OPL3_VgmSetLoops(opl3_vgm *vgm, uint16_t loops)
+{
+    vgm->loops = loops;
+}
+
+uint32_t OPL3_VgmRender(opl3_vgm *vgm, opl3_chip *const *chips, int16_t *const *sndptr,
+                        uint32_t numsamples)
+{
+    uint64_t target;
+    uint32_t done = 0, count;
+    uint8_t i;
+
+    while (done < numsamples)
+    {
+        target = vgm->vgm_time * vgm->samplerate / OPL_VGM_RATE;
+        if (vgm->out_time < target)
+        {
+            /* 次の書き込みの時刻まで1回でまとめて生成する */
+            count = numsamples - done;
+            if (target - vgm->out_time < count)
+            {
+                count = (uint32_t)(target - vgm->out_time);
+            }
+            for (i = 0; i < vgm->info.numchips; i++)
+            {
+                OPL3_GenerateStream(chips[i], sndptr[i] + done * 2, count);
+            }
+            vgm->out_time += count;
+            done += count;
+            continue;
+        }
+        if (vgm->ended)
+        {
+            break;
+        }
+        OPL3_VgmStep(vgm, chips);
+    }
+    return done;
+}
+
+static void OPL3_VgmPut32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void OPL3_VgmPut64(uint8_t *p, uint64_t v)
+{
+    OPL3_VgmPut32(p, (uint32_t)v);
+    OPL3_VgmPut32(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint64_t OPL3_VgmRead64(const uint8_t *p)
+{
+    return OPL3_VgmRead32(p) | ((uint64_t)OPL3_VgmRead32(p + 4) << 32);
+}
+
+/*
+ * 再生位置: curのオフセット(4), vgm_time(8), out_time(8), loop_time(8),
+ * 残りのループ回数(2), 終了(1)
+ */
+static void OPL3_VgmGetPos(const opl3_vgm *vgm, uint8_t *pos)
+{
+    OPL3_VgmPut32(pos, (uint32_t)(vgm->cur - vgm->map));
+    OPL3_VgmPut64(pos + 4, vgm->vgm_time);
+    OPL3_VgmPut64(pos + 12, vgm->out_time);
+    OPL3_VgmPut64(pos + 20, vgm->loop_time);
+    pos[28] = (uint8_t)vgm->loops;
+    pos[29] = (uint8_t)(vgm->loops >> 8);
+    pos[30] = vgm->ended;
+}
+
+static uint8_t OPL3_VgmSetPos(opl3_vgm *vgm, const uint8_t *pos, uint16_t poslen)
+{
+    uint32_t cur;
+
+    if (poslen != OPL_VGM_POSLEN)
+    {
+        return OPL_INDEX_BADFILE;
+    }
+    cur = OPL3_VgmRead32(pos);
+    if (cur > (size_t)(vgm->end - vgm->map))
+    {
+        return OPL_INDEX_BADFILE;
+    }
+    vgm->cur = vgm->map + cur;
+    vgm->vgm_time = OPL3_VgmRead64(pos + 4);
+    vgm->out_time = OPL3_VgmRead64(pos + 12);
+    vgm->loop_time = OPL3_VgmRead64(pos + 20);
+    vgm->loops = (uint16_t)(pos[28] | (pos[29] << 8));
+    vgm->ended = pos[30] & 0x01;
+    return OPL_INDEX_OK;
+}
+
+/* ファイルの内容とループ回数から索引のキーを作る */
+static uint32_t OPL3_VgmIndexKey(const opl3_vgm *vgm)
+{
+    uint8_t loops[2];
+
+    loops[0] = (uint8_t)vgm->loops;
+    loops[1] = (uint8_t)(vgm->loops >> 8);
+    return OPL3_IndexKey(vgm->map, vgm->size) ^ OPL3_IndexKey(loops, 2);
+}
+
+uint8_t OPL3_VgmBuildIndex(opl3_vgm *vgm, opl3_chip *const *chips, uint32_t interval,
+                           const char *path)
+{
+    int16_t scratch[2][OPL_VGM_SCRATCH * 2];
+    int16_t *sndptr[2] = { scratch[0], scratch[1] };
+    const uint8_t *pos;
+    uint8_t start[OPL_VGM_POSLEN];
+    uint64_t at;
+    uint32_t count, n, left = interval;
+    uint16_t poslen;
+    uint8_t err;
+
+    OPL3_IndexFree(vgm->index);
+    vgm->index = OPL3_IndexCreate(vgm->info.numchips, vgm->samplerate, interval,
+                                  OPL3_VgmIndexKey(vgm));
+    if (!vgm->index)
+    {
+        return OPL_INDEX_NOMEM;
+    }
+    OPL3_VgmGetPos(vgm, start);
+    err = OPL3_IndexAdd(vgm->index, vgm->out_time, start, sizeof(start), chips);
+    while (err == OPL_INDEX_OK)
+    {
+        count = left < OPL_VGM_SCRATCH ? left : OPL_VGM_SCRATCH;
+        n = OPL3_VgmRender(vgm, chips, sndptr, count);
+        left -= n;
+        if (n < count)
+        {
+            break;
+        }
+        if (left == 0)
+        {
+            OPL3_VgmGetPos(vgm, start);
+            err = OPL3_IndexAdd(vgm->index, vgm->out_time, start, sizeof(start), chips);
+            left = interval;
+        }
+    }
+    if (err == OPL_INDEX_OK)
+    {
+        err = OPL3_IndexSave(vgm->index, path);
+    }
+    if (err != OPL_INDEX_OK)
+    {
+        OPL3_IndexFree(vgm->index);
+        vgm->index = 0;
+        return err;
+    }
+    /* 先頭のチェックポイントに戻す */
+    err = OPL3_IndexFind(vgm->index, 0, chips, &at, &pos, &poslen);
+    return err == OPL_INDEX_OK ? OPL3_VgmSetPos(vgm, pos, poslen) : err;
+}
+
+uint8_t OPL3_VgmLoadIndex(opl3_vgm *vgm, const char *path)
+{
+    opl3_index *index;
+    uint8_t err;
+
+    err = OPL3_IndexLoad(&index, path, vgm->info.numchips, vgm->samplerate,
+                         OPL3_VgmIndexKey(vgm));
+    if (err == OPL_INDEX_OK)
+    {
+        OPL3_IndexFree(vgm->index);
+        vgm->index = index;
+    }
+    return err;
+}
+
+uint8_t OPL3_VgmSeek(opl3_vgm *vgm, opl3_chip *const *chips, uint64_t sample)
+{
+    int16_t scratch[2][OPL_VGM_SCRATCH * 2];
+    int16_t *sndptr[2] = { scratch[0], scratch[1] };
+    const uint8_t *pos;
+    uint64_t at;
+    uint32_t count;
+    uint16_t poslen;
+    uint8_t err;
+
+    err = OPL3_IndexFind(vgm->index, sample, chips, &at, &pos, &poslen);
+    if (err == OPL_INDEX_OK)
+    {
+        err = OPL3_VgmSetPos(vgm, pos, poslen);
+    }
+    /* チェックポイントから残りを生成して捨てる */
+    while (err == OPL_INDEX_OK && at < sample)
+    {
+        count = sample - at < OPL_VGM_SCRATCH ? (uint32_t)(sample - at) : OPL_VGM_SCRATCH;
+        if (OPL3_VgmRender(vgm, chips, sndptr, count) < count)
+        {
+            break;
+        }
+        at += count;
+    }
+    return err;
+}
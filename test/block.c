@@ -0,0 +1,142 @@
+/*
+ * Slot-major block renderer test (Nuked-OPL3/opl3.c)
+ *
+ * 同じ初期化と書き込みを与えた2つのチップを、OPL3_GenerateBlockと
+ * 1サンプルずつのOPL3_Generateでそれぞれ生成し、出力が一致することを
+ * 確認します。ブロックの長さはOPL_BLOCK_SIZEをまたぐものを含めて
+ * ばらばらにし、ブロックの間に直接の書き込みとOPL3_WriteRegBufferedの
+ * 書き込み(ブロックの途中で期限が来るもの)を入れます。
+ * OPL_QUIRK_CHANNELSAMPLEDELAYの有無はビルドを分けて検査します。
+ *
+ * 使い方:
+ *   block [-p passes]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Nuked-OPL3/opl3.h"
+
+/* src側と同じ既定値(表示用) */
+#ifndef OPL_QUIRK_CHANNELSAMPLEDELAY
+#define OPL_QUIRK_CHANNELSAMPLEDELAY (!OPL_ENABLE_STEREOEXT)
+#endif
+
+#define BLOCK_MAX       (OPL_BLOCK_SIZE * 3 + 5)
+#define BLOCK_PASSES    2000
+
+static uint32_t block_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* 4op、リズム、フィードバック、ビブラートとトレモロを含む音色にする */
+static void block_setup(opl3_chip *chip)
+{
+    uint16_t high, ch, op;
+
+    OPL3_Reset(chip, 49716);
+    OPL3_WriteReg(chip, 0x105, 0x01);
+    OPL3_WriteReg(chip, 0x104, 0x09);
+    OPL3_WriteReg(chip, 0xbd, 0xc0);
+    for (ch = 0; ch < 18; ch++)
+    {
+        high = ch >= 9 ? 0x100 : 0x000;
+        op = (ch % 9 % 3) + (ch % 9 / 3) * 8;
+        OPL3_WriteReg(chip, high | (0x20 + op), 0x21 | ((ch & 0x03) << 6));
+        OPL3_WriteReg(chip, high | (0x23 + op), 0x21 | ((ch & 0x0c) << 4));
+        OPL3_WriteReg(chip, high | (0x60 + op), 0xf2 + (ch & 0x0f));
+        OPL3_WriteReg(chip, high | (0x63 + op), 0xe4);
+        OPL3_WriteReg(chip, high | (0xe0 + op), ch & 0x07);
+        OPL3_WriteReg(chip, high | (0xc0 + ch % 9), 0x30 | (ch & 0x0f));
+        OPL3_WriteReg(chip, high | (0xa0 + ch % 9), (uint8_t)(0x40 + ch * 7));
+        OPL3_WriteReg(chip, high | (0xb0 + ch % 9), 0x31);
+    }
+}
+
+static uint16_t block_reg(uint32_t r)
+{
+    static const uint8_t regs[] = { 0xa0, 0xb0, 0x40, 0x43, 0xc0, 0x60, 0x80, 0xe0 };
+
+    if ((r & 0x1f) == 0)
+    {
+        return 0xbd;
+    }
+    return (uint16_t)((r & 0x100) | (regs[(r >> 9) % sizeof(regs)] + (r >> 16) % 9));
+}
+
+int main(int argc, char **argv)
+{
+    opl3_chip *block = calloc(1, sizeof(opl3_chip));
+    opl3_chip *serial = calloc(1, sizeof(opl3_chip));
+    int16_t blockbuf[BLOCK_MAX * 2], serialbuf[BLOCK_MAX * 2];
+    uint32_t passes = BLOCK_PASSES, state = 1, p, i, n, r;
+    unsigned long samples = 0, failed = 0;
+    uint16_t reg;
+    uint8_t data;
+
+    if (argc == 3 && argv[1][0] == '-' && argv[1][1] == 'p')
+    {
+        passes = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    else if (argc != 1)
+    {
+        fprintf(stderr, "usage: block [-p passes]\n");
+        return 2;
+    }
+    if (!block || !serial)
+    {
+        fprintf(stderr, "block: out of memory\n");
+        return 1;
+    }
+    block_setup(block);
+    block_setup(serial);
+
+    for (p = 0; p < passes; p++)
+    {
+        /* ブロックの間の書き込み(直接と、数サンプル後に期限が来るもの) */
+        n = block_rand(&state) % 4;
+        for (i = 0; i < n; i++)
+        {
+            r = block_rand(&state);
+            reg = block_reg(r);
+            data = (uint8_t)block_rand(&state);
+            if (r & 0x80)
+            {
+                OPL3_WriteRegBuffered(block, reg, data);
+                OPL3_WriteRegBuffered(serial, reg, data);
+            }
+            else
+            {
+                OPL3_WriteReg(block, reg, data);
+                OPL3_WriteReg(serial, reg, data);
+            }
+        }
+
+        r = block_rand(&state);
+        n = r & 0x100 ? r % BLOCK_MAX : r % 8;
+        OPL3_GenerateBlock(block, blockbuf, n);
+        for (i = 0; i < n; i++)
+        {
+            OPL3_Generate(serial, serialbuf + i * 2);
+        }
+        if (memcmp(blockbuf, serialbuf, n * 2 * sizeof(int16_t)))
+        {
+            fprintf(stderr, "block: pass %lu (%lu samples) differs\n",
+                    (unsigned long)p, (unsigned long)n);
+            failed++;
+        }
+        samples += n;
+    }
+
+    printf("block (quirk %d): %lu passes, %lu samples, %lu failed\n",
+           OPL_QUIRK_CHANNELSAMPLEDELAY, (unsigned long)passes, samples, failed);
+    free(block);
+    free(serial);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+/*
+ * Cross-chip SIMD bundle test
+ *
+ * OPL_BUNDLE_LANES個のopl3_chipとバンドルに同じレジスタ書き込みを与え、
+ * OPL3_Generate4Chとレーンごとの出力がサンプル単位で一致することを
+ * 確認します。書き込みはレーンごとに別の乱数列で、途中でレーン単位の
+ * リセットも行います。後半はOPL3_BundleGenerateStreamと
+ * OPL3_Generateの繰り返しを比較します(どちらもリサンプルなし)。
+ *
+ * 使い方:
+ *   bundle [-s seed] [-n events]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "opl3_bundle.h"
+
+#define BUNDLE_CHUNK    256
+
+static uint32_t bundle_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* test/golden.cと同じ分布(キーオン、リズム、4op、波形選択を含む) */
+static void bundle_randwrite(uint32_t *state, uint16_t *reg, uint8_t *v)
+{
+    static const uint8_t slotregs[5] = { 0x20, 0x40, 0x60, 0x80, 0xe0 };
+    static const uint16_t globalregs[8] = {
+        0x01, 0x02, 0x03, 0x04, 0x08, 0x104, 0x105, 0x105
+    };
+    uint32_t r = bundle_rand(state);
+    uint16_t high = (r & 0x10) ? 0x100 : 0x000;
+
+    *v = (uint8_t)(r >> 24);
+    switch (r & 0x0f)
+    {
+    case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7:
+        *reg = high | (slotregs[(r >> 5) % 5] + (r >> 8) % 0x16);
+        break;
+    case 8: case 9:
+        *reg = high | (0xa0 + (r >> 5) % 9);
+        break;
+    case 10: case 11:
+        *reg = high | (0xb0 + (r >> 5) % 9);
+        if ((r >> 16) & 0x03)
+        {
+            *v |= 0x20;
+        }
+        break;
+    case 12:
+        *reg = high | (0xc0 + (r >> 5) % 9);
+        break;
+    case 13:
+        *reg = 0xbd;
+        break;
+    default:
+        *reg = globalregs[(r >> 5) & 0x07];
+        if (*reg == 0x105)
+        {
+            *v &= 0x03;
+        }
+        break;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static opl3_chip chips[OPL_BUNDLE_LANES];
+    static int16_t chipbuf[BUNDLE_CHUNK * 2];
+    static int16_t lanebuf[OPL_BUNDLE_LANES][BUNDLE_CHUNK * 2];
+    int16_t *sndptr[OPL_BUNDLE_LANES];
+    int16_t buf4[OPL_BUNDLE_LANES][4];
+    int16_t ref4[4];
+    opl3_bundle *bundle;
+    uint32_t seed = 1, events = 2048;
+    uint32_t state, e, i, lane, wait;
+    unsigned long samples = 0, failed = 0;
+    uint16_t reg;
+    uint8_t v;
+    int arg;
+
+    for (arg = 1; arg + 1 < argc; arg += 2)
+    {
+        switch (argv[arg][1])
+        {
+        case 's':
+            seed = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        case 'n':
+            events = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: bundle [-s seed] [-n events]\n");
+            return 2;
+        }
+    }
+
+    bundle = OPL3_BundleCreate();
+    if (!bundle)
+    {
+        fprintf(stderr, "bundle: out of memory\n");
+        return 1;
+    }
+    for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+    {
+        OPL3_Reset(&chips[lane], 49716);
+        sndptr[lane] = lanebuf[lane];
+    }
+    state = seed ? seed : 1;
+
+    /* 1サンプルずつ: OPL3_BundleGenerate4Ch */
+    for (e = 0; e < events && !failed; e++)
+    {
+        for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+        {
+            if (bundle_rand(&state) % 512 == 0)
+            {
+                OPL3_Reset(&chips[lane], 49716);
+                OPL3_BundleReset(bundle, (uint8_t)lane);
+            }
+            if (bundle_rand(&state) & 1)
+            {
+                bundle_randwrite(&state, &reg, &v);
+                OPL3_WriteReg(&chips[lane], reg, v);
+                OPL3_BundleWriteReg(bundle, (uint8_t)lane, reg, v);
+            }
+        }
+        wait = bundle_rand(&state) % 64;
+        for (i = 0; i < wait && !failed; i++, samples++)
+        {
+            OPL3_BundleGenerate4Ch(bundle, buf4);
+            for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+            {
+                OPL3_Generate4Ch(&chips[lane], ref4);
+                if (ref4[0] != buf4[lane][0] || ref4[1] != buf4[lane][1]
+                 || ref4[2] != buf4[lane][2] || ref4[3] != buf4[lane][3])
+                {
+                    fprintf(stderr, "bundle: lane %lu differs at sample %lu:"
+                            " %d,%d,%d,%d ref %d,%d,%d,%d\n",
+                            (unsigned long)lane, samples,
+                            buf4[lane][0], buf4[lane][1], buf4[lane][2], buf4[lane][3],
+                            ref4[0], ref4[1], ref4[2], ref4[3]);
+                    failed++;
+                }
+            }
+        }
+    }
+
+    /* まとめて: OPL3_BundleGenerateStream */
+    for (e = 0; e < events / 16 && !failed; e++)
+    {
+        for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+        {
+            for (i = bundle_rand(&state) % 8; i > 0; i--)
+            {
+                bundle_randwrite(&state, &reg, &v);
+                OPL3_WriteReg(&chips[lane], reg, v);
+                OPL3_BundleWriteReg(bundle, (uint8_t)lane, reg, v);
+            }
+        }
+        wait = 1 + bundle_rand(&state) % BUNDLE_CHUNK;
+        OPL3_BundleGenerateStream(bundle, sndptr, wait);
+        for (lane = 0; lane < OPL_BUNDLE_LANES && !failed; lane++)
+        {
+            for (i = 0; i < wait; i++)
+            {
+                OPL3_Generate(&chips[lane], &chipbuf[i * 2]);
+            }
+            for (i = 0; i < wait * 2; i++)
+            {
+                if (chipbuf[i] != lanebuf[lane][i])
+                {
+                    fprintf(stderr, "bundle: lane %lu stream differs at sample %lu\n",
+                            (unsigned long)lane, samples + i / 2);
+                    failed++;
+                    break;
+                }
+            }
+        }
+        samples += wait;
+    }
+
+    printf("bundle: %d lanes, %lu samples compared, %lu failed\n",
+           OPL_BUNDLE_LANES, samples, failed);
+    for (lane = 0; lane < OPL_BUNDLE_LANES; lane++)
+    {
+        OPL3_Release(&chips[lane]);
+    }
+    OPL3_BundleDestroy(bundle);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,417 @@
+/*
+ * Golden-reference regression test for Nuked-OPL3 on z88dk
+ *
+ * 移植版(src/opl3.c)と元の実装(Nuked-OPL3/opl3.c)に同じレジスタ書き込み
+ * 列を与え、OPL3_GenerateStreamの出力をサンプル単位で比較します。
+ * 入力はシード付きの乱数ストリームと、test/corpus/ の曲ダンプです。
+ * 最初に不一致になったサンプルを報告し、終了コード1で終了します。
+ *
+ * 使い方:
+ *   golden [-b] [-s seed] [-n streams] [-r samplerate] [-t tolerance]
+ *          [corpus.opl ...]
+ *
+ * -b を付けると OPL3_WriteReg の代わりに OPL3_WriteRegBuffered で
+ * 書き込みます(書き込み間隔の遅延と時刻順の処理を比較)。
+ * -t を付けると差がtolerance以下のサンプルを一致とみなし、最大誤差を
+ * 表示します(OPL_RESAMPLE_FAST=1でビルドした移植版の検査用)。
+ *
+ * -DOPL3_PROFILE_OPL2=1 でビルドすると、OPL2専用の移植版と比べるため
+ * 上位バンク(0x100-0x1FF)への書き込みを両方のエンジンで捨て、下位バンク
+ * だけの書き込み列で比較します(make test-opl2)。
+ *
+ * サンプルレートを指定しない場合は、ネイティブ(49716Hz)と
+ * リサンプル(44100Hz)の両方で実行します。
+ * 乱数ストリームのうち1本は、eg_timerを36bitの折り返し直前から始めます。
+ *
+ * 曲ダンプの書式(1行1イベント、#以降はコメント):
+ *   105 01      レジスタ0x105に0x01を書き込む(16進)
+ *   w 1000      1000サンプル待つ(10進)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "golden.h"
+
+#define GOLDEN_CHUNK        4096
+#define GOLDEN_EVENTS       256
+#define GOLDEN_STREAMS      64
+#define GOLDEN_EGWRAP       (0xfffffffffULL - 0x2000)
+
+#if defined(OPL3_PROFILE_OPL2) && OPL3_PROFILE_OPL2
+#define GOLDEN_OPL2         1
+#else
+#define GOLDEN_OPL2         0
+#endif
+
+typedef struct {
+    const char *name;
+    void *port;
+    void *ref;
+    unsigned long pos;
+    unsigned long writes;
+    uint16_t lastreg;
+    uint8_t lastval;
+    int16_t portbuf[GOLDEN_CHUNK * 2];
+    int16_t refbuf[GOLDEN_CHUNK * 2];
+} golden_session;
+
+static unsigned long total_samples;
+static int buffered;
+static int tolerance;
+static int max_error;
+
+/* tolerance以内ならcount、超えたら最初のサンプル位置(2チャンネル単位)を返す */
+static uint32_t session_compare(const int16_t *port, const int16_t *ref, uint32_t count)
+{
+    uint32_t i;
+    int d;
+
+    if (tolerance == 0)
+    {
+        if (memcmp(port, ref, count * 2 * sizeof(int16_t)) == 0)
+        {
+            return count;
+        }
+        for (i = 0; i < count * 2; i += 2)
+        {
+            if (port[i] != ref[i] || port[i + 1] != ref[i + 1])
+            {
+                break;
+            }
+        }
+        return i / 2;
+    }
+    for (i = 0; i < count * 2; i++)
+    {
+        d = port[i] - ref[i];
+        d = d < 0 ? -d : d;
+        if (d > max_error)
+        {
+            max_error = d;
+        }
+        if (d > tolerance)
+        {
+            return i / 2;
+        }
+    }
+    return count;
+}
+
+static int session_open(golden_session *s, const char *name, uint32_t samplerate)
+{
+    s->name = name;
+    s->port = golden_port.create(samplerate);
+    s->ref = golden_ref.create(samplerate);
+    s->pos = 0;
+    s->writes = 0;
+    s->lastreg = 0;
+    s->lastval = 0;
+    if (!s->port || !s->ref)
+    {
+        fprintf(stderr, "%s: out of memory\n", name);
+        return 0;
+    }
+    return 1;
+}
+
+static void session_close(golden_session *s)
+{
+    golden_port.destroy(s->port);
+    golden_ref.destroy(s->ref);
+}
+
+static void session_write(golden_session *s, uint16_t reg, uint8_t v)
+{
+    if (GOLDEN_OPL2 && (reg & 0x100))
+    {
+        return;
+    }
+    if (buffered)
+    {
+        golden_port.writebuffered(s->port, reg, v);
+        golden_ref.writebuffered(s->ref, reg, v);
+    }
+    else
+    {
+        golden_port.write(s->port, reg, v);
+        golden_ref.write(s->ref, reg, v);
+    }
+    s->writes++;
+    s->lastreg = reg;
+    s->lastval = v;
+}
+
+/* numsamples分生成して比較、不一致なら0を返す */
+static int session_wait(golden_session *s, unsigned long numsamples)
+{
+    uint32_t count, i;
+
+    while (numsamples > 0)
+    {
+        count = numsamples > GOLDEN_CHUNK ? GOLDEN_CHUNK : (uint32_t)numsamples;
+        golden_port.stream(s->port, s->portbuf, count);
+        golden_ref.stream(s->ref, s->refbuf, count);
+        i = session_compare(s->portbuf, s->refbuf, count) * 2;
+        if (i < count * 2)
+        {
+            fprintf(stderr, "%s: mismatch at sample %lu: port %d,%d ref %d,%d"
+                    " (after write #%lu %03x=%02x)\n",
+                    s->name, s->pos + i / 2,
+                    s->portbuf[i], s->portbuf[i + 1],
+                    s->refbuf[i], s->refbuf[i + 1],
+                    s->writes, s->lastreg, s->lastval);
+            return 0;
+        }
+        s->pos += count;
+        total_samples += count;
+        numsamples -= count;
+    }
+    return 1;
+}
+
+/* 乱数ストリーム */
+
+static uint32_t golden_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static void golden_randwrite(uint32_t *state, uint16_t *reg, uint8_t *v)
+{
+    static const uint8_t slotregs[5] = { 0x20, 0x40, 0x60, 0x80, 0xe0 };
+    static const uint16_t globalregs[8] = {
+        0x01, 0x02, 0x03, 0x04, 0x08, 0x104, 0x105, 0x105
+    };
+    uint32_t r = golden_rand(state);
+    uint16_t high = (r & 0x10) ? 0x100 : 0x000;
+
+    *v = (uint8_t)(r >> 24);
+    switch (r & 0x0f)
+    {
+    case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7:
+        /* 0x16-0x17等の空き番地も含めて書き込む */
+        *reg = high | (slotregs[(r >> 5) % 5] + (r >> 8) % 0x16);
+        break;
+    case 8: case 9:
+        *reg = high | (0xa0 + (r >> 5) % 9);
+        break;
+    case 10: case 11:
+        *reg = high | (0xb0 + (r >> 5) % 9);
+        if ((r >> 16) & 0x03)
+        {
+            *v |= 0x20;
+        }
+        break;
+    case 12:
+        *reg = high | (0xc0 + (r >> 5) % 9);
+        break;
+    case 13:
+        *reg = 0xbd;
+        break;
+    default:
+        *reg = globalregs[(r >> 5) & 0x07];
+        if (*reg == 0x105)
+        {
+            *v &= 0x03;
+        }
+        break;
+    }
+}
+
+static unsigned long golden_randwait(uint32_t *state)
+{
+    uint32_t r = golden_rand(state);
+
+    if ((r & 0x0f) == 0)
+    {
+        return (r >> 8) % 4096;
+    }
+    return (r >> 8) % 64;
+}
+
+static int run_random(uint32_t seed, uint32_t samplerate, uint64_t egtimer)
+{
+    golden_session s;
+    char name[64];
+    uint32_t state = seed ? seed : 1;
+    uint16_t reg;
+    uint8_t v;
+    int i, ok = 1;
+
+    sprintf(name, "random seed %lu @%luHz%s", (unsigned long)seed,
+            (unsigned long)samplerate, egtimer ? " egwrap" : "");
+    if (!session_open(&s, name, samplerate))
+    {
+        session_close(&s);
+        return 0;
+    }
+    if (egtimer)
+    {
+        golden_port.setegtimer(s.port, egtimer);
+        golden_ref.setegtimer(s.ref, egtimer);
+    }
+    /* 半分のストリームはOPL3モードで開始する */
+    if (golden_rand(&state) & 1)
+    {
+        session_write(&s, 0x105, 0x01);
+    }
+    for (i = 0; i < GOLDEN_EVENTS && ok; i++)
+    {
+        golden_randwrite(&state, &reg, &v);
+        session_write(&s, reg, v);
+        ok = session_wait(&s, golden_randwait(&state));
+    }
+    if (ok)
+    {
+        ok = session_wait(&s, 8192);
+    }
+    session_close(&s);
+    return ok;
+}
+
+/* 曲ダンプ */
+
+static int run_corpus(const char *path, uint32_t samplerate)
+{
+    golden_session s;
+    char name[512];
+    char line[256];
+    char *p;
+    unsigned long wait;
+    unsigned int reg, v;
+    unsigned long lineno = 0;
+    FILE *f;
+    int ok = 1;
+
+    f = fopen(path, "r");
+    if (!f)
+    {
+        perror(path);
+        return 0;
+    }
+    sprintf(name, "%.400s @%luHz", path, (unsigned long)samplerate);
+    if (!session_open(&s, name, samplerate))
+    {
+        session_close(&s);
+        fclose(f);
+        return 0;
+    }
+    while (ok && fgets(line, sizeof(line), f))
+    {
+        lineno++;
+        p = strchr(line, '#');
+        if (p)
+        {
+            *p = '\0';
+        }
+        p = line;
+        while (*p == ' ' || *p == '\t')
+        {
+            p++;
+        }
+        if (*p == '\0' || *p == '\n' || *p == '\r')
+        {
+            continue;
+        }
+        if (sscanf(p, "w %lu", &wait) == 1)
+        {
+            ok = session_wait(&s, wait);
+        }
+        else if (sscanf(p, "%x %x", &reg, &v) == 2 && reg < 0x200 && v < 0x100)
+        {
+            session_write(&s, (uint16_t)reg, (uint8_t)v);
+        }
+        else
+        {
+            fprintf(stderr, "%s:%lu: syntax error\n", path, lineno);
+            ok = 0;
+        }
+    }
+    if (ok)
+    {
+        ok = session_wait(&s, 8192);
+    }
+    session_close(&s);
+    fclose(f);
+    return ok;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: golden [-b] [-s seed] [-n streams] [-r samplerate]"
+            " [-t tolerance] [corpus.opl ...]\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t defrates[2] = { 49716, 44100 };
+    uint32_t rates[2];
+    int numrates = 2;
+    uint32_t seed = 1;
+    unsigned long streams = GOLDEN_STREAMS;
+    unsigned long i, failed = 0, runs = 0;
+    int r, arg;
+
+    memcpy(rates, defrates, sizeof(rates));
+    for (arg = 1; arg < argc && argv[arg][0] == '-'; arg++)
+    {
+        if (argv[arg][1] == 'b')
+        {
+            buffered = 1;
+            continue;
+        }
+        if (arg + 1 >= argc)
+        {
+            usage();
+        }
+        switch (argv[arg][1])
+        {
+        case 's':
+            seed = (uint32_t)strtoul(argv[++arg], NULL, 0);
+            break;
+        case 'n':
+            streams = strtoul(argv[++arg], NULL, 0);
+            break;
+        case 'r':
+            rates[0] = (uint32_t)strtoul(argv[++arg], NULL, 0);
+            numrates = 1;
+            break;
+        case 't':
+            tolerance = atoi(argv[++arg]);
+            break;
+        default:
+            usage();
+        }
+    }
+
+    for (r = 0; r < numrates; r++)
+    {
+        for (i = arg; i < (unsigned long)argc; i++, runs++)
+        {
+            failed += !run_corpus(argv[i], rates[r]);
+        }
+        for (i = 0; i < streams; i++, runs++)
+        {
+            failed += !run_random(seed + (uint32_t)i, rates[r], 0);
+        }
+        failed += !run_random(seed, rates[r], GOLDEN_EGWRAP);
+        runs++;
+    }
+
+    printf("golden%s%s: %lu runs, %lu samples compared, %lu failed",
+           GOLDEN_OPL2 ? " (opl2)" : "", buffered ? " (buffered)" : "",
+           runs, total_samples, failed);
+    if (tolerance)
+    {
+        printf(", max error %d (tolerance %d)", max_error, tolerance);
+    }
+    printf("\n");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,27 @@
+/*
+ * Golden-reference harness for Nuked-OPL3 on z88dk
+ *
+ * 移植版(src/opl3.c)と元の実装(Nuked-OPL3/opl3.c)は同じシンボル名を
+ * 持つため、それぞれ別の翻訳単位で公開関数に接頭辞を付けて取り込み、
+ * このインターフェース経由で呼び出します。
+ */
+
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+#include <stdint.h>
+
+typedef struct {
+    const char *name;
+    void *(*create)(uint32_t samplerate);
+    void (*destroy)(void *chip);
+    void (*write)(void *chip, uint16_t reg, uint8_t v);
+    void (*writebuffered)(void *chip, uint16_t reg, uint8_t v);
+    void (*stream)(void *chip, int16_t *sndptr, uint32_t numsamples);
+    void (*setegtimer)(void *chip, uint64_t value);
+} golden_engine;
+
+extern const golden_engine golden_port;
+extern const golden_engine golden_ref;
+
+#endif
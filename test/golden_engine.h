@@ -0,0 +1,78 @@
+/*
+ * エンジンのラッパー生成
+ *
+ * GOLDEN_PREFIXを定義してからインクルードし、続けて実装(.c)を
+ * インクルードした後に GOLDEN_ENGINE(name) でラッパーを定義します。
+ * GOLDEN_SET_EGTIMER(chip, value) はエンジンごとに定義します。
+ */
+
+#include <stdlib.h>
+#include "golden.h"
+
+#define GOLDEN_CAT_(a, b) a##b
+#define GOLDEN_CAT(a, b) GOLDEN_CAT_(a, b)
+
+#define OPL3_Reset              GOLDEN_CAT(GOLDEN_PREFIX, OPL3_Reset)
+#define OPL3_WriteReg           GOLDEN_CAT(GOLDEN_PREFIX, OPL3_WriteReg)
+#define OPL3_WriteRegBuffered   GOLDEN_CAT(GOLDEN_PREFIX, OPL3_WriteRegBuffered)
+#define OPL3_Release            GOLDEN_CAT(GOLDEN_PREFIX, OPL3_Release)
+#define OPL3_Generate           GOLDEN_CAT(GOLDEN_PREFIX, OPL3_Generate)
+#define OPL3_GenerateResampled  GOLDEN_CAT(GOLDEN_PREFIX, OPL3_GenerateResampled)
+#define OPL3_GenerateStream     GOLDEN_CAT(GOLDEN_PREFIX, OPL3_GenerateStream)
+#define OPL3_GenerateBlock      GOLDEN_CAT(GOLDEN_PREFIX, OPL3_GenerateBlock)
+#define OPL3_Generate4Ch        GOLDEN_CAT(GOLDEN_PREFIX, OPL3_Generate4Ch)
+#define OPL3_Generate4ChResampled GOLDEN_CAT(GOLDEN_PREFIX, OPL3_Generate4ChResampled)
+#define OPL3_Generate4ChStream  GOLDEN_CAT(GOLDEN_PREFIX, OPL3_Generate4ChStream)
+
+/* チップ破棄時の後始末(エンジンが持つ場合だけ定義する) */
+#ifndef GOLDEN_RELEASE
+#define GOLDEN_RELEASE(chip) ((void)(chip))
+#endif
+/* 直接の書き込みとストリーム生成の回数を数える場合に定義する */
+#ifndef GOLDEN_COUNT_WRITE
+#define GOLDEN_COUNT_WRITE() ((void)0)
+#endif
+#ifndef GOLDEN_COUNT_STREAM
+#define GOLDEN_COUNT_STREAM() ((void)0)
+#endif
+
+#define GOLDEN_ENGINE(name)                                                 \
+static void *golden_create(uint32_t samplerate)                             \
+{                                                                           \
+    opl3_chip *chip = calloc(1, sizeof(opl3_chip));                         \
+    if (chip)                                                               \
+    {                                                                       \
+        OPL3_Reset(chip, samplerate);                                       \
+    }                                                                       \
+    return chip;                                                            \
+}                                                                           \
+static void golden_destroy(void *chip)                                      \
+{                                                                           \
+    if (chip)                                                               \
+    {                                                                       \
+        GOLDEN_RELEASE((opl3_chip *)chip);                                  \
+    }                                                                       \
+    free(chip);                                                             \
+}                                                                           \
+static void golden_write(void *chip, uint16_t reg, uint8_t v)               \
+{                                                                           \
+    GOLDEN_COUNT_WRITE();                                                   \
+    OPL3_WriteReg((opl3_chip *)chip, reg, v);                               \
+}                                                                           \
+static void golden_writebuffered(void *chip, uint16_t reg, uint8_t v)       \
+{                                                                           \
+    OPL3_WriteRegBuffered((opl3_chip *)chip, reg, v);                       \
+}                                                                           \
+static void golden_stream(void *chip, int16_t *sndptr, uint32_t numsamples) \
+{                                                                           \
+    GOLDEN_COUNT_STREAM();                                                  \
+    OPL3_GenerateStream((opl3_chip *)chip, sndptr, numsamples);             \
+}                                                                           \
+static void golden_setegtimer(void *chip, uint64_t value)                   \
+{                                                                           \
+    GOLDEN_SET_EGTIMER((opl3_chip *)chip, value);                           \
+}                                                                           \
+const golden_engine GOLDEN_CAT(golden_, name) = {                           \
+    #name, golden_create, golden_destroy, golden_write,                     \
+    golden_writebuffered, golden_stream, golden_setegtimer                  \
+}
@@ -0,0 +1,45 @@
+/*
+ * 移植版エンジン (src/opl3.c) のラッパー
+ *
+ * make test-bank はこのファイルをOPL_BANK_PART=1と2で2回コンパイルし、
+ * 分けたsrc/opl3.cでも同じ出力になることを確かめます。
+ */
+
+#define GOLDEN_PREFIX port_
+#if OPL_BANK_PART == 1 && defined OPL_BANK_MAP
+/*
+ * 出したバンクを覚え、チップ破棄の時点で戻っていることを確かめる。
+ * 切り替えはリセットとストリーム生成の出入り口と、ためた直接の書き込みが
+ * 一杯になった時だけなので、その回数の2倍を超えないことも確かめる
+ */
+#include <assert.h>
+#include <stdint.h>
+static uint8_t golden_bank = 0;
+static uint32_t golden_switches, golden_streams, golden_writes;
+uint8_t OPL_BANK_MAP(uint8_t bank)
+{
+    uint8_t prev = golden_bank;
+    golden_bank = bank;
+    golden_switches++;
+    return prev;
+}
+#define GOLDEN_COUNT_WRITE() (golden_writes++)
+#define GOLDEN_COUNT_STREAM() (golden_streams++)
+#define GOLDEN_RELEASE(chip)                                                \
+    (OPL3_Release(chip), assert(golden_bank == 0),                          \
+     assert(golden_switches                                                 \
+            <= 2 * (1 + golden_streams + golden_writes / OPL_BANK_PENDING)), \
+     golden_switches = golden_streams = golden_writes = 0)
+#else
+#define GOLDEN_RELEASE(chip) OPL3_Release(chip)
+#endif
+#define GOLDEN_SET_EGTIMER(chip, value)                                     \
+    ((chip)->eg_timer = (uint16_t)(value),                                  \
+     (chip)->eg_timerhi = (uint32_t)((value) >> 16))
+#include "golden_engine.h"
+#include "../src/opl3.c"
+
+/* 切り替える側(OPL_BANK_PART=2)には公開関数がない */
+#if OPL_BANK_PART != 2
+GOLDEN_ENGINE(port);
+#endif
@@ -0,0 +1,10 @@
+/*
+ * 元の実装 (Nuked-OPL3/opl3.c) のラッパー
+ */
+
+#define GOLDEN_PREFIX ref_
+#define GOLDEN_SET_EGTIMER(chip, value) ((chip)->eg_timer = (value))
+#include "golden_engine.h"
+#include "../Nuked-OPL3/opl3.c"
+
+GOLDEN_ENGINE(ref);
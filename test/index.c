@@ -0,0 +1,546 @@
+/*
+ * Checkpoint index / seek test
+ *
+ * 乱数で組み立てた2チップ構成のVGM(ループあり)とタイムラインについて
+ * 索引を作り、サイドカーファイルから読み直して、ばらばらの位置へ
+ * シークした後の出力が、先頭から通しで生成した出力とサンプル単位で
+ * 一致することを確かめます。ログやループ回数が違う索引と、壊れた
+ * 索引ファイルを読まないことも検査します。2チップの片方の状態が
+ * 壊れた索引ではどちらのチップも書き換えないこと、OPL3_SetResamplerの
+ * ストリームフックが付いたチップでは作成もシークもしないことも
+ * 確かめます。
+ *
+ * 使い方:
+ *   index [-s seed] [-n seeks]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "opl3_index.h"
+#include "opl3_resample.h"
+#include "opl3_vgm.h"
+
+#define INDEX_RATE      44100
+#define INDEX_INTERVAL  22050
+#define INDEX_VGMSTEPS  1500
+#define INDEX_VGMSIZE   (0x100 + INDEX_VGMSTEPS * 3 + 1)
+#define INDEX_EVENTS    3000
+#define INDEX_COMPARE   3000
+#define INDEX_STATEMAX  4096
+
+static uint32_t index_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* test/golden.cと同じ分布のレジスタ書き込み(キーオンを多めに) */
+static void index_randreg(uint32_t *state, uint16_t *reg, uint8_t *v)
+{
+    static const uint8_t slotregs[5] = { 0x20, 0x40, 0x60, 0x80, 0xe0 };
+    uint32_t r = index_rand(state);
+    uint16_t high = (r & 0x10) ? 0x100 : 0x000;
+
+    *v = (uint8_t)(r >> 24);
+    switch (r & 0x07)
+    {
+    case 0: case 1: case 2:
+        *reg = high | (slotregs[(r >> 5) % 5] + (r >> 8) % 0x16);
+        break;
+    case 3: case 4:
+        *reg = high | (0xa0 + (r >> 5) % 9);
+        break;
+    case 5:
+        *reg = high | (0xb0 + (r >> 5) % 9);
+        *v |= 0x20;
+        break;
+    case 6:
+        *reg = high | (0xc0 + (r >> 5) % 9);
+        break;
+    default:
+        *reg = (r & 0x100) ? 0xbd : 0x105;
+        if (*reg == 0x105)
+        {
+            *v &= 0x01;
+        }
+        break;
+    }
+}
+
+static void index_put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/* 2チップ構成、ループありのVGM(合計で約12秒) */
+static uint32_t index_buildvgm(uint8_t *data, uint32_t *state)
+{
+    uint32_t size = 0x100, step, wait, loopofs = 0, total = 0, looptime = 0;
+    uint16_t reg;
+    uint8_t v;
+
+    memset(data, 0, 0x100);
+    for (step = 0; step < INDEX_VGMSTEPS; step++)
+    {
+        if (step == INDEX_VGMSTEPS / 3)
+        {
+            loopofs = size;
+            looptime = total;
+        }
+        if (index_rand(state) % 3)
+        {
+            index_randreg(state, &reg, &v);
+            data[size++] = (uint8_t)(((index_rand(state) & 1) ? 0xae : 0x5e) | (reg >> 8));
+            data[size++] = (uint8_t)reg;
+            data[size++] = v;
+        }
+        else
+        {
+            wait = index_rand(state) % 1200;
+            data[size++] = 0x61;
+            data[size++] = (uint8_t)wait;
+            data[size++] = (uint8_t)(wait >> 8);
+            total += wait;
+        }
+    }
+    data[size++] = 0x66;
+    memcpy(data, "Vgm ", 4);
+    index_put32(&data[0x04], size - 0x04);
+    index_put32(&data[0x08], 0x171);
+    index_put32(&data[0x18], total);
+    index_put32(&data[0x1c], loopofs - 0x1c);
+    index_put32(&data[0x20], total - looptime);
+    index_put32(&data[0x34], 0x100 - 0x34);
+    index_put32(&data[0x5c], 14318180 | 0x40000000);
+    return size;
+}
+
+static int index_writefile(const char *path, const uint8_t *data, uint32_t size)
+{
+    FILE *fp = fopen(path, "wb");
+    int ok;
+
+    if (!fp)
+    {
+        perror(path);
+        return 0;
+    }
+    ok = fwrite(data, 1, size, fp) == size;
+    return fclose(fp) == 0 && ok;
+}
+
+/* シーク先の一覧(先頭、チェックポイント上、その直前、終わり、終わりの後と乱数) */
+static uint64_t index_target(uint32_t *state, uint32_t n, uint32_t len)
+{
+    switch (n)
+    {
+    case 0:
+        return 0;
+    case 1:
+        return INDEX_INTERVAL;
+    case 2:
+        return 2 * INDEX_INTERVAL - 1;
+    case 3:
+        return len;
+    case 4:
+        return (uint64_t)len + 100;
+    default:
+        return index_rand(state) % len;
+    }
+}
+
+static int index_compare(const int16_t *out, const int16_t *ref, uint32_t count,
+                         const char *what, uint64_t target)
+{
+    uint32_t i;
+
+    for (i = 0; i < count * 2; i++)
+    {
+        if (out[i] != ref[i])
+        {
+            fprintf(stderr, "index: %s seek to %lu differs at +%lu: %d, expected %d\n", what,
+                    (unsigned long)target, (unsigned long)(i / 2), out[i], ref[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int index_vgm(const char *path, uint32_t *state, uint32_t seeks)
+{
+    static uint8_t data[INDEX_VGMSIZE];
+    static opl3_chip chips[2];
+    static int16_t out[2][INDEX_COMPARE * 2];
+    opl3_chip *chipptr[2] = { &chips[0], &chips[1] };
+    int16_t *ref[2] = { 0, 0 }, *sndptr[2];
+    char idxpath[64];
+    opl3_vgm *vgm;
+    uint64_t target;
+    uint32_t size, len = 0, maxlen, n, count, got;
+    uint8_t c, err;
+    int ok = 1;
+
+    size = index_buildvgm(data, state);
+    snprintf(idxpath, sizeof(idxpath), "%s.idx", path);
+    if (!index_writefile(path, data, size))
+    {
+        return 0;
+    }
+
+    /* 先頭から通しで生成した参照 */
+    maxlen = (uint32_t)(((uint64_t)INDEX_VGMSTEPS * 1200 * 2) * INDEX_RATE / OPL_VGM_RATE);
+    vgm = OPL3_VgmOpen(path, INDEX_RATE, 0);
+    ref[0] = (int16_t *)malloc((size_t)maxlen * 4);
+    ref[1] = (int16_t *)malloc((size_t)maxlen * 4);
+    if (!vgm || !ref[0] || !ref[1])
+    {
+        fprintf(stderr, "index: cannot set up the VGM reference\n");
+        OPL3_VgmClose(vgm);
+        free(ref[0]);
+        free(ref[1]);
+        return 0;
+    }
+    OPL3_VgmSetLoops(vgm, 1);
+    for (c = 0; c < 2; c++)
+    {
+        OPL3_Reset(&chips[c], INDEX_RATE);
+    }
+    len = OPL3_VgmRender(vgm, chipptr, ref, maxlen);
+    OPL3_VgmClose(vgm);
+
+    /* 索引を作る。終わると先頭に戻っていること */
+    vgm = OPL3_VgmOpen(path, INDEX_RATE, 0);
+    OPL3_VgmSetLoops(vgm, 1);
+    for (c = 0; c < 2; c++)
+    {
+        OPL3_Release(&chips[c]);
+        OPL3_Reset(&chips[c], INDEX_RATE);
+    }
+    err = OPL3_VgmBuildIndex(vgm, chipptr, INDEX_INTERVAL, idxpath);
+    if (err != OPL_INDEX_OK)
+    {
+        fprintf(stderr, "index: building the VGM index failed (%u)\n", err);
+        ok = 0;
+    }
+    else
+    {
+        sndptr[0] = out[0];
+        sndptr[1] = out[1];
+        got = OPL3_VgmRender(vgm, chipptr, sndptr, INDEX_COMPARE);
+        ok = got == INDEX_COMPARE && index_compare(out[0], ref[0], got, "rewound VGM", 0)
+          && index_compare(out[1], ref[1], got, "rewound VGM", 0);
+    }
+    OPL3_VgmClose(vgm);
+
+    /* 索引を読み直してシークする */
+    vgm = OPL3_VgmOpen(path, INDEX_RATE, 0);
+    OPL3_VgmSetLoops(vgm, 1);
+    for (c = 0; c < 2; c++)
+    {
+        OPL3_Release(&chips[c]);
+        OPL3_Reset(&chips[c], INDEX_RATE);
+    }
+    if (ok && (err = OPL3_VgmLoadIndex(vgm, idxpath)) != OPL_INDEX_OK)
+    {
+        fprintf(stderr, "index: loading the VGM index failed (%u)\n", err);
+        ok = 0;
+    }
+    for (n = 0; n < seeks && ok; n++)
+    {
+        target = index_target(state, n, len);
+        err = OPL3_VgmSeek(vgm, chipptr, target);
+        count = target < len ? len - (uint32_t)target : 0;
+        if (count > INDEX_COMPARE)
+        {
+            count = INDEX_COMPARE;
+        }
+        got = OPL3_VgmRender(vgm, chipptr, sndptr, INDEX_COMPARE);
+        if (err != OPL_INDEX_OK || got != count)
+        {
+            fprintf(stderr, "index: VGM seek to %lu: error %u, %lu samples (expected %lu)\n",
+                    (unsigned long)target, err, (unsigned long)got, (unsigned long)count);
+            ok = 0;
+        }
+        for (c = 0; c < 2 && ok; c++)
+        {
+            ok = index_compare(out[c], ref[c] + target * 2, count, "VGM", target);
+        }
+    }
+    OPL3_VgmClose(vgm);
+
+    /* ループ回数やログが違えば使わない */
+    vgm = OPL3_VgmOpen(path, INDEX_RATE, 0);
+    OPL3_VgmSetLoops(vgm, 2);
+    if (ok && OPL3_VgmLoadIndex(vgm, idxpath) != OPL_INDEX_STALE)
+    {
+        fprintf(stderr, "index: loaded an index built for another loop count\n");
+        ok = 0;
+    }
+    OPL3_VgmClose(vgm);
+    data[0x100 + 2] ^= 0x01;
+    index_writefile(path, data, size);
+    vgm = OPL3_VgmOpen(path, INDEX_RATE, 0);
+    OPL3_VgmSetLoops(vgm, 1);
+    if (ok && OPL3_VgmLoadIndex(vgm, idxpath) != OPL_INDEX_STALE)
+    {
+        fprintf(stderr, "index: loaded an index built for another file\n");
+        ok = 0;
+    }
+    OPL3_VgmClose(vgm);
+
+    for (c = 0; c < 2; c++)
+    {
+        OPL3_Release(&chips[c]);
+        free(ref[c]);
+    }
+    unlink(idxpath);
+    return ok;
+}
+
+static int index_timeline(const char *path, uint32_t *state, uint32_t seeks)
+{
+    static opl3_event events[INDEX_EVENTS];
+    static opl3_chip chip;
+    static int16_t out[INDEX_COMPARE * 2];
+    opl3_index *index = 0;
+    opl3_timeline tl;
+    int16_t *ref;
+    uint64_t target;
+    uint32_t i, len = 0, count, got, n, key;
+    uint16_t reg;
+    uint8_t err, v;
+    int ok = 1;
+    FILE *fp;
+
+    for (i = 0; i < INDEX_EVENTS; i++)
+    {
+        index_randreg(state, &reg, &v);
+        events[i].wait = (uint16_t)((index_rand(state) % 4 ? index_rand(state) % 150 : 0)
+                                    | ((reg & 0x100) << 7));
+        events[i].reg = (uint8_t)reg;
+        events[i].val = v;
+        len += events[i].wait & OPL_EVENT_MAXWAIT;
+    }
+    key = OPL3_IndexKey((const uint8_t *)events, sizeof(events));
+    ref = (int16_t *)malloc((size_t)len * 4 + 4);
+    if (!ref)
+    {
+        return 0;
+    }
+    OPL3_Reset(&chip, INDEX_RATE);
+    OPL3_TimelineStart(&tl, events, INDEX_EVENTS);
+    len = OPL3_TimelineRender(&tl, &chip, ref, len + 1);
+    OPL3_Release(&chip);
+
+    OPL3_Reset(&chip, INDEX_RATE);
+    err = OPL3_TimelineBuildIndex(events, INDEX_EVENTS, &chip, INDEX_RATE, INDEX_INTERVAL / 4,
+                                  key, path);
+    if (err == OPL_INDEX_OK)
+    {
+        err = OPL3_IndexLoad(&index, path, 1, INDEX_RATE, key);
+    }
+    if (err != OPL_INDEX_OK || OPL3_IndexCount(index) != len / (INDEX_INTERVAL / 4) + 1)
+    {
+        fprintf(stderr, "index: timeline index failed (%u)\n", err);
+        ok = 0;
+    }
+    for (n = 0; n < seeks && ok; n++)
+    {
+        target = index_target(state, n, len);
+        err = OPL3_TimelineSeek(&tl, events, INDEX_EVENTS, index, &chip, target);
+        count = target < len ? len - (uint32_t)target : 0;
+        if (count > INDEX_COMPARE)
+        {
+            count = INDEX_COMPARE;
+        }
+        got = OPL3_TimelineRender(&tl, &chip, out, INDEX_COMPARE);
+        if (err != OPL_INDEX_OK || got != count)
+        {
+            fprintf(stderr, "index: timeline seek to %lu: error %u, %lu samples (expected %lu)\n",
+                    (unsigned long)target, err, (unsigned long)got, (unsigned long)count);
+            ok = 0;
+        }
+        ok = ok && index_compare(out, ref + target * 2, count, "timeline", target);
+    }
+    OPL3_IndexFree(index);
+    index = 0;
+
+    /* 別のレートや壊れたファイルは読まない */
+    if (ok && OPL3_IndexLoad(&index, path, 1, 48000, key) != OPL_INDEX_STALE)
+    {
+        fprintf(stderr, "index: loaded an index built for another rate\n");
+        ok = 0;
+    }
+    if (ok && truncate(path, 1000) == 0 && OPL3_IndexLoad(&index, path, 1, INDEX_RATE, key)
+        != OPL_INDEX_BADFILE)
+    {
+        fprintf(stderr, "index: loaded a truncated index\n");
+        ok = 0;
+    }
+    fp = fopen(path, "wb");
+    if (fp)
+    {
+        fputs("not an index", fp);
+        fclose(fp);
+    }
+    if (ok && OPL3_IndexLoad(&index, path, 1, INDEX_RATE, key) != OPL_INDEX_BADFILE)
+    {
+        fprintf(stderr, "index: loaded a file without the signature\n");
+        ok = 0;
+    }
+    OPL3_Release(&chip);
+    free(ref);
+    return ok;
+}
+
+/* 鳴らしたチップの状態を少し進める */
+static void index_play(opl3_chip *chip, uint32_t *state)
+{
+    static int16_t buf[256 * 2];
+    uint16_t reg;
+    uint32_t i;
+    uint8_t v;
+
+    for (i = 0; i < 40; i++)
+    {
+        index_randreg(state, &reg, &v);
+        OPL3_WriteReg(chip, reg, v);
+    }
+    OPL3_GenerateStream(chip, buf, 256);
+}
+
+static int index_guard(const char *path, uint32_t *state)
+{
+    static const opl3_event events[2] = { { 100, 0x20, 0x01 }, { 100, 0xb0, 0x20 } };
+    static opl3_chip chips[2];
+    static uint8_t before[INDEX_STATEMAX], after[INDEX_STATEMAX];
+    opl3_chip *chipptr[2] = { &chips[0], &chips[1] };
+    opl3_index *index;
+    const uint8_t *pos;
+    uint8_t buf[4], err, c;
+    uint64_t at;
+    uint32_t size0, size1;
+    uint16_t poslen;
+    int ok = 1;
+    FILE *fp;
+
+    for (c = 0; c < 2; c++)
+    {
+        OPL3_Reset(&chips[c], INDEX_RATE);
+        index_play(&chips[c], state);
+    }
+    index = OPL3_IndexCreate(2, INDEX_RATE, INDEX_INTERVAL, 1);
+    err = index ? OPL3_IndexAdd(index, 0, (const uint8_t *)"ab", 2, chipptr) : OPL_INDEX_NOMEM;
+    if (err == OPL_INDEX_OK)
+    {
+        err = OPL3_IndexSave(index, path);
+    }
+    OPL3_IndexFree(index);
+    index = 0;
+
+    /* 2番目のチップの状態の署名を壊す(長さはそのままなので読み込める) */
+    fp = err == OPL_INDEX_OK ? fopen(path, "r+b") : 0;
+    ok = fp && fseek(fp, 24 + 10 + 2, SEEK_SET) == 0 && fread(buf, 1, 4, fp) == 4;
+    size0 = buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16)
+          | ((uint32_t)buf[3] << 24);
+    ok = ok && fseek(fp, 24 + 10 + 2 + 4 + (long)size0 + 4, SEEK_SET) == 0
+       && fputc('X', fp) != EOF;
+    if (fp)
+    {
+        ok = fclose(fp) == 0 && ok;
+    }
+    if (!ok || OPL3_IndexLoad(&index, path, 2, INDEX_RATE, 1) != OPL_INDEX_OK)
+    {
+        fprintf(stderr, "index: cannot set up the damaged two-chip index\n");
+        OPL3_IndexFree(index);
+        return 0;
+    }
+    for (c = 0; c < 2; c++)
+    {
+        index_play(&chips[c], state);
+    }
+    size0 = OPL3_SaveState(&chips[0], before, sizeof(before));
+    err = OPL3_IndexFind(index, 0, chipptr, &at, &pos, &poslen);
+    size1 = OPL3_SaveState(&chips[0], after, sizeof(after));
+    if (err != OPL_INDEX_BADFILE || size0 == 0 || size0 != size1
+     || memcmp(before, after, size0) != 0)
+    {
+        fprintf(stderr, "index: a damaged second state changed the first chip (%u)\n", err);
+        ok = 0;
+    }
+
+    /* ストリームフックが付いていれば作成もシークもしない */
+    if (OPL3_SetResampler(&chips[0], INDEX_RATE, OPL_RESAMPLE_MEDIUM) != OPL_RESAMPLE_OK)
+    {
+        fprintf(stderr, "index: cannot set the polyphase resampler\n");
+        ok = 0;
+    }
+    if (ok && OPL3_IndexFind(index, 0, chipptr, &at, &pos, &poslen) != OPL_INDEX_HOOKED)
+    {
+        fprintf(stderr, "index: restored a chip with a stream hook\n");
+        ok = 0;
+    }
+    if (ok && OPL3_TimelineBuildIndex(events, 2, &chips[0], INDEX_RATE, INDEX_INTERVAL, 1,
+                                      path) != OPL_INDEX_HOOKED)
+    {
+        fprintf(stderr, "index: built an index through a stream hook\n");
+        ok = 0;
+    }
+    OPL3_IndexFree(index);
+    for (c = 0; c < 2; c++)
+    {
+        OPL3_Release(&chips[c]);
+    }
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    char path[] = "/tmp/opl3idxXXXXXX";
+    uint32_t seed = 1, seeks = 24, state, failed = 0;
+    int arg, fd;
+
+    for (arg = 1; arg + 1 < argc; arg += 2)
+    {
+        switch (argv[arg][1])
+        {
+        case 's':
+            seed = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        case 'n':
+            seeks = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: index [-s seed] [-n seeks]\n");
+            return 2;
+        }
+    }
+    fd = mkstemp(path);
+    if (fd < 0)
+    {
+        perror("mkstemp");
+        return 1;
+    }
+    close(fd);
+    state = seed ? seed : 1;
+
+    failed += !index_vgm(path, &state, seeks);
+    failed += !index_timeline(path, &state, seeks);
+    failed += !index_guard(path, &state);
+    unlink(path);
+
+    printf("index: VGM and timeline, %lu seeks each, %lu failed\n",
+           (unsigned long)seeks, (unsigned long)failed);
+    return failed ? 1 : 0;
+}
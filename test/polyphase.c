@@ -0,0 +1,364 @@
+/*
+ * Block polyphase resampler test
+ *
+ * 1. SIMDカーネルの内積がスカラー版と(floatの丸めの範囲で)一致すること
+ * 2. 各プリセットと出力レートで、通過域の正弦波が理想値に近く、
+ *    高域の正弦波で折り返しとイメージが少ないこと
+ *    (比較のため同じ信号を線形補間した場合の値も表示)
+ * 3. OPL3_GenerateStreamを1回で呼んだ場合と、ばらばらの長さで
+ *    繰り返し呼んだ場合の出力がビット単位で一致し、
+ *    OPL3_Generate4ChStreamの前2チャンネルとも一致すること
+ *
+ * 使い方:
+ *   polyphase [-s seed]
+ */
+
+/* staticな内部関数を直接呼ぶため、実装をそのまま取り込む */
+#include "../src/opl3_resample.c"
+
+#include <stdio.h>
+
+#define POLY_SAMPLES    8192
+#define POLY_STREAM     40000
+#define POLY_AMP        16384.0
+
+typedef struct {
+    uint8_t quality;
+    double pass_db;     /* 通過域の誤差の上限 */
+    double image_db;    /* 折り返しとイメージの上限 */
+} poly_limit;
+
+/*
+ * 上限はすべての出力レートで共通(タップ数が多いほど厳しい)
+ * HIGHは出力の16bitへの丸め(約-95dB)で頭打ちになる。
+ */
+static const poly_limit limits[3] = {
+    { OPL_RESAMPLE_LOW, -50.0, -60.0 },
+    { OPL_RESAMPLE_MEDIUM, -75.0, -80.0 },
+    { OPL_RESAMPLE_HIGH, -90.0, -90.0 },
+};
+
+static const uint32_t rates[4] = { 44100, 48000, 22050, 11025 };
+
+static uint32_t poly_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static int poly_kernels(uint32_t *state)
+{
+    static float buf[4][64];
+    const float *x[4];
+    float y[4], ref[4];
+    opl3_firfunc funcs[2] = { 0, 0 };
+    const char *names[2] = { "sse2", "avx2" };
+    opl3_resampler *rs;
+    uint32_t n, i;
+    float f;
+    int k, ch, failed = 0;
+
+#if OPL_RESAMPLE_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2"))
+    {
+        funcs[0] = OPL3_FirSSE2;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        funcs[1] = OPL3_FirAVX2;
+    }
+#endif
+    rs = OPL3_ResampleCreate(44100, OPL_RESAMPLE_HIGH);
+    if (!rs)
+    {
+        fprintf(stderr, "polyphase: out of memory\n");
+        return 1;
+    }
+    for (ch = 0; ch < 4; ch++)
+    {
+        x[ch] = buf[ch];
+    }
+    for (n = 0; n < 10000; n++)
+    {
+        for (ch = 0; ch < 4; ch++)
+        {
+            for (i = 0; i < 64; i++)
+            {
+                buf[ch][i] = (float)(int16_t)poly_rand(state);
+            }
+        }
+        f = (float)(poly_rand(state) & 0xffff) / 65536.0f;
+        i = poly_rand(state) % OPL_RESAMPLE_PHASES;
+        OPL3_FirScalar(x, &rs->coef[i * 2 * rs->taps], f, rs->taps, 4, ref);
+        for (k = 0; k < 2; k++)
+        {
+            if (!funcs[k])
+            {
+                continue;
+            }
+            funcs[k](x, &rs->coef[i * 2 * rs->taps], f, rs->taps, 4, y);
+            for (ch = 0; ch < 4; ch++)
+            {
+                if (fabsf(y[ch] - ref[ch]) > 0.05f)
+                {
+                    if (failed++ < 8)
+                    {
+                        fprintf(stderr, "polyphase: %s differs: %f scalar %f\n",
+                                names[k], y[ch], ref[ch]);
+                    }
+                }
+            }
+        }
+    }
+    OPL3_ResampleDestroy(rs);
+    printf("polyphase: kernels sse2=%s avx2=%s, %d failed\n",
+           funcs[0] ? "yes" : "skip", funcs[1] ? "yes" : "skip", failed);
+    return failed;
+}
+
+/* 周波数freqの正弦波をin[]に直接入れてPOLY_SAMPLES個出力する */
+static int poly_tone(uint8_t quality, uint32_t rate, double freq, int16_t *out)
+{
+    opl3_resampler *rs = OPL3_ResampleCreate(rate, quality);
+    double w = 2.0 * OPL_RESAMPLE_PI * freq / OPL_RESAMPLE_NATIVE;
+    uint32_t need, i, base = 0, done = 0, count;
+
+    if (!rs)
+    {
+        return 0;
+    }
+    while (done < POLY_SAMPLES)
+    {
+        count = POLY_SAMPLES - done > OPL_RESAMPLE_BLOCK ? OPL_RESAMPLE_BLOCK
+                                                         : POLY_SAMPLES - done;
+        need = OPL3_ResampleNeed(rs, count);
+        for (i = rs->avail; i < need; i++)
+        {
+            /* in[]の位置half-1がネイティブの0サンプル目 */
+            rs->in[0][i] = (float)(POLY_AMP * sin(w * ((double)base + i - (rs->half - 1))));
+            rs->in[1][i] = rs->in[0][i];
+        }
+        rs->avail = need;
+        OPL3_ResampleRun(rs, &out[done * 2], 0, count);
+        i = rs->pos - rs->half + 1;
+        OPL3_ResampleDiscard(rs);
+        base += i;
+        done += count;
+    }
+    OPL3_ResampleDestroy(rs);
+    return 1;
+}
+
+/* 同じ正弦波を16bitに丸めてから元の実装と同じ式で線形補間する */
+static void poly_linear(uint32_t rate, double freq, int16_t *out)
+{
+    double w = 2.0 * OPL_RESAMPLE_PI * freq / OPL_RESAMPLE_NATIVE;
+    double t, a, b;
+    uint32_t i, n;
+
+    for (i = 0; i < POLY_SAMPLES; i++)
+    {
+        t = (double)i * OPL_RESAMPLE_NATIVE / rate;
+        n = (uint32_t)t;
+        a = (int16_t)(POLY_AMP * sin(w * n));
+        b = (int16_t)(POLY_AMP * sin(w * (n + 1)));
+        out[i * 2] = (int16_t)(a + (b - a) * (t - n));
+    }
+}
+
+/*
+ * 出力と正弦波の差のRMS(dB、振幅比)
+ * fit == 0: 出力時刻での理想値との差(利得の低下も誤差に含む)
+ * fit == 1: 最小二乗で合わせた同じ周波数の正弦波との差
+ *           (折り返しとイメージだけを見る)
+ * フィルタの立ち上がりを避けて先頭の64サンプルは使わない。
+ */
+static double poly_error(const int16_t *out, uint32_t rate, double freq, int fit)
+{
+    double w = 2.0 * OPL_RESAMPLE_PI * freq / rate;
+    double ss = 0.0, sc = 0.0, cc = 0.0, ys = 0.0, yc = 0.0;
+    double a = POLY_AMP, b = 0.0, det, d, sum = 0.0;
+    uint32_t i;
+
+    if (fit)
+    {
+        for (i = 64; i < POLY_SAMPLES; i++)
+        {
+            ss += sin(w * i) * sin(w * i);
+            sc += sin(w * i) * cos(w * i);
+            cc += cos(w * i) * cos(w * i);
+            ys += out[i * 2] * sin(w * i);
+            yc += out[i * 2] * cos(w * i);
+        }
+        det = ss * cc - sc * sc;
+        a = (ys * cc - yc * sc) / det;
+        b = (yc * ss - ys * sc) / det;
+    }
+    for (i = 64; i < POLY_SAMPLES; i++)
+    {
+        d = out[i * 2] - a * sin(w * i) - b * cos(w * i);
+        sum += d * d;
+    }
+    return 20.0 * log10(sqrt(sum / (POLY_SAMPLES - 64)) / POLY_AMP + 1e-12);
+}
+
+static int poly_quality(void)
+{
+    static int16_t out[POLY_SAMPLES * 2];
+    double pass, image, linpass, linimage, fpass, fimage;
+    uint32_t r, q;
+    int failed = 0;
+
+    printf("rate,quality,taps,pass_db,image_db,linear_pass_db,linear_image_db\n");
+    for (r = 0; r < 4; r++)
+    {
+        /*
+         * 通過域: 出力ナイキストの0.34倍(理想値との差)
+         * 高域: 出力ナイキストの0.9倍。線形補間ではネイティブレートの
+         * イメージが可聴域に折り返す(合わせた正弦波との差)
+         */
+        fpass = rates[r] * 0.17;
+        fimage = rates[r] * 0.45;
+        poly_linear(rates[r], fpass, out);
+        linpass = poly_error(out, rates[r], fpass, 0);
+        poly_linear(rates[r], fimage, out);
+        linimage = poly_error(out, rates[r], fimage, 1);
+        for (q = 0; q < 3; q++)
+        {
+            if (!poly_tone(limits[q].quality, rates[r], fpass, out))
+            {
+                fprintf(stderr, "polyphase: out of memory\n");
+                return failed + 1;
+            }
+            pass = poly_error(out, rates[r], fpass, 0);
+            poly_tone(limits[q].quality, rates[r], fimage, out);
+            image = poly_error(out, rates[r], fimage, 1);
+            printf("%lu,%u,%u,%.1f,%.1f,%.1f,%.1f\n", (unsigned long)rates[r],
+                   limits[q].quality, OPL3_ResampleTaps(rates[r], limits[q].quality),
+                   pass, image, linpass, linimage);
+            if (pass > limits[q].pass_db || image > limits[q].image_db)
+            {
+                fprintf(stderr, "polyphase: quality %u @%luHz out of range\n",
+                        limits[q].quality, (unsigned long)rates[r]);
+                failed++;
+            }
+        }
+    }
+    return failed;
+}
+
+/* test/golden.cと同じ分布の書き込み(キーオンを多めに) */
+static void poly_randwrite(uint32_t *state, opl3_chip *a, opl3_chip *b, opl3_chip *c)
+{
+    static const uint8_t slotregs[5] = { 0x20, 0x40, 0x60, 0x80, 0xe0 };
+    uint32_t r = poly_rand(state);
+    uint16_t high = (r & 0x10) ? 0x100 : 0x000;
+    uint16_t reg;
+    uint8_t v = (uint8_t)(r >> 24);
+
+    switch (r & 0x07)
+    {
+    case 0: case 1: case 2: case 3:
+        reg = high | (slotregs[(r >> 5) % 5] + (r >> 8) % 0x16);
+        break;
+    case 4: case 5:
+        reg = high | (0xa0 + (r >> 5) % 9);
+        break;
+    case 6:
+        reg = high | (0xb0 + (r >> 5) % 9);
+        v |= 0x20;
+        break;
+    default:
+        reg = high | (0xc0 + (r >> 5) % 9);
+        break;
+    }
+    OPL3_WriteReg(a, reg, v);
+    OPL3_WriteReg(b, reg, v);
+    OPL3_WriteReg(c, reg, v);
+}
+
+static int poly_stream(uint32_t *state)
+{
+    static opl3_chip chips[3];
+    static int16_t whole[POLY_STREAM * 2], parts[POLY_STREAM * 2];
+    static int16_t front[POLY_STREAM * 2], rear[POLY_STREAM * 2];
+    uint32_t r, q, i, n, count, w;
+    int failed = 0;
+
+    for (r = 0; r < 4; r++)
+    {
+        for (q = OPL_RESAMPLE_LOW; q <= OPL_RESAMPLE_HIGH; q++)
+        {
+            for (i = 0; i < 3; i++)
+            {
+                OPL3_Reset(&chips[i], rates[r]);
+                if (OPL3_SetResampler(&chips[i], rates[r], (uint8_t)q) != OPL_RESAMPLE_OK)
+                {
+                    fprintf(stderr, "polyphase: out of memory\n");
+                    return 1;
+                }
+                OPL3_WriteReg(&chips[i], 0x105, 0x01);
+            }
+            for (w = 0; w < 64; w++)
+            {
+                poly_randwrite(state, &chips[0], &chips[1], &chips[2]);
+            }
+            OPL3_GenerateStream(&chips[0], whole, POLY_STREAM);
+            for (n = 0; n < POLY_STREAM; n += count)
+            {
+                count = 1 + poly_rand(state) % 3000;
+                if (count > POLY_STREAM - n)
+                {
+                    count = POLY_STREAM - n;
+                }
+                OPL3_GenerateStream(&chips[1], &parts[n * 2], count);
+            }
+            OPL3_Generate4ChStream(&chips[2], front, rear, POLY_STREAM);
+            if (memcmp(whole, parts, sizeof(whole)) != 0)
+            {
+                fprintf(stderr, "polyphase: split stream differs (quality %lu @%luHz)\n",
+                        (unsigned long)q, (unsigned long)rates[r]);
+                failed++;
+            }
+            if (memcmp(whole, front, sizeof(whole)) != 0)
+            {
+                fprintf(stderr, "polyphase: 4ch stream differs (quality %lu @%luHz)\n",
+                        (unsigned long)q, (unsigned long)rates[r]);
+                failed++;
+            }
+            for (i = 0; i < 3; i++)
+            {
+                OPL3_Release(&chips[i]);
+            }
+        }
+    }
+    printf("polyphase: streams %d failed\n", failed);
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t state = 1;
+    int failed = 0;
+
+    if (argc == 3 && argv[1][0] == '-' && argv[1][1] == 's')
+    {
+        state = (uint32_t)strtoul(argv[2], NULL, 0);
+        state = state ? state : 1;
+    }
+    else if (argc != 1)
+    {
+        fprintf(stderr, "usage: polyphase [-s seed]\n");
+        return 2;
+    }
+    failed += poly_kernels(&state);
+    failed += poly_quality();
+    failed += poly_stream(&state);
+    printf("polyphase: %s\n", failed ? "FAILED" : "ok");
+    return failed ? 1 : 0;
+}
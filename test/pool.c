@@ -0,0 +1,169 @@
+/*
+ * Multi-chip render pool test
+ *
+ * 同じ初期化とレジスタ書き込みを与えた2組のチップを、
+ * OPL3_PoolRenderと逐次のOPL3_GenerateStreamでそれぞれ生成し、
+ * 全チップ・全周期の出力が一致することを確認します。
+ *
+ * 使い方:
+ *   pool [-c chips] [-w workers] [-p periods]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "opl3_pool.h"
+
+#define POOL_SAMPLES    512
+#define POOL_WRITES     16
+
+static uint32_t pool_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* チップごとに違う音色で全チャンネルを発音させる */
+static void pool_setup(opl3_chip *chip, uint32_t n)
+{
+    uint16_t high, ch, op;
+
+    OPL3_Reset(chip, n & 1 ? 44100 : 49716);
+    OPL3_WriteReg(chip, 0x105, 0x01);
+    OPL3_WriteReg(chip, 0xbd, 0xc0);
+    for (ch = 0; ch < 18; ch++)
+    {
+        high = ch >= 9 ? 0x100 : 0x000;
+        op = (ch % 9 % 3) + (ch % 9 / 3) * 8;
+        OPL3_WriteReg(chip, high | (0x20 + op), 0xe1);
+        OPL3_WriteReg(chip, high | (0x23 + op), 0x21);
+        OPL3_WriteReg(chip, high | (0x60 + op), 0xf2 + (n & 0x0f));
+        OPL3_WriteReg(chip, high | (0x63 + op), 0xe4);
+        OPL3_WriteReg(chip, high | (0xe0 + op), (uint8_t)(n + ch) & 0x07);
+        OPL3_WriteReg(chip, high | (0xc0 + ch % 9), 0x30 | ((n + ch) & 0x0e));
+        OPL3_WriteReg(chip, high | (0xa0 + ch % 9), (uint8_t)(0x40 + n + ch));
+        OPL3_WriteReg(chip, high | (0xb0 + ch % 9), 0x31);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t numchips = 256, numworkers = 0, periods = 16;
+    opl3_chip *pooled, *serial;
+    opl3_pooljob *jobs;
+    opl3_poolwrite *writes;
+    int16_t *poolbuf, *serialbuf;
+    opl3_pool *pool;
+    opl3_pooljob job;
+    uint32_t state = 1, i, j, p, t;
+    unsigned long failed = 0;
+    int arg;
+
+    for (arg = 1; arg + 1 < argc; arg += 2)
+    {
+        switch (argv[arg][1])
+        {
+        case 'c':
+            numchips = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        case 'w':
+            numworkers = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        case 'p':
+            periods = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: pool [-c chips] [-w workers] [-p periods]\n");
+            return 2;
+        }
+    }
+
+    pooled = calloc(numchips, sizeof(opl3_chip));
+    serial = calloc(numchips, sizeof(opl3_chip));
+    jobs = calloc(numchips, sizeof(opl3_pooljob));
+    writes = calloc((size_t)numchips * POOL_WRITES, sizeof(opl3_poolwrite));
+    poolbuf = calloc((size_t)numchips * POOL_SAMPLES * 2, sizeof(int16_t));
+    serialbuf = calloc(POOL_SAMPLES * 2, sizeof(int16_t));
+    pool = OPL3_PoolCreate(numworkers);
+    if (!pooled || !serial || !jobs || !writes || !poolbuf || !serialbuf || !pool)
+    {
+        fprintf(stderr, "pool: out of memory\n");
+        return 1;
+    }
+
+    for (i = 0; i < numchips; i++)
+    {
+        pool_setup(&pooled[i], i);
+        pool_setup(&serial[i], i);
+        jobs[i].chip = &pooled[i];
+        jobs[i].writes = &writes[i * POOL_WRITES];
+        jobs[i].sndptr = &poolbuf[(size_t)i * POOL_SAMPLES * 2];
+    }
+
+    for (p = 0; p < periods; p++)
+    {
+        /* 周期ごとに時刻順のキーオン/オフとFナンバー変更を作る */
+        for (i = 0; i < numchips; i++)
+        {
+            jobs[i].numwrites = pool_rand(&state) % (POOL_WRITES + 1);
+            t = 0;
+            for (j = 0; j < jobs[i].numwrites; j++)
+            {
+                t += pool_rand(&state) % (POOL_SAMPLES / 8);
+                writes[i * POOL_WRITES + j].time = t;
+                writes[i * POOL_WRITES + j].reg = (pool_rand(&state) & 0x110)
+                                                | (0xa0 + pool_rand(&state) % 9);
+                writes[i * POOL_WRITES + j].data = (uint8_t)pool_rand(&state);
+            }
+        }
+        OPL3_PoolRender(pool, jobs, numchips, POOL_SAMPLES);
+        for (i = 0; i < numchips; i++)
+        {
+            job = jobs[i];
+            job.chip = &serial[i];
+            job.sndptr = serialbuf;
+            t = 0;
+            for (j = 0; j < POOL_SAMPLES; j = t)
+            {
+                while (job.numwrites && job.writes->time <= j)
+                {
+                    OPL3_WriteReg(job.chip, job.writes->reg, job.writes->data);
+                    job.writes++;
+                    job.numwrites--;
+                }
+                t = POOL_SAMPLES;
+                if (job.numwrites && job.writes->time < POOL_SAMPLES)
+                {
+                    t = job.writes->time;
+                }
+                OPL3_GenerateStream(job.chip, serialbuf + j * 2, t - j);
+            }
+            for (; job.numwrites; job.numwrites--, job.writes++)
+            {
+                OPL3_WriteReg(job.chip, job.writes->reg, job.writes->data);
+            }
+            if (memcmp(serialbuf, jobs[i].sndptr, POOL_SAMPLES * 2 * sizeof(int16_t)))
+            {
+                fprintf(stderr, "pool: chip %lu differs in period %lu\n",
+                        (unsigned long)i, (unsigned long)p);
+                failed++;
+            }
+        }
+    }
+
+    printf("pool: %lu chips x %lu periods, %lu workers pinned, %lu failed\n",
+           (unsigned long)numchips, (unsigned long)periods,
+           (unsigned long)OPL3_PoolPinned(pool), failed);
+    OPL3_PoolDestroy(pool);
+    free(pooled);
+    free(serial);
+    free(jobs);
+    free(writes);
+    free(poolbuf);
+    free(serialbuf);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * Per-stage profile counter test (OPL3_PROFILE=1)
+ *
+ * 乱数のレジスタ書き込み(即時とバッファリング)で鳴らしたチップについて、
+ * OPL3_GetProfileの呼び出し回数が生成したサンプル数と合うこと
+ * (位相は36回/サンプル、ミックスは2回、エンベロープとスロットは
+ * 休止していないスロットの数で同じ回数)、ステージの時間の合計が全体を
+ * 超えないこと、OPL3_ClearProfileとOPL3_Resetで0に戻ることを確かめます。
+ * 出力がプロファイルなしと同じことはmake test-profileが
+ * test-goldenのプロファイル版で確かめます。
+ *
+ * 使い方:
+ *   profile [-s seed] [-n streams]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "opl3.h"
+
+#if !OPL3_PROFILE
+#error "build with -DOPL3_PROFILE=1"
+#endif
+
+#define PROFILE_SAMPLES 20000
+#define PROFILE_CHUNK   1024
+
+static const char *const profile_names[OPL_PROF_STAGES] = {
+    "envelope", "phase", "slot", "mix", "timers", "writebuf", "total"
+};
+
+static uint32_t profile_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* test/golden.cと同じ分布のレジスタ書き込み(キーオンを多めに) */
+static void profile_randreg(uint32_t *state, uint16_t *reg, uint8_t *v)
+{
+    static const uint8_t slotregs[5] = { 0x20, 0x40, 0x60, 0x80, 0xe0 };
+    uint32_t r = profile_rand(state);
+    uint16_t high = (r & 0x10) ? 0x100 : 0x000;
+
+    *v = (uint8_t)(r >> 24);
+    switch (r & 0x07)
+    {
+    case 0: case 1: case 2:
+        *reg = high | (slotregs[(r >> 5) % 5] + (r >> 8) % 0x16);
+        break;
+    case 3: case 4:
+        *reg = high | (0xa0 + (r >> 5) % 9);
+        break;
+    case 5:
+        *reg = high | (0xb0 + (r >> 5) % 9);
+        *v |= 0x20;
+        break;
+    case 6:
+        *reg = high | (0xc0 + (r >> 5) % 9);
+        break;
+    default:
+        *reg = (r & 0x100) ? 0xbd : 0x105;
+        if (*reg == 0x105)
+        {
+            *v &= 0x01;
+        }
+        break;
+    }
+}
+
+static int profile_zero(const opl3_chip *chip, const char *what)
+{
+    opl3_profile stats;
+    uint8_t i;
+
+    OPL3_GetProfile(chip, &stats);
+    for (i = 0; i < OPL_PROF_STAGES; i++)
+    {
+        if (stats.calls[i] != 0 || stats.ticks[i] != 0)
+        {
+            fprintf(stderr, "profile: %s left %s at %llu calls\n", what, profile_names[i],
+                    (unsigned long long)stats.calls[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int profile_run(uint32_t *state, uint32_t stream)
+{
+    static opl3_chip chip;
+    static int16_t out[PROFILE_CHUNK * 2];
+    opl3_profile stats;
+    uint64_t sum = 0;
+    uint32_t pos, count, buffered = 0, i, n;
+    uint16_t reg;
+    uint8_t v;
+    int ok = 1;
+
+    OPL3_Reset(&chip, 49716);
+    ok = profile_zero(&chip, "OPL3_Reset");
+
+    /* 無音のチップでは全スロットが休止していてエンベロープは呼ばれない */
+    OPL3_GenerateStream(&chip, out, 100);
+    OPL3_GetProfile(&chip, &stats);
+    if (stats.calls[OPL_PROF_ENVELOPE] != 0
+     || stats.calls[OPL_PROF_PHASE] != 36 * stats.calls[OPL_PROF_TOTAL])
+    {
+        fprintf(stderr, "profile: stream %lu: idle chip counted %llu envelope calls\n",
+                (unsigned long)stream, (unsigned long long)stats.calls[OPL_PROF_ENVELOPE]);
+        ok = 0;
+    }
+    OPL3_ClearProfile(&chip);
+    ok = ok && profile_zero(&chip, "OPL3_ClearProfile");
+
+    for (pos = 0; pos < PROFILE_SAMPLES; pos += count)
+    {
+        n = profile_rand(state) % 12;
+        for (i = 0; i < n; i++)
+        {
+            profile_randreg(state, &reg, &v);
+            if (profile_rand(state) & 1)
+            {
+                OPL3_WriteRegBuffered(&chip, reg, v);
+                buffered++;
+            }
+            else
+            {
+                OPL3_WriteReg(&chip, reg, v);
+            }
+        }
+        count = 1 + profile_rand(state) % PROFILE_CHUNK;
+        if (count > PROFILE_SAMPLES - pos)
+        {
+            count = PROFILE_SAMPLES - pos;
+        }
+        OPL3_GenerateStream(&chip, out, count);
+    }
+
+    OPL3_GetProfile(&chip, &stats);
+    if (stats.calls[OPL_PROF_TOTAL] != PROFILE_SAMPLES
+     || stats.calls[OPL_PROF_TIMERS] != PROFILE_SAMPLES
+     || stats.calls[OPL_PROF_MIX] != 2 * PROFILE_SAMPLES
+     || stats.calls[OPL_PROF_PHASE] != 36 * PROFILE_SAMPLES
+     || stats.calls[OPL_PROF_ENVELOPE] != stats.calls[OPL_PROF_SLOT]
+     || stats.calls[OPL_PROF_ENVELOPE] == 0
+     || stats.calls[OPL_PROF_ENVELOPE] > 36 * PROFILE_SAMPLES
+     || (buffered && stats.calls[OPL_PROF_WRITEBUF] == 0)
+     || stats.calls[OPL_PROF_WRITEBUF] > buffered)
+    {
+        fprintf(stderr, "profile: stream %lu: call counts do not match %lu samples:",
+                (unsigned long)stream, (unsigned long)PROFILE_SAMPLES);
+        for (i = 0; i < OPL_PROF_STAGES; i++)
+        {
+            fprintf(stderr, " %s=%llu", profile_names[i], (unsigned long long)stats.calls[i]);
+        }
+        fprintf(stderr, "\n");
+        ok = 0;
+    }
+    for (i = 0; i < OPL_PROF_TOTAL; i++)
+    {
+        sum += stats.ticks[i];
+    }
+    if (stats.ticks[OPL_PROF_TOTAL] == 0 || sum > stats.ticks[OPL_PROF_TOTAL])
+    {
+        fprintf(stderr, "profile: stream %lu: stages take %llu ticks, total %llu\n",
+                (unsigned long)stream, (unsigned long long)sum,
+                (unsigned long long)stats.ticks[OPL_PROF_TOTAL]);
+        ok = 0;
+    }
+    OPL3_Release(&chip);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seed = 1, streams = 8, state, n, failed = 0;
+    int arg;
+
+    for (arg = 1; arg + 1 < argc; arg += 2)
+    {
+        switch (argv[arg][1])
+        {
+        case 's':
+            seed = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        case 'n':
+            streams = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: profile [-s seed] [-n streams]\n");
+            return 2;
+        }
+    }
+    state = seed ? seed : 1;
+
+    for (n = 0; n < streams; n++)
+    {
+        failed += !profile_run(&state, n);
+    }
+
+    printf("profile: %lu streams (%s), %lu failed\n", (unsigned long)streams,
+           OPL_PROFILE_TSC ? "rdtsc" : "clock_gettime", (unsigned long)failed);
+    return failed ? 1 : 0;
+}
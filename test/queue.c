@@ -0,0 +1,333 @@
+/*
+ * Lock-free register write queue test
+ *
+ * 時刻付きの書き込み列を用意し、1サンプルずつ生成しながらその時刻に
+ * OPL3_WriteRegで書き込んだ出力を基準にします。それと次の出力が
+ * 一致することを確認します。
+ *   - 全部を積んでから、いろいろな長さでOPL3_QueueRenderした場合
+ *   - 書き込みスレッドが小さなキューに積み続け、生成スレッドが
+ *     並行してOPL3_QueueRenderした場合(一杯での待ちと折り返しを含む)
+ *
+ * 使い方:
+ *   queue [-n writes] [-q capacity]
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "opl3_queue.h"
+
+#define QUEUE_BLOCK     512
+
+typedef struct {
+    uint64_t time;
+    uint16_t reg;
+    uint8_t data;
+} queue_write;
+
+typedef struct {
+    opl3_queue *queue;
+    const queue_write *writes;
+    uint32_t numwrites;
+    _Atomic uint64_t pushed;    /* 最後に積んだ書き込みの時刻 */
+    _Atomic int done;
+} queue_producer;
+
+static const uint32_t queue_blocks[] = { 1, 7, 64, QUEUE_BLOCK, 4096 };
+
+static uint32_t queue_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* 全チャンネルを発音できる音色にする */
+static void queue_setup(opl3_chip *chip)
+{
+    uint16_t high, ch, op;
+
+    OPL3_Reset(chip, 49716);
+    OPL3_WriteReg(chip, 0x105, 0x01);
+    for (ch = 0; ch < 18; ch++)
+    {
+        high = ch >= 9 ? 0x100 : 0x000;
+        op = (ch % 9 % 3) + (ch % 9 / 3) * 8;
+        OPL3_WriteReg(chip, high | (0x20 + op), 0xe1);
+        OPL3_WriteReg(chip, high | (0x23 + op), 0x21);
+        OPL3_WriteReg(chip, high | (0x60 + op), 0xf4);
+        OPL3_WriteReg(chip, high | (0x63 + op), 0xe4);
+        OPL3_WriteReg(chip, high | (0xc0 + ch % 9), 0x30);
+    }
+}
+
+/* 時刻順のFナンバー、キーオン/オフ、音量、リズムの書き込み列(同時刻を含む) */
+static uint64_t queue_script(queue_write *writes, uint32_t numwrites)
+{
+    static const uint8_t regs[] = { 0xa0, 0xb0, 0x40, 0x43, 0xc0 };
+    uint32_t state = 1, i, r;
+    uint64_t t = 0;
+
+    for (i = 0; i < numwrites; i++)
+    {
+        r = queue_rand(&state);
+        if (r & 1)
+        {
+            t += r % 97;
+        }
+        writes[i].time = t;
+        if ((r & 0x3e) == 0)
+        {
+            writes[i].reg = 0xbd;
+        }
+        else
+        {
+            writes[i].reg = (uint16_t)((r & 0x100)
+                          | (regs[(r >> 9) % sizeof(regs)] + (r >> 16) % 9));
+        }
+        writes[i].data = (uint8_t)queue_rand(&state);
+    }
+    return t + QUEUE_BLOCK;
+}
+
+static void queue_reference(const queue_write *writes, uint32_t numwrites,
+                            int16_t *sndptr, uint64_t numsamples)
+{
+    opl3_chip *chip = calloc(1, sizeof(opl3_chip));
+    uint64_t pos;
+    uint32_t i = 0;
+
+    queue_setup(chip);
+    for (pos = 0; pos < numsamples; pos++)
+    {
+        while (i < numwrites && writes[i].time <= pos)
+        {
+            OPL3_WriteReg(chip, writes[i].reg, writes[i].data);
+            i++;
+        }
+        OPL3_GenerateStream(chip, sndptr + pos * 2, 1);
+    }
+    OPL3_Release(chip);
+    free(chip);
+}
+
+/* 容量は2のべき乗に切り上げ、一杯なら拒み、適用した分だけ空く */
+static uint32_t queue_capacity(void)
+{
+    opl3_chip *chip = calloc(1, sizeof(opl3_chip));
+    opl3_queue *queue;
+    uint32_t i, failed = 0;
+
+    queue_setup(chip);
+    queue = OPL3_QueueCreate(chip, 5);
+    for (i = 0; i < 8; i++)
+    {
+        failed += !OPL3_QueuePush(queue, i < 3 ? 0 : 100, 0xa0, (uint8_t)i);
+    }
+    failed += OPL3_QueuePush(queue, 100, 0xa0, 0);
+    OPL3_QueueRender(queue, NULL, 0);
+    for (i = 0; i < 3; i++)
+    {
+        failed += !OPL3_QueuePush(queue, 100, 0xa0, (uint8_t)i);
+    }
+    failed += OPL3_QueuePush(queue, 100, 0xa0, 0);
+    failed += OPL3_QueueNow(queue) != 0;
+    if (failed)
+    {
+        fprintf(stderr, "queue: capacity check failed\n");
+    }
+    OPL3_QueueDestroy(queue);
+    OPL3_Release(chip);
+    free(chip);
+    return failed != 0;
+}
+
+static void *queue_produce(void *arg)
+{
+    queue_producer *producer = (queue_producer *)arg;
+    const queue_write *write = producer->writes;
+    uint32_t i;
+
+    for (i = 0; i < producer->numwrites; i++, write++)
+    {
+        while (!OPL3_QueuePush(producer->queue, write->time, write->reg, write->data))
+        {
+            sched_yield();
+        }
+        atomic_store_explicit(&producer->pushed, write->time, memory_order_release);
+    }
+    atomic_store_explicit(&producer->done, 1, memory_order_release);
+    return NULL;
+}
+
+/*
+ * 並行に生成する。書き込みが時刻どおりに間に合うよう、最後に積まれた
+ * 書き込みの時刻までしか進めない(それより後の書き込みはまだ来ない)。
+ */
+static uint32_t queue_threaded(const queue_write *writes, uint32_t numwrites,
+                               uint32_t capacity, const int16_t *expect,
+                               int16_t *sndptr, uint64_t numsamples)
+{
+    opl3_chip *chip = calloc(1, sizeof(opl3_chip));
+    queue_producer producer;
+    pthread_t thread;
+    uint64_t pos = 0, limit;
+    uint32_t count, stalls = 0, failed = 0;
+
+    queue_setup(chip);
+    producer.queue = OPL3_QueueCreate(chip, capacity);
+    producer.writes = writes;
+    producer.numwrites = numwrites;
+    atomic_init(&producer.pushed, 0);
+    atomic_init(&producer.done, 0);
+    if (!producer.queue || pthread_create(&thread, NULL, queue_produce, &producer) != 0)
+    {
+        fprintf(stderr, "queue: cannot start producer\n");
+        return 1;
+    }
+    while (pos < numsamples)
+    {
+        count = QUEUE_BLOCK;
+        if (!atomic_load_explicit(&producer.done, memory_order_acquire))
+        {
+            limit = atomic_load_explicit(&producer.pushed, memory_order_acquire);
+            if (limit <= pos)
+            {
+                OPL3_QueueRender(producer.queue, NULL, 0);
+                stalls++;
+                sched_yield();
+                continue;
+            }
+            if (limit - pos < count)
+            {
+                count = (uint32_t)(limit - pos);
+            }
+        }
+        if (numsamples - pos < count)
+        {
+            count = (uint32_t)(numsamples - pos);
+        }
+        OPL3_QueueRender(producer.queue, sndptr + pos * 2, count);
+        pos += count;
+    }
+    pthread_join(thread, NULL);
+    if (OPL3_QueueNow(producer.queue) != numsamples)
+    {
+        fprintf(stderr, "queue: threaded position %llu\n",
+                (unsigned long long)OPL3_QueueNow(producer.queue));
+        failed++;
+    }
+    if (memcmp(expect, sndptr, numsamples * 2 * sizeof(int16_t)))
+    {
+        fprintf(stderr, "queue: threaded render (capacity %lu) differs\n",
+                (unsigned long)capacity);
+        failed++;
+    }
+    printf("queue: threaded, capacity %lu, %lu stalls\n",
+           (unsigned long)capacity, (unsigned long)stalls);
+    OPL3_QueueDestroy(producer.queue);
+    OPL3_Release(chip);
+    free(chip);
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t numwrites = 20000, capacity = 64;
+    queue_write *writes;
+    int16_t *expect, *out;
+    opl3_chip *chip;
+    opl3_queue *queue;
+    uint64_t numsamples, pos;
+    uint32_t b, i, count;
+    unsigned long failed = 0;
+    int arg;
+
+    for (arg = 1; arg + 1 < argc; arg += 2)
+    {
+        switch (argv[arg][1])
+        {
+        case 'n':
+            numwrites = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        case 'q':
+            capacity = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: queue [-n writes] [-q capacity]\n");
+            return 2;
+        }
+    }
+
+    writes = calloc(numwrites ? numwrites : 1, sizeof(queue_write));
+    chip = calloc(1, sizeof(opl3_chip));
+    if (!writes || !chip)
+    {
+        fprintf(stderr, "queue: out of memory\n");
+        return 1;
+    }
+    numsamples = queue_script(writes, numwrites);
+    expect = calloc(numsamples * 2, sizeof(int16_t));
+    out = calloc(numsamples * 2, sizeof(int16_t));
+    if (!expect || !out)
+    {
+        fprintf(stderr, "queue: out of memory\n");
+        return 1;
+    }
+    queue_reference(writes, numwrites, expect, numsamples);
+
+    /* 全部を積んでから、長さを変えて生成する */
+    for (b = 0; b < sizeof(queue_blocks) / sizeof(queue_blocks[0]); b++)
+    {
+        queue_setup(chip);
+        queue = OPL3_QueueCreate(chip, numwrites);
+        if (!queue)
+        {
+            fprintf(stderr, "queue: out of memory\n");
+            return 1;
+        }
+        for (i = 0; i < numwrites; i++)
+        {
+            if (!OPL3_QueuePush(queue, writes[i].time, writes[i].reg, writes[i].data))
+            {
+                fprintf(stderr, "queue: push %lu rejected\n", (unsigned long)i);
+                failed++;
+                break;
+            }
+        }
+        for (pos = 0; pos < numsamples; pos += count)
+        {
+            count = queue_blocks[b];
+            if (numsamples - pos < count)
+            {
+                count = (uint32_t)(numsamples - pos);
+            }
+            OPL3_QueueRender(queue, out + pos * 2, count);
+        }
+        if (memcmp(expect, out, numsamples * 2 * sizeof(int16_t)))
+        {
+            fprintf(stderr, "queue: render by %lu differs\n", (unsigned long)queue_blocks[b]);
+            failed++;
+        }
+        OPL3_QueueDestroy(queue);
+        OPL3_Release(chip);
+    }
+
+    failed += queue_capacity();
+    memset(out, 0, numsamples * 2 * sizeof(int16_t));
+    failed += queue_threaded(writes, numwrites, capacity, expect, out, numsamples);
+
+    printf("queue: %lu writes, %llu samples, %lu failed\n", (unsigned long)numwrites,
+           (unsigned long long)numsamples, failed);
+    free(writes);
+    free(chip);
+    free(expect);
+    free(out);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,343 @@
+/*
+ * Chip snapshot/restore test (OPL3_SaveState / OPL3_LoadState)
+ *
+ * 乱数のレジスタ書き込み(即時とバッファリング)で鳴らしているチップの
+ * 状態を途中で保存し、別のレートでリセットして別の書き込みで汚した
+ * チップに復元して、その後の出力が元のチップとサンプル単位で一致する
+ * ことを確かめます。復元直後に保存し直したバイト列が元と同じことと、
+ * 壊れたデータを読まずにチップをそのままにすることも検査します。
+ *
+ * 使い方:
+ *   state [-s seed] [-n streams]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "opl3.h"
+
+#define STATE_SAMPLES   40000
+#define STATE_CHUNK     2048
+#define STATE_MAXSIZE   (1 << 20)
+/* 保存データのチップ部分の先頭(ヘッダー、スロット、チャンネルの後) */
+#define STATE_CHIPPART  (8 + OPL_NUM_SLOTS * 30 \
+                         + OPL_NUM_CHANNELS * (13 + 8 * OPL_ENABLE_STEREOEXT))
+
+static uint8_t statebuf[STATE_MAXSIZE];
+static uint8_t checkbuf[STATE_MAXSIZE];
+
+static uint32_t state_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* test/golden.cと同じ分布のレジスタ書き込み(キーオンを多めに) */
+static void state_randreg(uint32_t *state, uint16_t *reg, uint8_t *v)
+{
+    static const uint8_t slotregs[5] = { 0x20, 0x40, 0x60, 0x80, 0xe0 };
+    uint32_t r = state_rand(state);
+    uint16_t high = (r & 0x10) ? 0x100 : 0x000;
+
+    *v = (uint8_t)(r >> 24);
+    switch (r & 0x07)
+    {
+    case 0: case 1: case 2:
+        *reg = high | (slotregs[(r >> 5) % 5] + (r >> 8) % 0x16);
+        break;
+    case 3: case 4:
+        *reg = high | (0xa0 + (r >> 5) % 9);
+        break;
+    case 5:
+        *reg = high | (0xb0 + (r >> 5) % 9);
+        *v |= 0x20;
+        break;
+    case 6:
+        *reg = high | (0xc0 + (r >> 5) % 9);
+        break;
+    default:
+        switch ((r >> 8) & 0x03)
+        {
+        case 0:
+            *reg = 0xbd;
+            break;
+        case 1:
+            *reg = 0x104;
+            break;
+        default:
+            *reg = 0x105;
+            *v &= 0x01;
+            break;
+        }
+        break;
+    }
+}
+
+/* 書き込みをいくつか与えてからcount分を生成する(両方のチップに同じ操作) */
+static void state_step(opl3_chip **chips, uint8_t numchips, uint32_t *state,
+                       int16_t (*out)[STATE_CHUNK * 2], uint32_t count)
+{
+    uint32_t n = state_rand(state) % 12, i;
+    uint16_t reg;
+    uint8_t v, c, buffered;
+
+    for (i = 0; i < n; i++)
+    {
+        state_randreg(state, &reg, &v);
+        buffered = (uint8_t)(state_rand(state) & 1);
+        for (c = 0; c < numchips; c++)
+        {
+            if (buffered)
+            {
+                OPL3_WriteRegBuffered(chips[c], reg, v);
+            }
+            else
+            {
+                OPL3_WriteReg(chips[c], reg, v);
+            }
+        }
+    }
+    for (c = 0; c < numchips; c++)
+    {
+        OPL3_GenerateStream(chips[c], out[c], count);
+    }
+}
+
+static int state_run(uint32_t *state, uint32_t rate, uint32_t stream)
+{
+    static opl3_chip a, b;
+    static int16_t out[2][STATE_CHUNK * 2];
+    opl3_chip *chips[2] = { &a, &b };
+    uint32_t pos, count, split, size, i;
+    uint16_t reg;
+    uint8_t v;
+    int ok = 1;
+
+    OPL3_Reset(&a, rate);
+    split = STATE_SAMPLES / 4 + state_rand(state) % (STATE_SAMPLES / 2);
+    for (pos = 0; pos < split; pos += count)
+    {
+        count = 1 + state_rand(state) % STATE_CHUNK;
+        if (count > split - pos)
+        {
+            count = split - pos;
+        }
+        state_step(chips, 1, state, out, count);
+    }
+    /* キューに未処理の書き込みが残った状態で保存する */
+    for (i = 0; i < 8; i++)
+    {
+        state_randreg(state, &reg, &v);
+        OPL3_WriteRegBuffered(&a, reg, v);
+    }
+
+    size = OPL3_StateSize(&a);
+    if (OPL3_SaveState(&a, statebuf, size - 1) != 0
+     || OPL3_SaveState(&a, statebuf, STATE_MAXSIZE) != size)
+    {
+        fprintf(stderr, "state: stream %lu: saved size differs from OPL3_StateSize (%lu)\n",
+                (unsigned long)stream, (unsigned long)size);
+        return 0;
+    }
+
+    /* 別のレートでリセットし、別の書き込みと生成で汚したチップに復元する */
+    OPL3_Reset(&b, rate == 44100 ? 48000 : 44100);
+    for (i = 0; i < 64; i++)
+    {
+        state_randreg(state, &reg, &v);
+        OPL3_WriteRegBuffered(&b, reg, v);
+    }
+    OPL3_GenerateStream(&b, out[1], 100);
+    if (OPL3_LoadState(&b, statebuf, size) != OPL_STATE_OK)
+    {
+        fprintf(stderr, "state: stream %lu: load failed\n", (unsigned long)stream);
+        OPL3_Release(&a);
+        OPL3_Release(&b);
+        return 0;
+    }
+    if (OPL3_SaveState(&b, checkbuf, STATE_MAXSIZE) != size || memcmp(statebuf, checkbuf, size) != 0)
+    {
+        fprintf(stderr, "state: stream %lu: state changed by a save/load round trip\n",
+                (unsigned long)stream);
+        ok = 0;
+    }
+
+    for (pos = split; pos < STATE_SAMPLES && ok; pos += count)
+    {
+        count = 1 + state_rand(state) % STATE_CHUNK;
+        if (count > STATE_SAMPLES - pos)
+        {
+            count = STATE_SAMPLES - pos;
+        }
+        state_step(chips, 2, state, out, count);
+        for (i = 0; i < count * 2; i++)
+        {
+            if (out[0][i] != out[1][i])
+            {
+                fprintf(stderr, "state: stream %lu @%luHz differs at sample %lu"
+                        " (%lu after the snapshot): %d, expected %d\n",
+                        (unsigned long)stream, (unsigned long)rate,
+                        (unsigned long)(pos + i / 2), (unsigned long)(pos + i / 2 - split),
+                        out[1][i], out[0][i]);
+                ok = 0;
+                break;
+            }
+        }
+    }
+    OPL3_Release(&a);
+    OPL3_Release(&b);
+    return ok;
+}
+
+/* 壊れたデータでは失敗し、チップを変えないこと */
+static int state_reject(uint32_t *state)
+{
+    static opl3_chip a, b;
+    static int16_t out[1][STATE_CHUNK * 2];
+    opl3_chip *chips[1] = { &a };
+    uint32_t size, i;
+    int ok = 1;
+    struct {
+        uint32_t offset;
+        uint8_t value;
+        uint8_t err;
+        const char *what;
+    } cases[8] = {
+        { 0, 'X', OPL_STATE_BADFORMAT, "signature" },
+        { 4, OPL_STATE_VERSION + 1, OPL_STATE_BADFORMAT, "version" },
+        { 5, 0x80, OPL_STATE_BADFORMAT, "configuration" },
+        { 8 + 12, OPL_SIG_NUM, OPL_STATE_BADFORMAT, "modulator index" },
+        { 6, 0xff, OPL_STATE_SHORT, "queue length" },
+        { STATE_CHIPPART + 16, 2, OPL_STATE_BADFORMAT, "vibrato shift" },
+        { STATE_CHIPPART + 19, 3, OPL_STATE_BADFORMAT, "tremolo shift" },
+        { STATE_CHIPPART + 19, 0xff, OPL_STATE_BADFORMAT, "tremolo shift" },
+    };
+
+    OPL3_Reset(&a, 44100);
+    for (i = 0; i < 20; i++)
+    {
+        state_step(chips, 1, state, out, 500);
+    }
+    size = OPL3_SaveState(&a, statebuf, STATE_MAXSIZE);
+
+    OPL3_Reset(&b, 49716);
+    chips[0] = &b;
+    state_step(chips, 1, state, out, 500);
+    OPL3_SaveState(&b, checkbuf, STATE_MAXSIZE);
+    for (i = 0; i < 8; i++)
+    {
+        uint8_t saved = statebuf[cases[i].offset];
+
+        statebuf[cases[i].offset] = cases[i].value;
+        if (OPL3_LoadState(&b, statebuf, size) != cases[i].err)
+        {
+            fprintf(stderr, "state: a bad %s was not rejected\n", cases[i].what);
+            ok = 0;
+        }
+        statebuf[cases[i].offset] = saved;
+    }
+    if (OPL3_LoadState(&b, statebuf, size - 1) != OPL_STATE_SHORT)
+    {
+        fprintf(stderr, "state: truncated data was not rejected\n");
+        ok = 0;
+    }
+    OPL3_SaveState(&b, statebuf, STATE_MAXSIZE);
+    if (memcmp(statebuf, checkbuf, OPL3_StateSize(&b)) != 0)
+    {
+        fprintf(stderr, "state: a failed load changed the chip\n");
+        ok = 0;
+    }
+    OPL3_Release(&a);
+    OPL3_Release(&b);
+    return ok;
+}
+
+/*
+ * 中身が不定のメモリのチップをOPL3_Initし、キューを伸ばしてから
+ * リセットし直すと、ヒープを返して新しいチップと同じ出力になること
+ */
+static int state_reset(uint32_t *state)
+{
+    static opl3_chip fresh;
+    static int16_t out[2][STATE_CHUNK * 2];
+    opl3_chip *chip = malloc(sizeof(opl3_chip));
+    opl3_chip *chips[1];
+    uint32_t i;
+    int ok = 1;
+
+    if (!chip)
+    {
+        fprintf(stderr, "state: out of memory\n");
+        return 0;
+    }
+    memset(chip, 0xa5, sizeof(opl3_chip));
+    OPL3_Init(chip, 44100);
+    for (i = 0; i < OPL_WRITEBUF_SIZE * 4; i++)
+    {
+        OPL3_WriteRegBuffered(chip, 0xa0 + i % 9, (uint8_t)i);
+    }
+    chips[0] = chip;
+    state_step(chips, 1, state, out, 500);
+
+    OPL3_Reset(chip, 44100);
+#if OPL_WRITEBUF_GROW
+    if (chip->writebuf || chip->writebuf_size)
+    {
+        fprintf(stderr, "state: reset kept the write queue\n");
+        ok = 0;
+    }
+#endif
+    OPL3_Reset(&fresh, 44100);
+    OPL3_GenerateStream(chip, out[0], STATE_CHUNK);
+    OPL3_GenerateStream(&fresh, out[1], STATE_CHUNK);
+    if (memcmp(out[0], out[1], sizeof(out[0])) != 0)
+    {
+        fprintf(stderr, "state: a reset chip differs from a new one\n");
+        ok = 0;
+    }
+    OPL3_Release(chip);
+    OPL3_Release(&fresh);
+    free(chip);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t rates[3] = { 49716, 44100, 48000 };
+    static opl3_chip empty;
+    uint32_t seed = 1, streams = 24, state, n, failed = 0;
+    int arg;
+
+    for (arg = 1; arg + 1 < argc; arg += 2)
+    {
+        switch (argv[arg][1])
+        {
+        case 's':
+            seed = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        case 'n':
+            streams = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: state [-s seed] [-n streams]\n");
+            return 2;
+        }
+    }
+    state = seed ? seed : 1;
+
+    for (n = 0; n < streams; n++)
+    {
+        failed += !state_run(&state, rates[n % 3], n);
+    }
+    failed += !state_reject(&state);
+    failed += !state_reset(&state);
+
+    printf("state: %lu streams (%lu bytes per state without queue), %lu failed\n",
+           (unsigned long)streams, (unsigned long)OPL3_StateSize(&empty),
+           (unsigned long)failed);
+    return failed ? 1 : 0;
+}
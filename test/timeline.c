@@ -0,0 +1,422 @@
+/*
+ * DRO v2 / IMF timeline test
+ *
+ * 乱数でDRO v2(コードマップ、短い/長い待ち、2バンク)とIMF(タイプ0と1)を
+ * 組み立ててタイムラインにデコードし、OPL3_TimelineRenderの出力を、
+ * 同じ書き込みをソースの時刻どおりにOPL3_WriteRegで与えて
+ * OPL3_GenerateStreamで生成した参照とサンプル単位で比較します。
+ * 呼び出しごとのサンプル数はばらばらにします。
+ *
+ * 使い方:
+ *   timeline [-s seed] [-n files]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "opl3_timeline.h"
+
+#define TL_WRITES       600
+#define TL_MAXDATA      (26 + 128 + TL_WRITES * 8 + 16)
+
+typedef struct {
+    uint32_t time;      /* ソースの時刻 */
+    uint16_t reg;
+    uint8_t v;
+} tl_write;
+
+typedef struct {
+    uint8_t data[TL_MAXDATA];
+    uint32_t size;
+    tl_write writes[TL_WRITES];
+    uint32_t numwrites;
+    uint32_t total;     /* 曲の長さ(ソースの時刻) */
+    uint32_t src_rate;
+} tl_file;
+
+static uint8_t tl_regs[128];
+static uint8_t tl_numregs;
+
+static uint32_t tl_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* 意味のあるレジスタの一覧(コードマップの元) */
+static void tl_initregs(void)
+{
+    static const uint8_t slotregs[5] = { 0x20, 0x40, 0x60, 0x80, 0xe0 };
+    uint8_t i, j;
+
+    tl_numregs = 0;
+    for (i = 0; i < 5; i++)
+    {
+        for (j = 0; j < 0x16; j++)
+        {
+            if ((j & 0x07) < 6)
+            {
+                tl_regs[tl_numregs++] = (uint8_t)(slotregs[i] + j);
+            }
+        }
+    }
+    for (i = 0; i < 9; i++)
+    {
+        tl_regs[tl_numregs++] = (uint8_t)(0xa0 + i);
+        tl_regs[tl_numregs++] = (uint8_t)(0xb0 + i);
+        tl_regs[tl_numregs++] = (uint8_t)(0xc0 + i);
+    }
+    tl_regs[tl_numregs++] = 0xbd;
+    tl_regs[tl_numregs++] = 0x01;
+    tl_regs[tl_numregs++] = 0x04;
+    tl_regs[tl_numregs++] = 0x05;
+    tl_regs[tl_numregs++] = 0x08;
+}
+
+static uint8_t tl_randval(uint32_t *state, uint16_t reg)
+{
+    uint8_t v = (uint8_t)(tl_rand(state) >> 24);
+
+    if ((reg & 0xf0) == 0xb0 && reg != 0xbd && (tl_rand(state) & 1))
+    {
+        v |= 0x20;
+    }
+    if (reg == 0x105)
+    {
+        v &= 0x01;
+    }
+    return v;
+}
+
+static void tl_addwrite(tl_file *f, uint16_t reg, uint8_t v)
+{
+    f->writes[f->numwrites].time = f->total;
+    f->writes[f->numwrites].reg = reg;
+    f->writes[f->numwrites].v = v;
+    f->numwrites++;
+}
+
+static void tl_put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void tl_builddro(tl_file *f, uint32_t *state)
+{
+    uint8_t codemap[128], *p;
+    uint8_t shortdelay, longdelay, code, t;
+    uint32_t i, j, r, pairs = 0;
+    uint16_t reg;
+
+    /* シャッフルしたレジスタ一覧の一部をコードマップにする */
+    memcpy(codemap, tl_regs, tl_numregs);
+    for (i = tl_numregs - 1; i > 0; i--)
+    {
+        j = tl_rand(state) % (i + 1);
+        t = codemap[i];
+        codemap[i] = codemap[j];
+        codemap[j] = t;
+    }
+    code = (uint8_t)(tl_numregs - tl_rand(state) % 16);
+    shortdelay = code;
+    longdelay = (uint8_t)(code + 1);
+
+    memset(f->data, 0, 26);
+    memcpy(f->data, "DBRAWOPL", 8);
+    f->data[8] = 2;
+    f->data[20] = 2;
+    f->data[23] = shortdelay;
+    f->data[24] = longdelay;
+    f->data[25] = code;
+    memcpy(&f->data[26], codemap, code);
+    p = &f->data[26 + code];
+    f->numwrites = 0;
+    f->total = 0;
+    f->src_rate = 1000;
+
+    /* 最初にOPL3モードにする(2バンク目への書き込み) */
+    for (i = 0; i < code && codemap[i] != 0x05; i++)
+    {
+    }
+    if (i < code)
+    {
+        *p++ = (uint8_t)(0x80 | i);
+        *p++ = 0x01;
+        tl_addwrite(f, 0x105, 0x01);
+        pairs++;
+    }
+    while (f->numwrites < TL_WRITES)
+    {
+        r = tl_rand(state);
+        if ((r & 0x0f) < 3)
+        {
+            *p++ = shortdelay;
+            *p++ = (uint8_t)((r >> 8) & 0x1f);
+            f->total += ((r >> 8) & 0x1f) + 1;
+        }
+        else if ((r & 0x3ff) == 0x0f || pairs == TL_WRITES / 2)
+        {
+            /* 15bitを超える待ち(768ms) */
+            *p++ = longdelay;
+            *p++ = 2;
+            f->total += 3 << 8;
+        }
+        else
+        {
+            i = (r >> 8) % code;
+            reg = (uint16_t)(codemap[i] | ((r & 0x10000) ? 0x100 : 0));
+            *p++ = (uint8_t)(i | ((r & 0x10000) ? 0x80 : 0));
+            *p++ = tl_randval(state, reg);
+            tl_addwrite(f, reg, p[-1]);
+        }
+        pairs++;
+    }
+    /* 終わりの待ち */
+    *p++ = shortdelay;
+    *p++ = 99;
+    f->total += 100;
+    pairs++;
+    tl_put32(&f->data[12], pairs);
+    tl_put32(&f->data[16], f->total);
+    f->size = (uint32_t)(p - f->data);
+}
+
+static void tl_buildimf(tl_file *f, uint32_t *state, uint32_t imfrate, int type1)
+{
+    uint8_t *p = type1 ? &f->data[2] : f->data;
+    uint32_t i, r, wait;
+    uint16_t reg;
+
+    f->numwrites = 0;
+    f->total = 0;
+    f->src_rate = imfrate;
+    if (!type1)
+    {
+        /* タイプ0の多くは先頭が0の書き込み */
+        memset(p, 0, 4);
+        p += 4;
+        tl_addwrite(f, 0x00, 0x00);
+    }
+    for (i = f->numwrites; i < TL_WRITES; i++)
+    {
+        r = tl_rand(state);
+        do
+        {
+            reg = tl_regs[(r >> 8) % tl_numregs];
+            r = tl_rand(state);
+        } while (reg == 0x04 || reg == 0x05);
+        /* 待ちはおよそ0-25ms、まれに1秒(15bitを超える) */
+        switch (r & 0x03)
+        {
+        case 0:
+            wait = 0;
+            break;
+        case 1:
+            wait = (r >> 8) % 4;
+            break;
+        case 2:
+            wait = (r >> 8) % (imfrate / 40);
+            break;
+        default:
+            wait = (r & 0xff00) == 0 ? imfrate : (r >> 8) % (imfrate / 100);
+            break;
+        }
+        p[0] = (uint8_t)reg;
+        p[1] = tl_randval(state, reg);
+        p[2] = (uint8_t)wait;
+        p[3] = (uint8_t)(wait >> 8);
+        tl_addwrite(f, reg, p[1]);
+        f->total += wait;
+        p += 4;
+    }
+    f->size = (uint32_t)(p - f->data);
+    if (type1)
+    {
+        f->data[0] = (uint8_t)(f->size - 2);
+        f->data[1] = (uint8_t)((f->size - 2) >> 8);
+        /* 後ろのタグ(読み飛ばされる) */
+        memcpy(p, "\x1atitle\0", 7);
+        f->size += 7;
+    }
+}
+
+/* 参照: 書き込みをソースの時刻どおりに与える */
+static uint32_t tl_reference(const tl_file *f, opl3_chip *chip, int16_t *out, uint32_t rate)
+{
+    uint64_t target, pos = 0;
+    uint32_t i, end;
+
+    for (i = 0; i < f->numwrites; i++)
+    {
+        target = (uint64_t)f->writes[i].time * rate / f->src_rate;
+        OPL3_GenerateStream(chip, out + pos * 2, (uint32_t)(target - pos));
+        pos = target;
+        OPL3_WriteReg(chip, f->writes[i].reg, f->writes[i].v);
+    }
+    end = (uint32_t)((uint64_t)f->total * rate / f->src_rate);
+    OPL3_GenerateStream(chip, out + pos * 2, (uint32_t)(end - pos));
+    return end;
+}
+
+static int tl_run(const tl_file *f, uint32_t *state, uint32_t rate, int dro, const char *name)
+{
+    static opl3_chip refchip, chip;
+    const uint32_t maxlen = (uint32_t)((uint64_t)f->total * rate / f->src_rate) + 16;
+    opl3_event *events = 0;
+    opl3_timeline tl;
+    int16_t *ref, *out;
+    uint32_t numevents = 0, reflen, len = 0, n, count, i, nops = 0;
+    uint8_t err;
+    int ok = 1;
+
+    err = dro ? OPL3_TimelineFromDro(f->data, f->size, rate, &events, &numevents)
+              : OPL3_TimelineFromImf(f->data, f->size, f->src_rate, rate, &events, &numevents);
+    if (err != OPL_TIMELINE_OK)
+    {
+        fprintf(stderr, "timeline: %s decode failed (%u)\n", name, err);
+        return 0;
+    }
+    /* 書き込み1つにつき1イベント、それ以外は長い待ちの分割と終端だけ */
+    for (i = 0; i < numevents; i++)
+    {
+        nops += events[i].reg == 0 && !(events[i].wait & OPL_EVENT_HIGH);
+    }
+    if (numevents - nops + 1 < f->numwrites || numevents > f->numwrites + nops)
+    {
+        fprintf(stderr, "timeline: %s has %lu events for %lu writes\n", name,
+                (unsigned long)numevents, (unsigned long)f->numwrites);
+        ok = 0;
+    }
+
+    OPL3_Reset(&refchip, rate);
+    OPL3_Reset(&chip, rate);
+    ref = (int16_t *)calloc(maxlen * 2, sizeof(int16_t));
+    out = (int16_t *)calloc(maxlen * 2, sizeof(int16_t));
+    if (!ref || !out)
+    {
+        fprintf(stderr, "timeline: out of memory\n");
+        ok = 0;
+    }
+    if (ok)
+    {
+        reflen = tl_reference(f, &refchip, ref, rate);
+        OPL3_TimelineStart(&tl, events, numevents);
+        do
+        {
+            count = 1 + tl_rand(state) % 5000;
+            if (count > maxlen - len)
+            {
+                count = maxlen - len;
+            }
+            n = OPL3_TimelineRender(&tl, &chip, out + len * 2, count);
+            len += n;
+        } while (n == count && count > 0);
+        if (len != reflen)
+        {
+            fprintf(stderr, "timeline: %s %lu samples rendered, expected %lu @%luHz\n", name,
+                    (unsigned long)len, (unsigned long)reflen, (unsigned long)rate);
+            ok = 0;
+        }
+        for (i = 0; i < len * 2 && ok; i++)
+        {
+            if (out[i] != ref[i])
+            {
+                fprintf(stderr, "timeline: %s differs at sample %lu: %d ref %d @%luHz\n",
+                        name, (unsigned long)(i / 2), out[i], ref[i], (unsigned long)rate);
+                ok = 0;
+            }
+        }
+    }
+    free(ref);
+    free(out);
+    OPL3_Release(&refchip);
+    OPL3_Release(&chip);
+    OPL3_TimelineFree(events);
+    return ok;
+}
+
+/* 壊れたファイルは読まないこと */
+static int tl_reject(tl_file *f, uint32_t *state)
+{
+    opl3_event *events;
+    uint32_t numevents;
+    int ok = 1;
+
+    tl_builddro(f, state);
+    f->data[8] = 1;
+    if (OPL3_TimelineFromDro(f->data, f->size, 44100, &events, &numevents) != OPL_TIMELINE_BADFILE)
+    {
+        fprintf(stderr, "timeline: accepted DRO v1\n");
+        ok = 0;
+    }
+    f->data[8] = 2;
+    f->data[0] = 'X';
+    if (OPL3_TimelineFromDro(f->data, f->size, 44100, &events, &numevents) != OPL_TIMELINE_BADFILE)
+    {
+        fprintf(stderr, "timeline: accepted a DRO without the signature\n");
+        ok = 0;
+    }
+    if (OPL3_TimelineFromImf(f->data, 3, OPL_IMF_RATE_KEEN, 44100, &events, &numevents)
+        != OPL_TIMELINE_BADFILE)
+    {
+        fprintf(stderr, "timeline: accepted a 3-byte IMF\n");
+        ok = 0;
+    }
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t rates[4] = { 49716, 44100, 48000, 22050 };
+    static const uint32_t imfrates[3] = { OPL_IMF_RATE_DUKE2, OPL_IMF_RATE_KEEN, OPL_IMF_RATE_WOLF };
+    static tl_file f;
+    char name[32];
+    uint32_t seed = 1, files = 6, state, n, runs = 0, failed = 0;
+    int arg, r;
+
+    for (arg = 1; arg + 1 < argc; arg += 2)
+    {
+        switch (argv[arg][1])
+        {
+        case 's':
+            seed = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        case 'n':
+            files = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: timeline [-s seed] [-n files]\n");
+            return 2;
+        }
+    }
+    state = seed ? seed : 1;
+    tl_initregs();
+
+    for (n = 0; n < files; n++)
+    {
+        for (r = 0; r < 4; r++)
+        {
+            tl_builddro(&f, &state);
+            sprintf(name, "dro#%lu", (unsigned long)n);
+            failed += !tl_run(&f, &state, rates[r], 1, name);
+            runs++;
+
+            tl_buildimf(&f, &state, imfrates[(n + r) % 3], (int)((n + r) & 1));
+            sprintf(name, "imf%d#%lu", (int)((n + r) & 1), (unsigned long)n);
+            failed += !tl_run(&f, &state, rates[r], 0, name);
+            runs++;
+        }
+    }
+    failed += !tl_reject(&f, &state);
+    runs++;
+
+    printf("timeline: %lu runs, %lu failed\n", (unsigned long)runs, (unsigned long)failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,452 @@
+/*
+ * Memory-mapped VGM player test
+ *
+ * 乱数でVGMファイルを組み立て(YMF262の書き込み、各種の待ち、他チップの
+ * コマンドとデータブロック、ループ、2チップ構成)、OPL3_VgmRenderの
+ * 出力を、同じ書き込みを時刻どおりにOPL3_WriteRegで与えて
+ * OPL3_GenerateStreamで生成した参照とサンプル単位で比較します。
+ * 呼び出しごとのサンプル数はばらばらにします。
+ *
+ * 使い方:
+ *   vgm [-s seed] [-n files]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "opl3_vgm.h"
+
+#define VGM_STEPS       400
+#define VGM_HEADER      0x100
+#define VGM_MAXDATA     (VGM_HEADER + VGM_STEPS * 80 + 16)
+
+typedef struct {
+    uint32_t time;
+    uint16_t reg;
+    uint8_t chip;
+    uint8_t v;
+} vgm_event;
+
+typedef struct {
+    uint8_t data[VGM_MAXDATA];
+    uint32_t size;
+    vgm_event events[VGM_STEPS];
+    uint32_t numevents;
+    uint32_t loopevent;     /* ループ先の最初のイベント */
+    uint32_t looptime;
+    uint32_t total;
+} vgm_file;
+
+static uint32_t vgm_rand(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static void vgm_put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void vgm_emit(vgm_file *f, const uint8_t *cmd, uint32_t len)
+{
+    memcpy(&f->data[f->size], cmd, len);
+    f->size += len;
+}
+
+/* test/golden.cと同じ分布のレジスタ書き込み(キーオンを多めに) */
+static void vgm_randreg(uint32_t *state, uint16_t *reg, uint8_t *v)
+{
+    static const uint8_t slotregs[5] = { 0x20, 0x40, 0x60, 0x80, 0xe0 };
+    uint32_t r = vgm_rand(state);
+    uint16_t high = (r & 0x10) ? 0x100 : 0x000;
+
+    *v = (uint8_t)(r >> 24);
+    switch (r & 0x07)
+    {
+    case 0: case 1: case 2:
+        *reg = high | (slotregs[(r >> 5) % 5] + (r >> 8) % 0x16);
+        break;
+    case 3: case 4:
+        *reg = high | (0xa0 + (r >> 5) % 9);
+        break;
+    case 5:
+        *reg = high | (0xb0 + (r >> 5) % 9);
+        *v |= 0x20;
+        break;
+    case 6:
+        *reg = high | (0xc0 + (r >> 5) % 9);
+        break;
+    default:
+        *reg = (r & 0x100) ? 0xbd : 0x105;
+        if (*reg == 0x105)
+        {
+            *v &= 0x01;
+        }
+        break;
+    }
+}
+
+static void vgm_build(vgm_file *f, uint32_t *state, int dual)
+{
+    uint8_t cmd[80];
+    uint32_t step, r, wait, len, i, loopofs = 0;
+    uint16_t reg;
+    uint8_t v, chip;
+
+    memset(f->data, 0, VGM_HEADER);
+    f->size = VGM_HEADER;
+    f->numevents = 0;
+    f->total = 0;
+    f->loopevent = 0;
+    f->looptime = 0;
+
+    for (step = 0; step < VGM_STEPS; step++)
+    {
+        if (step == VGM_STEPS / 3)
+        {
+            loopofs = f->size;
+            f->loopevent = f->numevents;
+            f->looptime = f->total;
+        }
+        r = vgm_rand(state);
+        switch (r % 10)
+        {
+        case 0: case 1: case 2: case 3:
+            /* 書き込み。1チップ構成の0xAE/0xAFは無視される */
+            vgm_randreg(state, &reg, &v);
+            chip = (r & 0x100) ? 1 : 0;
+            cmd[0] = (uint8_t)((chip ? 0xae : 0x5e) | (reg >> 8));
+            cmd[1] = (uint8_t)reg;
+            cmd[2] = v;
+            vgm_emit(f, cmd, 3);
+            if (chip == 0 || dual)
+            {
+                f->events[f->numevents].time = f->total;
+                f->events[f->numevents].chip = chip;
+                f->events[f->numevents].reg = reg;
+                f->events[f->numevents].v = v;
+                f->numevents++;
+            }
+            break;
+        case 4: case 5: case 6: case 7:
+            switch ((r >> 8) % 5)
+            {
+            case 0:
+                wait = (r >> 12) % 2000;
+                cmd[0] = 0x61;
+                cmd[1] = (uint8_t)wait;
+                cmd[2] = (uint8_t)(wait >> 8);
+                len = 3;
+                break;
+            case 1:
+                wait = 735;
+                cmd[0] = 0x62;
+                len = 1;
+                break;
+            case 2:
+                wait = 882;
+                cmd[0] = 0x63;
+                len = 1;
+                break;
+            case 3:
+                wait = ((r >> 12) & 0x0f) + 1;
+                cmd[0] = (uint8_t)(0x70 | (wait - 1));
+                len = 1;
+                break;
+            default:
+                wait = (r >> 12) & 0x0f;
+                cmd[0] = (uint8_t)(0x80 | wait);
+                len = 1;
+                break;
+            }
+            vgm_emit(f, cmd, len);
+            f->total += wait;
+            break;
+        default:
+            /* 他のチップのコマンドとデータブロック(読み飛ばされる) */
+            switch ((r >> 8) % 5)
+            {
+            case 0:
+                cmd[0] = 0x50;
+                len = 2;
+                break;
+            case 1:
+                cmd[0] = 0x52;
+                len = 3;
+                break;
+            case 2:
+                cmd[0] = 0xb0;
+                len = 3;
+                break;
+            case 3:
+                cmd[0] = 0xc1;
+                len = 4;
+                break;
+            default:
+                len = (r >> 12) % 64;
+                cmd[0] = 0x67;
+                cmd[1] = 0x66;
+                cmd[2] = 0x00;
+                vgm_put32(&cmd[3], len);
+                len += 7;
+                break;
+            }
+            for (i = cmd[0] == 0x67 ? 7 : 1; i < len; i++)
+            {
+                /* オペランドに0x66や0x5Eが入っても読み飛ばせること */
+                cmd[i] = (uint8_t)vgm_rand(state);
+            }
+            vgm_emit(f, cmd, len);
+            break;
+        }
+    }
+    cmd[0] = 0x66;
+    vgm_emit(f, cmd, 1);
+
+    memcpy(f->data, "Vgm ", 4);
+    vgm_put32(&f->data[0x04], f->size - 0x04);
+    vgm_put32(&f->data[0x08], 0x171);
+    vgm_put32(&f->data[0x18], f->total);
+    vgm_put32(&f->data[0x1c], loopofs - 0x1c);
+    vgm_put32(&f->data[0x20], f->total - f->looptime);
+    vgm_put32(&f->data[0x34], VGM_HEADER - 0x34);
+    vgm_put32(&f->data[0x5c], 14318180 | (dual ? 0x40000000 : 0));
+}
+
+static int vgm_writefile(const char *path, const uint8_t *data, uint32_t size)
+{
+    FILE *fp = fopen(path, "wb");
+    int ok;
+
+    if (!fp)
+    {
+        perror(path);
+        return 0;
+    }
+    ok = fwrite(data, 1, size, fp) == size;
+    return fclose(fp) == 0 && ok;
+}
+
+/* 参照: ループを展開した書き込みを時刻どおりに与える */
+static uint32_t vgm_reference(const vgm_file *f, opl3_chip *chips, int16_t **out,
+                              uint32_t rate, uint8_t flags, uint16_t loops)
+{
+    const uint32_t looplen = f->total - f->looptime;
+    const vgm_event *ev;
+    uint64_t time, target, pos = 0;
+    uint32_t rep, i, end;
+    uint8_t c;
+
+    for (rep = 0; rep <= loops; rep++)
+    {
+        for (i = rep ? f->loopevent : 0; i < f->numevents; i++)
+        {
+            ev = &f->events[i];
+            time = ev->time + (rep ? (uint64_t)f->total - f->looptime + (uint64_t)(rep - 1) * looplen : 0);
+            target = time * rate / OPL_VGM_RATE;
+            for (c = 0; c < 2; c++)
+            {
+                OPL3_GenerateStream(&chips[c], out[c] + pos * 2, (uint32_t)(target - pos));
+            }
+            pos = target;
+            if (flags & OPL_VGM_BUFFERED)
+            {
+                OPL3_WriteRegBuffered(&chips[ev->chip], ev->reg, ev->v);
+            }
+            else
+            {
+                OPL3_WriteReg(&chips[ev->chip], ev->reg, ev->v);
+            }
+        }
+    }
+    end = (uint32_t)(((uint64_t)f->total + (uint64_t)loops * looplen) * rate / OPL_VGM_RATE);
+    for (c = 0; c < 2; c++)
+    {
+        OPL3_GenerateStream(&chips[c], out[c] + pos * 2, (uint32_t)(end - pos));
+    }
+    return end;
+}
+
+static int vgm_run(const char *path, const vgm_file *f, uint32_t *state, uint32_t rate,
+                   uint8_t flags, uint16_t loops, int dual)
+{
+    static opl3_chip refchips[2], chips[2];
+    const uint32_t maxlen = (uint32_t)(((uint64_t)f->total * (loops + 1u)) * rate / OPL_VGM_RATE) + 16;
+    int16_t *ref[2], *out[2], *sndptr[2];
+    opl3_chip *chipptr[2] = { &chips[0], &chips[1] };
+    const opl3_vgminfo *info;
+    opl3_vgm *vgm;
+    uint32_t reflen, len = 0, n, count, i;
+    uint8_t c;
+    int ok = 1;
+
+    vgm = OPL3_VgmOpen(path, rate, flags);
+    if (!vgm)
+    {
+        fprintf(stderr, "vgm: cannot open %s\n", path);
+        return 0;
+    }
+    info = OPL3_VgmInfo(vgm);
+    if (info->numchips != (dual ? 2 : 1) || info->total_samples != f->total
+     || info->loop_samples != f->total - f->looptime)
+    {
+        fprintf(stderr, "vgm: header mismatch\n");
+        OPL3_VgmClose(vgm);
+        return 0;
+    }
+    OPL3_VgmSetLoops(vgm, loops);
+    for (c = 0; c < 2; c++)
+    {
+        OPL3_Reset(&refchips[c], rate);
+        OPL3_Reset(&chips[c], rate);
+        ref[c] = (int16_t *)calloc(maxlen * 2, sizeof(int16_t));
+        out[c] = (int16_t *)calloc(maxlen * 2, sizeof(int16_t));
+    }
+    if (!ref[0] || !ref[1] || !out[0] || !out[1])
+    {
+        fprintf(stderr, "vgm: out of memory\n");
+        ok = 0;
+    }
+    if (ok)
+    {
+        reflen = vgm_reference(f, refchips, ref, rate, flags, loops);
+        do
+        {
+            count = 1 + vgm_rand(state) % 5000;
+            if (count > maxlen - len)
+            {
+                count = maxlen - len;
+            }
+            for (c = 0; c < 2; c++)
+            {
+                sndptr[c] = out[c] + len * 2;
+            }
+            n = OPL3_VgmRender(vgm, chipptr, sndptr, count);
+            len += n;
+        } while (n == count && count > 0);
+        if (len != reflen)
+        {
+            fprintf(stderr, "vgm: %lu samples rendered, expected %lu"
+                    " (@%luHz flags %u loops %u dual %d)\n",
+                    (unsigned long)len, (unsigned long)reflen, (unsigned long)rate,
+                    flags, loops, dual);
+            ok = 0;
+        }
+        for (c = 0; c < (dual ? 2 : 1) && ok; c++)
+        {
+            for (i = 0; i < len * 2; i++)
+            {
+                if (out[c][i] != ref[c][i])
+                {
+                    fprintf(stderr, "vgm: chip %u differs at sample %lu: %d ref %d"
+                            " (@%luHz flags %u loops %u dual %d)\n",
+                            c, (unsigned long)(i / 2), out[c][i], ref[c][i],
+                            (unsigned long)rate, flags, loops, dual);
+                    ok = 0;
+                    break;
+                }
+            }
+        }
+    }
+    for (c = 0; c < 2; c++)
+    {
+        free(ref[c]);
+        free(out[c]);
+        OPL3_Release(&refchips[c]);
+        OPL3_Release(&chips[c]);
+    }
+    OPL3_VgmClose(vgm);
+    return ok;
+}
+
+/* VGMでないファイルとYMF262のないVGMは開けないこと */
+static int vgm_reject(const char *path, vgm_file *f)
+{
+    int ok = 1;
+
+    vgm_put32(&f->data[0x5c], 0);
+    if (!vgm_writefile(path, f->data, f->size) || OPL3_VgmOpen(path, 44100, 0))
+    {
+        fprintf(stderr, "vgm: opened a file without YMF262\n");
+        ok = 0;
+    }
+    memcpy(f->data, "Vgz ", 4);
+    if (!vgm_writefile(path, f->data, f->size) || OPL3_VgmOpen(path, 44100, 0))
+    {
+        fprintf(stderr, "vgm: opened a file without the VGM signature\n");
+        ok = 0;
+    }
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t rates[4] = { 44100, 48000, 22050, 49716 };
+    static const uint16_t loops[2] = { 0, 2 };
+    static vgm_file f;
+    char path[] = "/tmp/opl3vgmXXXXXX";
+    uint32_t seed = 1, files = 8, state, n, runs = 0, failed = 0;
+    int arg, fd, dual, r, l;
+    uint8_t flags;
+
+    for (arg = 1; arg + 1 < argc; arg += 2)
+    {
+        switch (argv[arg][1])
+        {
+        case 's':
+            seed = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        case 'n':
+            files = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: vgm [-s seed] [-n files]\n");
+            return 2;
+        }
+    }
+    fd = mkstemp(path);
+    if (fd < 0)
+    {
+        perror("mkstemp");
+        return 1;
+    }
+    close(fd);
+    state = seed ? seed : 1;
+
+    for (n = 0; n < files; n++)
+    {
+        dual = (int)(n & 1);
+        vgm_build(&f, &state, dual);
+        if (!vgm_writefile(path, f.data, f.size))
+        {
+            failed++;
+            break;
+        }
+        for (r = 0; r < 4; r++)
+        {
+            for (l = 0; l < 2; l++)
+            {
+                flags = (uint8_t)((n >> 1) & 1 ? OPL_VGM_BUFFERED : 0);
+                failed += !vgm_run(path, &f, &state, rates[r], flags, loops[l], dual);
+                runs++;
+            }
+        }
+    }
+    failed += !vgm_reject(path, &f);
+    runs++;
+    unlink(path);
+
+    printf("vgm: %lu runs, %lu failed\n", (unsigned long)runs, (unsigned long)failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Nuked OPL3 - z88dk port
+ *
+ * src/opl3_wavetab.h の生成
+ *
+ * src/opl3.c の記述子版(OPL_WAVETAB_LARGE=0)とリンクし、opl3_wavedesc と
+ * logsinrom から各波形・各位相の対数減衰量と符号を求めて、ヘッダーを
+ * 標準出力に書き出します。make wavetab で再生成、make test-wavetab で
+ * リポジトリのヘッダーと一致するかを確かめます。
+ */
+
+#include <stdio.h>
+#include "opl3.h"
+
+#if OPL_WAVETAB_LARGE || OPL3_PROFILE_OPL2
+#error "build with -DOPL_WAVETAB_LARGE=0 (full OPL3 profile)"
+#endif
+
+/* src/opl3.c の記述子のビット(同じ値) */
+#define OPL_WAVE_XOR        0x01
+#define OPL_WAVE_SHL        0x02
+#define OPL_WAVE_KIND       0x0c
+#define OPL_WAVE_LOGSIN     0x00
+#define OPL_WAVE_SILENT     0x04
+#define OPL_WAVE_ZERO       0x08
+#define OPL_WAVE_NEG        0x80
+
+extern OPL3_CONST uint16_t logsinrom[256];
+extern OPL3_CONST uint8_t opl3_wavedesc[OPL_NUM_WAVEFORMS * 8];
+
+/* 記述子版のOPL3_WaveCalcと同じ規則で、減衰量 | 符号(bit15)を求める */
+static uint16_t gen_entry(uint8_t wf, uint16_t phase)
+{
+    uint8_t desc = opl3_wavedesc[(wf << 3) | (phase >> 7)];
+    uint16_t out;
+    uint8_t index;
+
+    switch (desc & OPL_WAVE_KIND)
+    {
+    case OPL_WAVE_LOGSIN:
+        index = (uint8_t)phase;
+        if (desc & OPL_WAVE_XOR)
+        {
+            index = (uint8_t)~index;
+        }
+        if (desc & OPL_WAVE_SHL)
+        {
+            index = (uint8_t)(index << 1);
+        }
+        out = logsinrom[index];
+        break;
+    case OPL_WAVE_SILENT:
+        out = 0x1000;
+        break;
+    case OPL_WAVE_ZERO:
+        out = 0;
+        break;
+    default:
+        out = phase & 0x1ff;
+        if (desc & OPL_WAVE_XOR)
+        {
+            out ^= 0x1ff;
+        }
+        out <<= 3;
+        break;
+    }
+    if (desc & OPL_WAVE_NEG)
+    {
+        out |= 0x8000;
+    }
+    return out;
+}
+
+int main(void)
+{
+    uint16_t wf, phase;
+
+    printf("/*\n"
+           " * Nuked OPL3 - z88dk port\n"
+           " *\n"
+           " * ホスト向けの波形テーブル(8波形 x 1024位相、16KB)\n"
+           " * 各エントリは下位13bitが対数減衰量(logsinromの値、無音は0x1000)、\n"
+           " * bit15が符号反転フラグです。src/opl3.c の opl3_wavedesc と同じ規則で\n"
+           " * logsinromから生成しています。OPL3_PROFILE_OPL2では波形0-3だけ(8KB)です。\n"
+           " *\n"
+           " * tools/gen_wavetab.c の出力です(make wavetab)。直接編集しないでください。\n"
+           " */\n"
+           "\n"
+           "#ifndef OPL3_WAVETAB_H\n"
+           "#define OPL3_WAVETAB_H\n"
+           "\n"
+           "OPL3_CONST uint16_t opl3_wavetab[OPL_NUM_WAVEFORMS][1024] = {\n");
+    for (wf = 0; wf < 8; wf++)
+    {
+        if (wf == 4)
+        {
+            printf("#if !OPL3_PROFILE_OPL2\n");
+        }
+        printf("    { /* %u */\n", wf);
+        for (phase = 0; phase < 1024; phase++)
+        {
+            printf("%s0x%04x%s", phase % 8 ? " " : "        ", gen_entry((uint8_t)wf, phase),
+                   phase == 1023 ? "\n" : phase % 8 == 7 ? ",\n" : ",");
+        }
+        printf("    }%s\n", wf == 7 ? "" : ",");
+    }
+    printf("#endif\n"
+           "};\n"
+           "\n"
+           "#endif /* OPL3_WAVETAB_H */\n");
+    return 0;
+}